@@ -161,6 +161,153 @@ def _is_uptodate(pchname, incpath):
             return True     # no point in updating as it will fail
     return False
 
+def _run_makepch(pkgpath, pchname, incpath, extra_headers = []):
+    makepch = os.path.join(pkgpath, 'etc', 'dictpch', 'makepch.py')
+    pyexe = sys.executable
+    if getattr(sys, 'frozen', False) or not ('python' in pyexe.lower() or 'pypy' in pyexe.lower()):
+      # either frozen, or a high chance of being embedded; and the actual version
+      # of python used doesn't matter per se, as long as it is functional
+        pyexe = 'python'
+    return subprocess.call([pyexe, makepch, pchname, '-I'+incpath] + extra_headers)
+
+def _pch_identity(pchname):
+  # identifies a PCH file in the first line of its '.snippets' list; it is
+  # checked by clingwrapper.cxx as well, so keep the formats in sync
+    st = os.stat(pchname)
+    return 'pch %d %d' % (st.st_size, int(st.st_mtime))
+
+def _has_snippets(pchname):
+  # the snippets list only holds if the PCH was not rebuilt since it was written
+    try:
+        with open(pchname+'.snippets') as f:
+            return f.readline().strip() == _pch_identity(pchname)
+    except (IOError, OSError):
+        return False
+
+def _snippets_base(pchname):
+  # a PCH with cached code records the standard PCH it was built from, so that a
+  # child process that inherited it starts from the standard one, with its own code
+    try:
+        with open(pchname+'.base') as f:
+            return f.read().strip() or None
+    except (IOError, OSError):
+        return None
+
+def _compile_cache_scope():
+  # cached code is kept per application, so that one program never sees the
+  # declarations of another: the scope is named after the main script, and the
+  # stamp identifies its version, so that an edited script preloads nothing; with
+  # CPPYY_COMPILE_CACHE_APP=<name>[:<version>], the application chooses both
+    app = os.environ.get('CPPYY_COMPILE_CACHE_APP', '')
+    if app:
+        app, sep, stamp = app.partition(':')
+    else:
+        main = sys.argv[0] if sys.argv else ''
+        if not main or main in ('-', '-c', '-m') or not os.path.isfile(main):
+            return None, None           # interactive: nothing worth caching
+        app = os.path.abspath(main)
+        st = os.stat(app)
+        stamp = '%d.%d' % (st.st_size, int(st.st_mtime))
+    import hashlib
+    return hashlib.sha1(app.encode('utf-8')).hexdigest()[:16], stamp or '-'
+
+def _ensure_compile_cache(pkgpath, pchname, incpath):
+  # with CPPYY_COMPILE_CACHE=<directory>, the code of successful Cppyy::Compile()
+  # calls is stored in that directory, per application (see clingwrapper.cxx); fold
+  # the code that the last run of this version of the application asked for into a
+  # private copy of the PCH, so that it is not parsed again on startup
+    for var in ('CPPYY_COMPILE_CACHE_SCOPE', 'CPPYY_COMPILE_CACHE_STAMP'):
+        os.environ.pop(var, None)       # never record into the scope of a parent
+
+    cachedir = os.environ.get('CPPYY_COMPILE_CACHE', '')
+    if not cachedir or not os.path.isdir(cachedir) or \
+           os.path.exists(os.path.join(cachedir, 'disabled')) or not os.path.exists(pchname):
+        return
+
+    scope, stamp = _compile_cache_scope()
+    if not scope:
+        return
+    cachedir = os.path.join(cachedir, 'scope.'+scope)
+    if not os.path.isdir(cachedir):
+        os.makedirs(cachedir)
+    os.environ['CPPYY_COMPILE_CACHE_SCOPE'] = scope     # read by clingwrapper.cxx
+    os.environ['CPPYY_COMPILE_CACHE_STAMP'] = stamp
+
+    try:
+        maxsize = int(os.environ.get('CPPYY_COMPILE_CACHE_SIZE', '4'))*1024*1024
+    except ValueError:
+        maxsize = 4*1024*1024
+
+  # read the manifest (all stored snippets, oldest first) and the snippets asked for
+  # by the last run, in order; drop duplicates and missing files
+    manifest = os.path.join(cachedir, 'manifest')
+    stored, seen = [], set()
+    try:
+        with open(manifest) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) != 2 or fields[0] in seen:
+                    continue
+                if os.path.exists(os.path.join(cachedir, fields[0]+'.h')):
+                    seen.add(fields[0])
+                    stored.append((fields[0], int(fields[1])))
+        with open(os.path.join(cachedir, 'last')) as f:
+            last = f.read().split()
+    except (IOError, OSError, ValueError):
+        return
+    if last[:2] != ['app', stamp]:
+        last = []                       # another version of the application
+    last = [key for key in last[2:] if key in seen]
+
+  # keep within the size cap, dropping the oldest snippets not asked for last first
+    total, nstored = sum(sz for key, sz in stored), len(stored)
+    for evict_last in (False, True):
+        for entry in list(stored):
+            if total <= maxsize:
+                break
+            if evict_last or entry[0] not in last:
+                stored.remove(entry)
+                total -= entry[1]
+                os.remove(os.path.join(cachedir, entry[0]+'.h'))
+    if len(stored) != nstored:
+        with open(manifest+'.tmp', 'w') as f:
+            f.write(''.join('%s %d\n' % entry for entry in stored))
+        getattr(os, 'replace', os.rename)(manifest+'.tmp', manifest)
+    sizes = dict(stored)
+    entries = [(key, sizes[key]) for key in last if key in sizes]
+    if not entries:
+        return                          # nothing to preload
+
+  # the name of the PCH covers everything it depends on, so any change in the
+  # standard PCH, the compilation flags, the version or the snippets rebuilds it
+    from ._version import __version__
+    st = os.stat(pchname)
+    identity = '\n'.join([pchname, str(st.st_mtime), str(st.st_size),
+        os.environ.get('EXTRA_CLING_ARGS', ''), str(__version__)] + [key for key, sz in entries])
+    import hashlib
+    digest = hashlib.sha1(identity.encode('utf-8')).hexdigest()[:16]
+    cachedpch = os.path.join(cachedir, 'snippets.%s.pch' % digest)
+
+    if not _has_snippets(cachedpch):
+        print('(Re-)building pre-compiled headers with cached code; this may take a minute ...')
+        headers = [os.path.join(cachedir, key+'.h') for key, sz in entries]
+        if _run_makepch(pkgpath, cachedpch, incpath, headers) != 0:
+          # the stored code depends on something not in the PCH: stop caching
+            with open(os.path.join(os.path.dirname(cachedir), 'disabled'), 'w') as f:
+                f.write('failed to build %s; remove this file to re-enable the cache\n' % cachedpch)
+            warnings.warn('Cached code could not be precompiled; compile cache disabled.')
+            return
+        with open(cachedpch+'.base', 'w') as f:
+            f.write(pchname+'\n')
+        with open(cachedpch+'.snippets', 'w') as f:
+            f.write('\n'.join([_pch_identity(cachedpch)] + [key for key, sz in entries])+'\n')
+        for fn in os.listdir(cachedir):
+            if fn.startswith('snippets.') and not fn.startswith('snippets.%s.' % digest):
+                os.remove(os.path.join(cachedir, fn))
+
+  # only cling sees the PCH with the cached code, see _disable_pch()
+    os.putenv('CLING_STANDARD_PCH', cachedpch)
+
 def ensure_precompiled_header(pchdir = '', pchname = ''):
   # the precompiled header of standard and system headers is not part of the
   # distribution as there are too many varieties; create it now if needed
@@ -177,6 +324,10 @@ def ensure_precompiled_header(pchdir = '', pchname = ''):
                  _disable_pch()
                  os.chdir(olddir)
                  return                     # quiet
+             base = _snippets_base(pchname)
+             if base:                       # inherited PCH with cached code
+                 pchname = base
+                 os.environ['CLING_STANDARD_PCH'] = pchname
              pchdir = os.path.dirname(pchname)
          else:
              if not pchdir:
@@ -214,13 +365,7 @@ def ensure_precompiled_header(pchdir = '', pchname = ''):
                              eca_old1 = eca_old1.replace(' -march=native', '')
                          os.environ['EXTRA_CLING_ARGS'] = eca_old1 + ext_flags
                      print('(Re-)building pre-compiled headers (options:%s); this may take a minute ...' % os.environ.get('EXTRA_CLING_ARGS', ' none'))
-                     makepch = os.path.join(pkgpath, 'etc', 'dictpch', 'makepch.py')
-                     pyexe = sys.executable
-                     if getattr(sys, 'frozen', False) or not ('python' in pyexe.lower() or 'pypy' in pyexe.lower()):
-                       # either frozen, or a high chance of being embedded; and the actual version
-                       # of python used doesn't matter per se, as long as it is functional
-                         pyexe = 'python'
-                     if subprocess.call([pyexe, makepch, pchname1, '-I'+incpath]) != 0:
+                     if _run_makepch(pkgpath, pchname1, incpath) != 0:
                          _warn_no_pch('failed to build', pchname1)
                      if ext_flags:
                         os.environ['EXTRA_CLING_ARGS'] = eca_old
@@ -230,6 +375,12 @@ def ensure_precompiled_header(pchdir = '', pchname = ''):
                    # case is responsible for the PCH, so only warn if it doesn't exist
                       _warn_no_pch('%s not writable, set CLING_STANDARD_PCH' % pchdir, pchname1)
 
+         if len(specialize) == 1:
+             try:
+                 _ensure_compile_cache(pkgpath, pchname, incpath)
+             except Exception as e:    # the standard PCH is still fine
+                 warnings.warn('Compile cache not used (%s).' % str(e))
+
      except Exception as e:
          _warn_no_pch(str(e))
      finally:
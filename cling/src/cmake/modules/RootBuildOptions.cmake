@@ -86,6 +86,7 @@ ROOT_BUILD_OPTION(cxxmodules OFF "Enable support for C++ modules")
 ROOT_BUILD_OPTION(exceptions ON "Enable compiler exception handling")
 ROOT_BUILD_OPTION(gnuinstall OFF "Perform installation following the GNU guidelines")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++")
+ROOT_BUILD_OPTION(lockprofiler OFF "Record call sites, wait and hold times of gCoreMutex acquisitions (R__LOCK_PROFILING)")
 ROOT_BUILD_OPTION(rpath OFF "Link libraries with built-in RPATH (run-time search path)")
 ROOT_BUILD_OPTION(runtime_cxxmodules ON "Enable runtime support for C++ modules")
 ROOT_BUILD_OPTION(shadowpw OFF "Enable support for shadow passwords")
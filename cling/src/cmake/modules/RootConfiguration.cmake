@@ -243,6 +243,12 @@ else()
    set(has_found_attribute_noinline undef)
 endif()
 
+if(lockprofiler)
+   set(uselockprofiler define)
+else()
+   set(uselockprofiler undef)
+endif()
+
 #---root-config----------------------------------------------------------------------------------------------
 ROOT_GET_OPTIONS(features ENABLED)
 set(features "cxx${CMAKE_CXX_STANDARD} ${features}")
@@ -289,6 +289,7 @@ public:
    virtual   void     ReadCharStar(char* &s) = 0;
 
    virtual inline void ReadStdString(std::string &s) { ReadStdString(&s); }
+   virtual   void     ReadStdStrings(std::string *s, Int_t n, size_t stride = sizeof(std::string));
 
    virtual   void     WriteBool(Bool_t       b) = 0;
    virtual   void     WriteChar(Char_t       c) = 0;
@@ -309,6 +310,7 @@ public:
    virtual   void     WriteCharStar(char *s) = 0;
 
    virtual inline void WriteStdString(std::string &s) { WriteStdString(&s); }
+   virtual   void     WriteStdStrings(const std::string *s, Int_t n, size_t stride = sizeof(std::string));
 
    // Special basic ROOT objects and collections
    virtual   TProcessID *ReadProcessID(UShort_t pidf) = 0;
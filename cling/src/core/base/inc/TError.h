@@ -57,6 +57,9 @@ extern void DefaultErrorHandler(int level, Bool_t abort, const char *location,
 extern ErrorHandlerFunc_t SetErrorHandler(ErrorHandlerFunc_t newhandler);
 extern ErrorHandlerFunc_t GetErrorHandler();
 
+extern Int_t SetThreadErrorIgnoreLevel(Int_t level);
+extern Int_t GetThreadErrorIgnoreLevel();
+
 extern void Info(const char *location, const char *msgfmt, ...)
 #if defined(__GNUC__) && !defined(__CINT__)
 __attribute__((format(printf, 2, 3)))
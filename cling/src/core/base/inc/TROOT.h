@@ -58,6 +58,7 @@ R__EXTERN TVirtualMutex *gROOTMutex;
 
 namespace Internal {
    class TROOTAllocator;
+   class TCleanupRegistry;
 
    TROOT *GetROOT2();
 
@@ -107,6 +108,7 @@ protected:
    TCollection     *fClassGenerators;     //List of user defined class generators;
    AListOfEnums_t   fEnums;               //List of enum types
    TProcessUUID    *fUUIDs;               //Pointer to TProcessID managing TUUIDs
+   Internal::TCleanupRegistry *fCleanupRegistry; //!Holders to notify when a registered object is deleted
 
                   TROOT();                //Only used by Dictionary
    void           InitSystem();           //Operating System interface
@@ -160,12 +162,14 @@ public:
    TFunction        *GetGlobalFunction(const char *name, const char *params = 0, Bool_t load = kFALSE);
    TFunction        *GetGlobalFunctionWithPrototype(const char *name, const char *proto = 0, Bool_t load = kFALSE);
    TProcessUUID     *GetUUIDs() const { return fUUIDs; }
+   Bool_t            IsCleanupSkipped(const TObject *holder, const TObject *obj) const;
    Bool_t            IsFolder() const { return kTRUE; }
    Bool_t            IsRootFile(const char *filename) const;
    Int_t             LoadClass(const char *classname, const char *libname, Bool_t check = kFALSE);
    TClass           *LoadClass(const char *name, Bool_t silent = kFALSE) const;
    Bool_t            MustClean() const { return fMustClean; }
    void              RecursiveRemove(TObject *obj);
+   void              RegisterCleanup(TObject *obj, TObject *holder);
    static void       RegisterModule(const char* modulename,
                                     const char** headers,
                                     const char** includePaths,
@@ -175,6 +179,16 @@ public:
                                     const FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
                                     const char** classesHeaders,
                                     bool hasCxxModule = false);
+   static void       RegisterModule(const char* modulename,
+                                    const char** headers,
+                                    const char** includePaths,
+                                    const char* payLoadCode,
+                                    const char* fwdDeclCode,
+                                    void (*triggerFunc)(),
+                                    const FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
+                                    const char** classesHeaders,
+                                    bool hasCxxModule,
+                                    const char* fwdDeclTable);
    TObject          *Remove(TObject*);
    void              RemoveClass(TClass *);
    void              Reset(Option_t *option="");
@@ -183,6 +197,8 @@ public:
    void              SetLineIsProcessing() { fLineIsProcessing++; }
    void              SetLineHasBeenProcessed() { if (fLineIsProcessing) fLineIsProcessing--; }
    void              SetMustClean(Bool_t flag = kTRUE) { fMustClean=flag; }
+   void              UnregisterCleanup(TObject *obj, TObject *holder);
+   void              UnregisterCleanupHolder(TObject *holder);
 
    //---- static functions
    static void        Initialize();
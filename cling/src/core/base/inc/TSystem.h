@@ -379,6 +379,7 @@ public:
    virtual const char     *FindDynamicLibrary(TString& lib, Bool_t quiet = kFALSE);
    virtual Func_t          DynFindSymbol(const char *module, const char *entry);
    virtual int             Load(const char *module, const char *entry = "", Bool_t system = kFALSE);
+   virtual int             LoadMany(const char *modules, Bool_t system = kFALSE);
    virtual void            Unload(const char *module);
    virtual UInt_t          LoadAllLibraries();
    virtual void            ListSymbols(const char *module, const char *re = "");
@@ -0,0 +1,65 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TVirtualLockProfiler
+#define ROOT_TVirtualLockProfiler
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TVirtualLockProfiler                                                 //
+//                                                                      //
+// Interface of the lock contention profiler.  When ROOT is configured  //
+// with -Dlockprofiler=ON (R__LOCK_PROFILING), the R__LOCKGUARD,        //
+// R__READ_LOCKGUARD and R__WRITE_LOCKGUARD macros record the call      //
+// site, wait and hold time of each acquisition into gLockProfiler, if  //
+// set.  The implementation (TLockProfiler) lives in libThread.         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+#include "DllImport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+
+namespace CppyyLegacy {
+
+class TVirtualLockProfiler {
+
+public:
+   enum EMode {
+      kExclusive = 0,  // TVirtualMutex::Lock
+      kRead      = 1,  // TVirtualRWMutex::ReadLock
+      kWrite     = 2   // TVirtualRWMutex::WriteLock
+   };
+
+   virtual ~TVirtualLockProfiler() { }
+
+   // Record one acquisition; all times are in nanoseconds, 'start' is Now() before locking.
+   virtual void Record(const void *mutex, const char *file, Int_t line, EMode mode, size_t depth,
+                       ULong64_t start, ULong64_t wait, ULong64_t hold) = 0;
+
+   static ULong64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+};
+
+// Active profiler, set by TLockProfiler::Enable (null when profiling is off).
+// Atomic, as the lock guards of all threads read it while it may be switched.
+R__EXTERN std::atomic<TVirtualLockProfiler*> gLockProfiler;
+
+} // namespace CppyyLegacy
+
+#endif
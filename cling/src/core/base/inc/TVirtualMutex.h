@@ -26,6 +26,10 @@
 
 #include <memory>
 
+#ifdef R__LOCK_PROFILING
+#include "TVirtualLockProfiler.h"
+#endif
+
 
 namespace CppyyLegacy {
 
@@ -91,10 +95,50 @@ public:
    ClassDefNV(TLockGuard,0)  // Exception safe locking/unlocking of mutex
 };
 
+#ifdef R__LOCK_PROFILING
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TProfiledLockGuard                                                   //
+//                                                                      //
+// Same as TLockGuard, but also reports the call site, the time spent   //
+// waiting for the mutex and the time it was held to gLockProfiler.     //
+// Used by R__LOCKGUARD when built with R__LOCK_PROFILING.              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TProfiledLockGuard {
+
+private:
+   TVirtualMutex *fMutex;
+   const char    *fFile;     // Call site
+   Int_t          fLine;     // Call site
+   TVirtualLockProfiler::EMode fMode; // kWrite if fMutex is a read-write mutex
+   size_t         fDepth;    // Recursion depth once acquired
+   ULong64_t      fStart;    // Time at which the lock was requested (0 if not profiling)
+   ULong64_t      fAcquired; // Time at which the lock was obtained
+
+   TProfiledLockGuard(const TProfiledLockGuard&);             // not implemented
+   TProfiledLockGuard& operator=(const TProfiledLockGuard&);  // not implemented
+
+public:
+   TProfiledLockGuard(TVirtualMutex *mutex, const char *file, Int_t line);
+   Int_t UnLock();
+   ~TProfiledLockGuard() { UnLock(); }
+};
+
+#endif
+
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
+#ifdef R__LOCK_PROFILING
+#define R__LOCKGUARD(mutex) TProfiledLockGuard _R__UNIQUE_(R__guard)(mutex, __FILE__, __LINE__)
+#define R__LOCKGUARD_NAMED(name,mutex) TProfiledLockGuard _NAME2_(R__guard,name)(mutex, __FILE__, __LINE__)
+#else
 #define R__LOCKGUARD(mutex) TLockGuard _R__UNIQUE_(R__guard)(mutex)
+#define R__LOCKGUARD_NAMED(name,mutex) TLockGuard _NAME2_(R__guard,name)(mutex)
+#endif
 #define R__LOCKGUARD2(mutex)                             \
    if (gGlobalMutex && !mutex) {                         \
       gGlobalMutex->Lock();                              \
@@ -103,7 +147,6 @@ public:
       gGlobalMutex->UnLock();                            \
    }                                                     \
    R__LOCKGUARD(mutex)
-#define R__LOCKGUARD_NAMED(name,mutex) TLockGuard _NAME2_(R__guard,name)(mutex)
 #define R__LOCKGUARD_UNLOCK(name) _NAME2_(R__guard,name).UnLock()
 #else
 #define R__LOCKGUARD(mutex)  (void)(mutex); { }
@@ -66,6 +66,10 @@ public:
    Int_t UnLock() override { WriteUnLock(nullptr); return 1; }
    Int_t CleanUp() override { WriteUnLock(nullptr); return 1; }
 
+   /// Number of times the calling thread holds the lock (in read or write mode,
+   /// given the `hint` returned when taking it), or 0 if unknown.
+   virtual size_t GetRecurseDepth(Hint_t * /* hint */, Bool_t /* write */) { return 0; }
+
    virtual std::unique_ptr<State> GetStateBefore() = 0;
    virtual std::unique_ptr<StateDelta> Rewind(const State& earlierState) = 0;
    virtual void Apply(std::unique_ptr<StateDelta> &&delta) = 0;
@@ -129,17 +133,64 @@ public:
    ClassDefNV(TWriteLockGuard,0)  // Exception safe read locking/unlocking of mutex
 };
 
+#ifdef R__LOCK_PROFILING
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TProfiledRWLockGuard                                                 //
+//                                                                      //
+// Same as TReadLockGuard or TWriteLockGuard, but also reports the call //
+// site, wait and hold times and recursion depth to gLockProfiler.      //
+// Used by R__READ_LOCKGUARD and R__WRITE_LOCKGUARD when built with     //
+// R__LOCK_PROFILING.                                                   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TProfiledRWLockGuard {
+
+private:
+   TVirtualRWMutex *const   fMutex;
+   TVirtualRWMutex::Hint_t *fHint;
+   const char              *fFile;     // Call site
+   Int_t                    fLine;     // Call site
+   Bool_t                   fWrite;    // Write or read lock
+   size_t                   fDepth;    // Recursion depth once acquired
+   ULong64_t                fStart;    // Time at which the lock was requested (0 if not profiling)
+   ULong64_t                fAcquired; // Time at which the lock was obtained
+
+   TProfiledRWLockGuard(const TProfiledRWLockGuard&) = delete;
+   TProfiledRWLockGuard& operator=(const TProfiledRWLockGuard&) = delete;
+
+public:
+   TProfiledRWLockGuard(TVirtualRWMutex *mutex, Bool_t write, const char *file, Int_t line);
+   ~TProfiledRWLockGuard();
+};
+
+#endif
+
 } // namespace CppyyLegacy
 
 // Zero overhead macros in case not compiled with thread support
 #if defined (_REENTRANT) || defined (WIN32)
 
+#ifdef R__LOCK_PROFILING
+
+#define R__READ_LOCKGUARD(mutex) ::CppyyLegacy::TProfiledRWLockGuard _R__UNIQUE_(R__readguard)(mutex, kFALSE, __FILE__, __LINE__)
+#define R__READ_LOCKGUARD_NAMED(name,mutex) ::CppyyLegacy::TProfiledRWLockGuard _NAME2_(R__readguard,name)(mutex, kFALSE, __FILE__, __LINE__)
+
+#define R__WRITE_LOCKGUARD(mutex) ::CppyyLegacy::TProfiledRWLockGuard _R__UNIQUE_(R__readguard)(mutex, kTRUE, __FILE__, __LINE__)
+#define R__WRITE_LOCKGUARD_NAMED(name,mutex) ::CppyyLegacy::TProfiledRWLockGuard _NAME2_(R__readguard,name)(mutex, kTRUE, __FILE__, __LINE__)
+
+#else
+
 #define R__READ_LOCKGUARD(mutex) ::CppyyLegacy::TReadLockGuard _R__UNIQUE_(R__readguard)(mutex)
 #define R__READ_LOCKGUARD_NAMED(name,mutex) ::CppyyLegacy::TReadLockGuard _NAME2_(R__readguard,name)(mutex)
 
 #define R__WRITE_LOCKGUARD(mutex) ::CppyyLegacy::TWriteLockGuard _R__UNIQUE_(R__readguard)(mutex)
 #define R__WRITE_LOCKGUARD_NAMED(name,mutex) ::CppyyLegacy::TWriteLockGuard _NAME2_(R__readguard,name)(mutex)
 
+#endif
+
 #else
 
 #define R__READ_LOCKGUARD(mutex) (void)mutex
@@ -387,6 +387,28 @@ TVirtualArray *TBuffer::PopDataCache()
    return val;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read n std::string, the i-th one being at (char*)s + i*stride (i.e. the
+/// elements of a collection of std::string). Implementations may read the
+/// whole block at once; this one reads the strings one by one.
+
+void TBuffer::ReadStdStrings(std::string *s, Int_t n, size_t stride)
+{
+   for (Int_t i = 0; i < n; ++i)
+      ReadStdString((std::string*)((char*)s + i*stride));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write n std::string, the i-th one being at (char*)s + i*stride.
+/// Implementations may write the whole block at once; this one writes the
+/// strings one by one.
+
+void TBuffer::WriteStdStrings(const std::string *s, Int_t n, size_t stride)
+{
+   for (Int_t i = 0; i < n; ++i)
+      WriteStdString((const std::string*)((const char*)s + i*stride));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Byte-swap N primitive-elements in the buffer.
 /// Bulk API relies on this function.
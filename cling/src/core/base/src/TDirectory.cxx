@@ -104,6 +104,7 @@ TDirectory::~TDirectory()
       fList->Delete("slow");
       SafeDelete(fList);
    }
+   if (TROOT *root = Internal::gROOTLocal) root->UnregisterCleanupHolder(this);
 
    TDirectory::CleanTargets();
 
@@ -204,7 +205,8 @@ void TDirectory::Append(TObject *obj, Bool_t replace /* = kFALSE */)
    }
 
    fList->Add(obj);
-   obj->SetBit(kMustCleanup);
+   if (TROOT *root = Internal::gROOTLocal) root->RegisterCleanup(obj, this);
+   else obj->SetBit(kMustCleanup);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1017,10 +1019,15 @@ void TDirectory::pwd() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Recursively remove object from a Directory.
+///
+/// Nothing is done if TROOT::RecursiveRemove already called this for obj
+/// as one of its registered holders (see TROOT::RegisterCleanup).
 
 void TDirectory::RecursiveRemove(TObject *obj)
 {
-   fList->RecursiveRemove(obj);
+   TROOT *root = Internal::gROOTLocal;
+   if (root && root->IsCleanupSkipped(this, obj)) return;
+   if (fList) fList->RecursiveRemove(obj);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1031,6 +1038,7 @@ TObject *TDirectory::Remove(TObject* obj)
    TObject *p = 0;
    if (fList) {
       p = fList->Remove(obj);
+      if (p && Internal::gROOTLocal) Internal::gROOTLocal->UnregisterCleanup(p, this);
    }
    return p;
 }
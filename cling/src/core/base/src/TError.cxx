@@ -154,11 +154,45 @@ void DefaultErrorHandler(Int_t level, Bool_t abort_bool, const char *location, c
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Storage of the calling thread's ignore level.
+
+static Int_t &ThreadErrorIgnoreLevel()
+{
+   TTHREAD_TLS(Int_t) level(kUnset);
+   return level;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the ignore level of the calling thread: messages below it are dropped
+/// before reaching the error handler, whatever gErrorIgnoreLevel is. Unlike
+/// changing gErrorIgnoreLevel, this does not affect the other threads.
+/// Returns the previous level (kUnset if none).
+
+Int_t SetThreadErrorIgnoreLevel(Int_t level)
+{
+   Int_t &current = ThreadErrorIgnoreLevel();
+   Int_t old = current;
+   current = level;
+   return old;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ignore level of the calling thread (kUnset if none).
+
+Int_t GetThreadErrorIgnoreLevel()
+{
+   return ThreadErrorIgnoreLevel();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// General error handler function. It calls the user set error handler.
 
 void ErrorHandler(Int_t level, const char *location, const char *fmt, va_list ap)
 {
+   if (level < ThreadErrorIgnoreLevel())
+      return;
+
    TTHREAD_TLS(Int_t) buf_size(256);
    TTHREAD_TLS(char*) buf_storage(0);
 
@@ -102,6 +102,8 @@ TProcessID::~TProcessID()
       delete current;
    }
 
+   if (TROOT *root = Internal::gROOTLocal) root->UnregisterCleanupHolder(this);
+
    R__WRITE_LOCKGUARD(gCoreMutex);
    fgPIDs->Remove(this);
 }
@@ -374,7 +376,8 @@ Bool_t TProcessID::IsValid(TProcessID *pid)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// stores the object at the uid th slot in the table of objects
-/// The object uniqued is set as well as its kMustCleanup bit
+/// The object uniqued is set as well as its kMustCleanup bit, and this
+/// process id is registered as the holder to notify when it is deleted
 
 void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
 {
@@ -383,7 +386,8 @@ void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
    if (!fObjects) fObjects = new TObjArray(100);
    fObjects->AddAtAndExpand(obj,uid);
 
-   obj->SetBit(kMustCleanup);
+   if (TROOT *root = Internal::gROOTLocal) root->RegisterCleanup(obj, this);
+   else obj->SetBit(kMustCleanup);
    if ( (obj->GetUniqueID()&0xff000000)==0xff000000 ) {
       // We have more than 255 pids we need to store this
       // pointer in the table(pointer,pid) since there is no
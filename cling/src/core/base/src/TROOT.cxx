@@ -62,8 +62,14 @@ of a main program creating an interactive version is shown below:
 #include "RConfigOptions.h"
 #include "RVersion.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <stdlib.h>
 #ifdef WIN32
 #include <io.h>
@@ -233,11 +239,13 @@ namespace {
                          void (*triggerFunc)(),
                          const TROOT::FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
                          const char **classesHeaders,
-                         bool hasCxxModule):
+                         bool hasCxxModule,
+                         const char* fwdDeclTable):
                            fModuleName(moduleName),
                            fHeaders(headers),
                            fPayloadCode(payloadCode),
                            fFwdDeclCode(fwdDeclCode),
+                           fFwdDeclTable(fwdDeclTable),
                            fIncludePaths(includePaths),
                            fTriggerFunc(triggerFunc),
                            fClassesHeaders(classesHeaders),
@@ -248,6 +256,7 @@ namespace {
       const char** fHeaders; // 0-terminated array of header files
       const char* fPayloadCode; // Additional code to be given to cling at library load
       const char* fFwdDeclCode; // Additional code to let cling know about selected classes and functions
+      const char* fFwdDeclTable; // Compact table of the simple fwd decls, replayed without parsing (or null)
       const char** fIncludePaths; // 0-terminated array of header files
       void (*fTriggerFunc)(); // Pointer to the dict initialization used to find the library name
       const char** fClassesHeaders; // 0-terminated list of classes and related header files
@@ -379,6 +388,148 @@ namespace Internal {
       return nullptr;
    }
 
+   class TCleanupRegistry {
+      // Reverse index from the objects registered through
+      // TROOT::RegisterCleanup to the holders (directories, process ids,
+      // ...) that reference them, so that deleting such an object reaches
+      // its holders even when they are not reachable from the list of
+      // cleanups (e.g. a file not registered in gROOT).
+      // The index is protected by its own mutex, which is always taken
+      // after gCoreMutex and never held while calling out.
+
+      std::mutex                                     fMutex;
+      std::condition_variable                        fUnpinned;    // Signaled when a holder is unpinned
+      std::unordered_map<const TObject*, std::vector<TObject*>> fEntries; // Object -> holders
+      std::unordered_map<const TObject*, std::unordered_set<const TObject*>> fHeld; // Holder -> objects
+      std::unordered_map<const TObject*, Int_t>      fPinned;      // Holder -> notifications in flight
+
+      // Holders pinned by the current thread, innermost last.
+      static std::vector<const TObject*> &ThreadPins()
+      {
+         thread_local std::vector<const TObject*> pins;
+         return pins;
+      }
+
+      // Object being removed by the current thread and the holders that
+      // already handled its removal.
+      struct TNotifiedHolders {
+         const TObject               *fObj     = nullptr;
+         const std::vector<TObject*> *fHolders = nullptr;
+      };
+      static TNotifiedHolders &ThreadNotified()
+      {
+         thread_local TNotifiedHolders notified;
+         return notified;
+      }
+
+      void Detach(const TObject *obj, std::vector<TObject*> &holders, const TObject *holder)
+      {
+         auto iter = std::find(holders.begin(), holders.end(), holder);
+         if (iter == holders.end()) return;
+         *iter = holders.back();
+         holders.pop_back();
+         if (holders.empty()) fEntries.erase(obj);
+      }
+
+   public:
+      void Add(TObject *obj, TObject *holder)
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         std::vector<TObject*> &holders = fEntries[obj];
+         if (std::find(holders.begin(), holders.end(), holder) != holders.end()) return;
+         holders.push_back(holder);
+         fHeld[holder].insert(obj);
+      }
+
+      void Remove(const TObject *obj, const TObject *holder)
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         auto iter = fEntries.find(obj);
+         if (iter == fEntries.end()) return;
+         auto held = fHeld.find(holder);
+         if (held != fHeld.end()) {
+            held->second.erase(obj);
+            if (held->second.empty()) fHeld.erase(held);
+         }
+         Detach(obj, iter->second, holder);
+      }
+
+      // Forget holder, once no other thread is notifying it any more.
+      void RemoveHolder(const TObject *holder)
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         const auto &pins = ThreadPins();
+         Int_t own = std::count(pins.begin(), pins.end(), holder);
+         fUnpinned.wait(lock, [&] {
+            auto pinned = fPinned.find(holder);
+            return pinned == fPinned.end() || pinned->second <= own;
+         });
+         auto held = fHeld.find(holder);
+         if (held == fHeld.end()) return;
+         for (const TObject *obj : held->second) {
+            auto iter = fEntries.find(obj);
+            if (iter != fEntries.end()) Detach(obj, iter->second, holder);
+         }
+         fHeld.erase(held);
+      }
+
+      // Forget obj and move its holders into holders, pinned until Unpin
+      // so that they are not destroyed while being notified.
+      void Release(const TObject *obj, std::vector<TObject*> &holders)
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         auto iter = fEntries.find(obj);
+         if (iter == fEntries.end()) return;
+         holders.swap(iter->second);
+         fEntries.erase(iter);
+         for (const TObject *holder : holders) {
+            auto held = fHeld.find(holder);
+            if (held != fHeld.end()) {
+               held->second.erase(obj);
+               if (held->second.empty()) fHeld.erase(held);
+            }
+            ++fPinned[holder];
+            ThreadPins().push_back(holder);
+         }
+      }
+
+      void Unpin(const std::vector<TObject*> &holders)
+      {
+         if (holders.empty()) return;
+         std::lock_guard<std::mutex> lock(fMutex);
+         auto &pins = ThreadPins();
+         for (const TObject *holder : holders) {
+            auto pinned = fPinned.find(holder);
+            if (pinned != fPinned.end() && --pinned->second == 0) fPinned.erase(pinned);
+            auto pin = std::find(pins.rbegin(), pins.rend(), holder);
+            if (pin != pins.rend()) pins.erase(std::next(pin).base());
+         }
+         fUnpinned.notify_all();
+      }
+
+      // Return true if holder already handled the removal of obj in the
+      // current thread: its RecursiveRemove(obj) was called directly, and
+      // the walk through the list of cleanups does not need to repeat it.
+      static Bool_t AlreadyNotified(const TObject *holder, const TObject *obj)
+      {
+         const TNotifiedHolders &notified = ThreadNotified();
+         return notified.fObj == obj && notified.fHolders &&
+                std::find(notified.fHolders->begin(), notified.fHolders->end(), holder) != notified.fHolders->end();
+      }
+
+      // Marks holders as having handled the removal of obj, for the current
+      // thread and the lifetime of this object.
+      class TNotified {
+         TNotifiedHolders fPrevious;
+      public:
+         TNotified(const TObject *obj, const std::vector<TObject*> &holders) : fPrevious(ThreadNotified())
+         {
+            ThreadNotified() = {obj, &holders};
+         }
+         ~TNotified() { ThreadNotified() = fPrevious; }
+      };
+   };
+
 } // end of Internal sub namespace
 // back to CppyyLegacy namespace
 
@@ -433,7 +584,7 @@ TROOT::TROOT() : TDirectory(),
      fClosedObjects(0),fFiles(0),fFunctions(0),
      fCleanups(0),
      fMessageHandlers(0),fStreamerInfo(0),fClassGenerators(0),
-     fUUIDs(0)
+     fUUIDs(0), fCleanupRegistry(nullptr)
 {
 }
 
@@ -463,7 +614,7 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
      fClosedObjects(0),fFiles(0),fFunctions(0),
      fCleanups(0),
      fMessageHandlers(0),fStreamerInfo(0),fClassGenerators(0),
-     fUUIDs(0)
+     fUUIDs(0), fCleanupRegistry(nullptr)
 {
    if (fgRootInit || Internal::gROOTLocal) {
       //Warning("TROOT", "only one instance of TROOT allowed");
@@ -526,6 +677,7 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
    fFiles       = setNameLocked(new TList, "Files");
    fFunctions   = setNameLocked(new TList, "Functions");
    fCleanups    = setNameLocked(new THashList, "Cleanups");
+   fCleanupRegistry = new Internal::TCleanupRegistry;
    fMessageHandlers = setNameLocked(new TList, "MessageHandlers");
    fTypes       = new TListOfTypes; fTypes->UseRWLock();
 
@@ -1202,7 +1354,8 @@ void TROOT::InitInterpreter()
                                    li->fFwdNargsToKeepColl,
                                    li->fClassesHeaders,
                                    kTRUE /*lateRegistration*/,
-                                   li->fHasCxxModule);
+                                   li->fHasCxxModule,
+                                   li->fFwdDeclTable);
    }
    GetModuleHeaderInfoBuffer().clear();
 
@@ -1305,7 +1458,69 @@ void TROOT::RecursiveRemove(TObject *obj)
 {
    R__READ_LOCKGUARD(gCoreMutex);
 
-   fCleanups->RecursiveRemove(obj);
+   if (!fCleanupRegistry) {
+      fCleanups->RecursiveRemove(obj);
+      return;
+   }
+
+   // Objects registered through RegisterCleanup are removed from the
+   // holders that reference them first, as these may not be reachable from
+   // the list of cleanups. The whole list is walked afterwards, as obj may
+   // also be referenced indirectly (e.g. by a collection in a directory);
+   // only the holders just notified skip their (identical) second pass, see
+   // IsCleanupSkipped.
+   std::vector<TObject*> holders;
+   fCleanupRegistry->Release(obj, holders);
+   for (TObject *holder : holders)
+      holder->RecursiveRemove(obj);
+   {
+      Internal::TCleanupRegistry::TNotified notified(obj, holders);
+      fCleanups->RecursiveRemove(obj);
+   }
+   fCleanupRegistry->Unpin(holders);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record that holder references obj and set obj's kMustCleanup bit.
+///
+/// When obj is deleted, holder->RecursiveRemove(obj) is called for each of
+/// its registered holders, before the list of cleanups is walked as usual.
+/// The holder must call UnregisterCleanupHolder before it is deleted.
+
+void TROOT::RegisterCleanup(TObject *obj, TObject *holder)
+{
+   obj->SetBit(kMustCleanup);
+   // Our own list is walked by every RecursiveRemove anyway.
+   if (fCleanupRegistry && holder && holder != this) fCleanupRegistry->Add(obj, holder);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if holder, a holder of objects registered with RegisterCleanup,
+/// already handled the removal of obj: RecursiveRemove(obj) called it directly
+/// in this thread and is now walking the list of cleanups.
+
+Bool_t TROOT::IsCleanupSkipped(const TObject *holder, const TObject *obj) const
+{
+   return Internal::TCleanupRegistry::AlreadyNotified(holder, obj);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget that holder references obj (for example after holder removed it).
+
+void TROOT::UnregisterCleanup(TObject *obj, TObject *holder)
+{
+   if (fCleanupRegistry) fCleanupRegistry->Remove(obj, holder);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget all the objects registered for holder.  Must be called by the
+/// holder before it is deleted.
+
+void TROOT::UnregisterCleanupHolder(TObject *holder)
+{
+   // Waits for the RecursiveRemove in flight in other threads that may
+   // still call holder.
+   if (fCleanupRegistry) fCleanupRegistry->RemoveHolder(holder);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1318,6 +1533,24 @@ static void CallCloseFiles()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the static initialization of dictionaries generated without a
+/// table of forward declarations; see the overload below.
+
+void TROOT::RegisterModule(const char* modulename,
+                           const char** headers,
+                           const char** includePaths,
+                           const char* payloadCode,
+                           const char* fwdDeclCode,
+                           void (*triggerFunc)(),
+                           const TInterpreter::FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
+                           const char** classesHeaders,
+                           bool hasCxxModule /*= false*/)
+{
+   RegisterModule(modulename, headers, includePaths, payloadCode, fwdDeclCode, triggerFunc,
+                  fwdDeclsArgToSkip, classesHeaders, hasCxxModule, nullptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called by static dictionary initialization to register clang modules
 /// for headers. Calls TCling::RegisterModule() unless gCling
@@ -1332,7 +1565,8 @@ void TROOT::RegisterModule(const char* modulename,
                            void (*triggerFunc)(),
                            const TInterpreter::FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
                            const char** classesHeaders,
-                           bool hasCxxModule)
+                           bool hasCxxModule,
+                           const char* fwdDeclTable)
 {
 
    // First a side track to insure proper end of process behavior.
@@ -1382,11 +1616,11 @@ void TROOT::RegisterModule(const char* modulename,
    // Now register with TCling.
    if (TROOT::Initialized()) {
       gCling->RegisterModule(modulename, headers, includePaths, payloadCode, fwdDeclCode, triggerFunc,
-                             fwdDeclsArgToSkip, classesHeaders, false, hasCxxModule);
+                             fwdDeclsArgToSkip, classesHeaders, false, hasCxxModule, fwdDeclTable);
    } else {
       GetModuleHeaderInfoBuffer().push_back(ModuleHeaderInfo_t(modulename, headers, includePaths, payloadCode,
                                                                fwdDeclCode, triggerFunc, fwdDeclsArgToSkip,
-                                                               classesHeaders, hasCxxModule));
+                                                               classesHeaders, hasCxxModule, fwdDeclTable));
    }
 }
 
@@ -34,6 +34,7 @@ of local objects so it is exception safe.
 
 #include "TVirtualMutex.h"
 #include "TVirtualRWMutex.h"
+#include "TVirtualLockProfiler.h"
 
 
 ClassImp(CppyyLegacy::TVirtualMutex);
@@ -51,4 +52,85 @@ TVirtualMutex *gGlobalMutex = 0;
 TVirtualRWMutex::State::~State() = default;
 TVirtualRWMutex::StateDelta::~StateDelta() = default;
 
+// Lock contention profiler, see TLockProfiler.  Only consulted by the
+// lock guards when built with R__LOCK_PROFILING.
+std::atomic<TVirtualLockProfiler*> gLockProfiler{nullptr};
+
+#ifdef R__LOCK_PROFILING
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take the lock, timing the wait if a profiler is active.
+
+TProfiledLockGuard::TProfiledLockGuard(TVirtualMutex *mutex, const char *file, Int_t line)
+   : fMutex(mutex), fFile(file), fLine(line), fMode(TVirtualLockProfiler::kExclusive), fDepth(0),
+     fStart(0), fAcquired(0)
+{
+   if (!fMutex) return;
+   if (!gLockProfiler.load(std::memory_order_relaxed)) {
+      fMutex->Lock();
+      return;
+   }
+   fStart = TVirtualLockProfiler::Now();
+   fMutex->Lock();
+   fAcquired = TVirtualLockProfiler::Now();
+   // gInterpreterMutex and gROOTMutex are in practice gCoreMutex.
+   if (auto rwmutex = dynamic_cast<TVirtualRWMutex*>(fMutex)) {
+      fMode = TVirtualLockProfiler::kWrite;
+      fDepth = rwmutex->GetRecurseDepth(nullptr, kTRUE);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the lock (once) and report the acquisition.
+
+Int_t TProfiledLockGuard::UnLock()
+{
+   if (!fMutex) return 0;
+   auto tmp = fMutex;
+   fMutex = 0;
+   Int_t res = tmp->UnLock();
+   TVirtualLockProfiler *profiler = fStart ? gLockProfiler.load(std::memory_order_acquire) : nullptr;
+   if (profiler) {
+      ULong64_t now = TVirtualLockProfiler::Now();
+      profiler->Record(tmp, fFile, fLine, fMode, fDepth, fStart, fAcquired - fStart, now - fAcquired);
+   }
+   return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take the read or write lock, timing the wait if a profiler is active.
+
+TProfiledRWLockGuard::TProfiledRWLockGuard(TVirtualRWMutex *mutex, Bool_t write, const char *file, Int_t line)
+   : fMutex(mutex), fHint(nullptr), fFile(file), fLine(line), fWrite(write), fDepth(0), fStart(0), fAcquired(0)
+{
+   if (!fMutex) return;
+   if (gLockProfiler.load(std::memory_order_relaxed)) fStart = TVirtualLockProfiler::Now();
+   fHint = fWrite ? fMutex->WriteLock() : fMutex->ReadLock();
+   if (fStart) {
+      fAcquired = TVirtualLockProfiler::Now();
+      fDepth = fMutex->GetRecurseDepth(fHint, fWrite);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the lock and report the acquisition.
+
+TProfiledRWLockGuard::~TProfiledRWLockGuard()
+{
+   if (!fMutex) return;
+   if (fWrite)
+      fMutex->WriteUnLock(fHint);
+   else
+      fMutex->ReadUnLock(fHint);
+   TVirtualLockProfiler *profiler = fStart ? gLockProfiler.load(std::memory_order_acquire) : nullptr;
+   if (profiler) {
+      ULong64_t now = TVirtualLockProfiler::Now();
+      profiler->Record(fMutex, fFile, fLine,
+                       fWrite ? TVirtualLockProfiler::kWrite : TVirtualLockProfiler::kRead,
+                       fDepth, fStart, fAcquired - fStart, now - fAcquired);
+   }
+}
+
+#endif
+
 } // namespace CppyyLegacy
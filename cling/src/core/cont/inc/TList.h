@@ -24,8 +24,10 @@
 #include "TSeqCollection.h"
 #include "TString.h"
 
+#include <atomic>
+#include <cstddef>
 #include <iterator>
-#include <memory>
+#include <utility>
 
 #if (__GNUC__ >= 3) && !defined(__INTEL_COMPILER)
 // Prevent -Weffc++ from complaining about the inheritance
@@ -33,6 +35,13 @@
 #pragma GCC system_header
 #endif
 
+// #define R__CHECK_TLIST_LINKS
+
+// When R__CHECK_TLIST_LINKS is turned on (defined), TObjLinks carry a
+// magic word and are never freed: a link whose last reference goes away
+// is poisoned and kept, so that any later use of it, through a TListIter
+// or one of the TList functions taking a TObjLink*, is reported.
+
 
 namespace CppyyLegacy {
 
@@ -40,6 +49,7 @@ const Bool_t kSortAscending  = kTRUE;
 const Bool_t kSortDescending = !kSortAscending;
 
 class TObjLink;
+class TObjLinkPtr;
 class TListIter;
 
 
@@ -48,27 +58,27 @@ class TList : public TSeqCollection {
 friend  class TListIter;
 
 protected:
-   using TObjLinkPtr_t = std::shared_ptr<TObjLink>;
-   using TObjLinkWeakPtr_t = std::weak_ptr<TObjLink>;
+   using TObjLinkPtr_t = TObjLinkPtr;
 
-   TObjLinkPtr_t     fFirst;     //! pointer to first entry in linked list
-   TObjLinkPtr_t     fLast;      //! pointer to last entry in linked list
-   TObjLinkWeakPtr_t fCache;     //! cache to speedup sequential calling of Before() and After() functions
+   TObjLink         *fFirst;     //! pointer to first entry in linked list
+   TObjLink         *fLast;      //! pointer to last entry in linked list
+   TObjLink         *fCache;     //! cache to speedup sequential calling of Before() and After() functions
    Bool_t     fAscending; //! sorting order (when calling Sort()
 
    TObjLink          *LinkAt(Int_t idx) const;
    TObjLink          *FindLink(const TObject *obj, Int_t &idx) const;
 
-   TObjLinkPtr_t *DoSort(TObjLinkPtr_t *head, Int_t n);
+   TObjLink     **DoSort(TObjLink **head, Int_t n);
 
-   Bool_t         LnkCompare(const TObjLinkPtr_t &l1, const TObjLinkPtr_t &l2);
-   TObjLinkPtr_t  NewLink(TObject *obj, const TObjLinkPtr_t &prev = nullptr);
-   TObjLinkPtr_t  NewOptLink(TObject *obj, Option_t *opt,  const TObjLinkPtr_t &prev = nullptr);
-   TObjLinkPtr_t  NewLink(TObject *obj, TObjLink *prev);
-   TObjLinkPtr_t  NewOptLink(TObject *obj, Option_t *opt,  TObjLink *prev);
+   Bool_t         LnkCompare(TObjLink *l1, TObjLink *l2);
+   TObjLink      *NewLink(TObject *obj, TObjLink *prev = nullptr);
+   TObjLink      *NewOptLink(TObject *obj, Option_t *opt, TObjLink *prev = nullptr);
+   void           ReleaseLink(TObjLink *lnk);
+   void           Unlink(TObjLink *lnk);
+   TObjLink      *UnlinkFirst();
    // virtual void       DeleteLink(TObjLink *lnk);
 
-   void InsertAfter(const TObjLinkPtr_t &newlink, const TObjLinkPtr_t &prev);
+   void InsertAfter(TObjLink *newlink, TObjLink *prev);
 
 private:
    TList(const TList&);             // not implemented
@@ -77,8 +87,8 @@ private:
 public:
    typedef TListIter Iterator_t;
 
-   TList() : fAscending(kTRUE) { }
-   TList(TObject *) : fAscending(kTRUE) { } // for backward compatibility, don't use
+   TList() : fFirst(nullptr), fLast(nullptr), fCache(nullptr), fAscending(kTRUE) { }
+   TList(TObject *) : fFirst(nullptr), fLast(nullptr), fCache(nullptr), fAscending(kTRUE) { } // for backward compatibility, don't use
    virtual           ~TList();
    virtual void      Clear(Option_t *option="");
    virtual void      Delete(Option_t *option="");
@@ -99,7 +109,7 @@ public:
    virtual void      AddBefore(TObjLink *before, TObject *obj);
    virtual TObject  *Remove(TObject *obj);
    virtual TObject  *Remove(TObjLink *lnk);
-           TObject  *Remove(const TObjLinkPtr_t &lnk) { return Remove(lnk.get()); }
+           TObject  *Remove(const TObjLinkPtr &lnk);
    virtual void      RemoveLast();
    virtual void      RecursiveRemove(TObject *obj);
 
@@ -107,10 +117,10 @@ public:
    virtual TObject  *After(const TObject *obj) const;
    virtual TObject  *Before(const TObject *obj) const;
    virtual TObject  *First() const;
-   virtual TObjLink *FirstLink() const { return fFirst.get(); }
+   virtual TObjLink *FirstLink() const { return fFirst; }
    virtual TObject **GetObjectRef(const TObject *obj) const;
    virtual TObject  *Last() const;
-   virtual TObjLink *LastLink() const { return fLast.get(); }
+   virtual TObjLink *LastLink() const { return fLast; }
 
    virtual void      Sort(Bool_t order = kSortAscending);
    Bool_t            IsAscending() { return fAscending; }
@@ -125,17 +135,25 @@ public:
 //                                                                      //
 // Wrapper around a TObject so it can be stored in a TList.             //
 //                                                                      //
+// The links are chained with plain pointers and owned by their list,   //
+// which holds one reference. A cursor (TListIter, or a list walk that  //
+// calls out of the list) takes another one through a TObjLinkPtr, so   //
+// that the link, and its view of the chain, outlives its removal from  //
+// the list for as long as the cursor is on it.                         //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
-class TObjLink : public std::enable_shared_from_this<TObjLink> {
+class TObjLink {
 
 friend class TList;
 
 private:
-   using TObjLinkPtr_t = std::shared_ptr<TObjLink>;
-   using TObjLinkWeakPtr_t = std::weak_ptr<TObjLink>;
-
-   TObjLinkPtr_t     fNext;
-   TObjLinkWeakPtr_t fPrev;
+   TObjLink            *fNext;
+   TObjLink            *fPrev;
+   std::atomic<UInt_t>  fRefs;      // 1 for the list, 1 per cursor on the link
+   Bool_t               fDetached;  // removed while referenced: holds a reference to fNext and fPrev
+#ifdef R__CHECK_TLIST_LINKS
+   UInt_t               fMagic;
+#endif
 
    TObject    *fObject; // should be atomic ...
 
@@ -143,21 +161,40 @@ private:
    TObjLink& operator=(const TObjLink&) = delete;
    TObjLink() = delete;
 
-public:
+   void Destroy();
 
-   TObjLink(TObject *obj) : fObject(obj) { }
+protected:
    virtual ~TObjLink() { }
 
+public:
+#ifdef R__CHECK_TLIST_LINKS
+   enum { kAliveMagic = 0x4c6e6b41, kDeadMagic = 0x4c6e6b44 };
+#endif
+
+   TObjLink(TObject *obj) : fNext(nullptr), fPrev(nullptr), fRefs(1), fDetached(kFALSE),
+#ifdef R__CHECK_TLIST_LINKS
+                            fMagic(kAliveMagic),
+#endif
+                            fObject(obj) { }
+
    TObject                *GetObject() const { return fObject; }
    TObject               **GetObjectRef() { return &fObject; }
    void                    SetObject(TObject *obj) { fObject = obj; }
    virtual Option_t       *GetAddOption() const { return ""; }
    virtual Option_t       *GetOption() const { return fObject->GetOption(); }
    virtual void            SetOption(Option_t *) { }
-   TObjLink               *Next() { return fNext.get(); }
-   TObjLink               *Prev() { return fPrev.lock().get(); }
-   TObjLinkPtr_t           NextSP() { return fNext; }
-   TObjLinkPtr_t           PrevSP() { return fPrev.lock(); }
+   TObjLink               *Next() { return fNext; }
+   TObjLink               *Prev() { return fPrev; }
+   TObjLinkPtr             NextSP();
+   TObjLinkPtr             PrevSP();
+
+   void                    AddRef() { fRefs.fetch_add(1, std::memory_order_relaxed); }
+   void                    Release() { if (fRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) Destroy(); }
+#ifdef R__CHECK_TLIST_LINKS
+   Bool_t                  CheckAlive(const char *where) const;
+#else
+   Bool_t                  CheckAlive(const char *) const { return kTRUE; }
+#endif
 };
 
 
@@ -174,15 +211,58 @@ class TObjOptLink : public TObjLink {
 private:
    TString   fOption;
 
+protected:
+   ~TObjOptLink() { }
+
 public:
    TObjOptLink(TObject *obj, Option_t *opt) : TObjLink(obj), fOption(opt) { }
-   ~TObjOptLink() { }
    Option_t        *GetAddOption() const { return fOption.Data(); }
    Option_t        *GetOption() const { return fOption.Data(); }
    void             SetOption(Option_t *option) { fOption = option; }
 };
 
 
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TObjLinkPtr                                                          //
+//                                                                      //
+// Reference to a TObjLink that keeps it alive (see TObjLink), for the  //
+// cursors of TListIter and of the list walks that call out.            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+class TObjLinkPtr {
+
+private:
+   TObjLink *fLink;
+
+public:
+   TObjLinkPtr() : fLink(nullptr) { }
+   TObjLinkPtr(std::nullptr_t) : fLink(nullptr) { }
+   explicit TObjLinkPtr(TObjLink *lnk) : fLink(lnk) { if (fLink) fLink->AddRef(); }
+   TObjLinkPtr(const TObjLinkPtr &other) : fLink(other.fLink) { if (fLink) fLink->AddRef(); }
+   TObjLinkPtr(TObjLinkPtr &&other) : fLink(other.fLink) { other.fLink = nullptr; }
+   ~TObjLinkPtr() { if (fLink) fLink->Release(); }
+
+   TObjLinkPtr &operator=(const TObjLinkPtr &other) { TObjLinkPtr tmp(other); std::swap(fLink, tmp.fLink); return *this; }
+   TObjLinkPtr &operator=(TObjLinkPtr &&other) { std::swap(fLink, other.fLink); return *this; }
+
+   TObjLink *get() const { return fLink; }
+   TObjLink *operator->() const { return fLink; }
+   explicit operator bool() const { return fLink != nullptr; }
+   void      reset() { TObjLinkPtr tmp; std::swap(fLink, tmp.fLink); }
+
+   bool operator==(const TObjLinkPtr &other) const { return fLink == other.fLink; }
+   bool operator!=(const TObjLinkPtr &other) const { return fLink != other.fLink; }
+   bool operator==(const TObjLink *lnk) const { return fLink == lnk; }
+   bool operator!=(const TObjLink *lnk) const { return fLink != lnk; }
+};
+
+inline TObjLinkPtr TObjLink::NextSP() { return TObjLinkPtr(fNext); }
+inline TObjLinkPtr TObjLink::PrevSP() { return TObjLinkPtr(fPrev); }
+
+inline TObject *TList::Remove(const TObjLinkPtr &lnk) { return Remove(lnk.get()); }
+
+
 // Preventing warnings with -Weffc++ in GCC since it is a false positive for the TListIter destructor.
 #if (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__) >= 40600
 #pragma GCC diagnostic push
@@ -202,15 +282,15 @@ class TListIter : public TIterator,
                                        const TObject**, const TObject*&> {
 
 protected:
-   using TObjLinkPtr_t = std::shared_ptr<TObjLink>;
+   using TObjLinkPtr_t = TObjLinkPtr;
 
    const TList   *fList;         //list being iterated
-   TObjLinkPtr_t  fCurCursor;    //current position in list
-   TObjLinkPtr_t  fCursor;       //next position in list
+   TObjLinkPtr_t  fCurCursor;    //!current position in list
+   TObjLinkPtr_t  fCursor;       //!next position in list
    Bool_t         fDirection;    //iteration direction
    Bool_t         fStarted;      //iteration started
 
-   TListIter() : fList(0), fCurCursor(0), fCursor(0), fDirection(kIterForward),
+   TListIter() : fList(0), fCurCursor(), fCursor(), fDirection(kIterForward),
                  fStarted(kFALSE) { }
 
 public:
@@ -232,21 +312,6 @@ public:
    ClassDef(TListIter,0)  //Linked list iterator
 };
 
-inline bool operator==(TObjOptLink *l, const std::shared_ptr<TObjLink> &r) {
-   return l == r.get();
-}
-
-inline bool operator==(const std::shared_ptr<TObjLink> &l, TObjOptLink *r) {
-    return r == l;
-}
-
-inline TList::TObjLinkPtr_t  TList::NewLink(TObject *obj, TObjLink *prev) {
-   return NewLink(obj, prev ? prev->shared_from_this() : nullptr);
-}
-inline TList::TObjLinkPtr_t  TList::NewOptLink(TObject *obj, Option_t *opt,  TObjLink *prev) {
-   return NewOptLink(obj, opt, prev ? prev->shared_from_this() : nullptr);
-}
-
 } // namespace CppyyLegacy
 
 #if (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__) >= 40600
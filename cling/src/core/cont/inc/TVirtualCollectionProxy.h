@@ -57,7 +57,8 @@ public:
       kIsAssociative = BIT(2),
       kIsEmulated    = BIT(3),
       kNeedDelete    = BIT(4),  // Flag to indicate that this collection that contains directly or indirectly (only via other collection) some pointers that will need explicit deletions.
-      kCustomAlloc   = BIT(5)   // The collection has a custom allocator.
+      kCustomAlloc   = BIT(5),  // The collection has a custom allocator.
+      kIsReentrant   = BIT(6)   // The proxy implements the caller-owned environment interface of TGenCollectionProxy.
    };
 
    class TPushPop {
@@ -217,8 +217,7 @@ void THashList::Delete(Option_t *option)
       TList::Delete(option);         // this deletes the objects
    } else {
       while (fFirst) {
-         auto tlk = fFirst;
-         fFirst = fFirst->NextSP();
+         auto tlk = UnlinkFirst();
          fSize--;
          // remove object from table
          fTable->Remove(tlk->GetObject());
@@ -233,11 +232,11 @@ void THashList::Delete(Option_t *option)
          else if (obj && obj->IsOnHeap())
             TCollection::GarbageCollect(obj);
 
-         // tlk reference count goes down 1.
+         ReleaseLink(tlk);
       }
-      fFirst.reset();
-      fLast.reset();
-      fCache.reset();
+      fFirst = nullptr;
+      fLast = nullptr;
+      fCache = nullptr;
       fSize  = 0;
 
       Changed();
@@ -323,7 +322,7 @@ void THashList::RecursiveRemove(TObject *obj)
          fTable->Remove(object);
    }
 
-   if (!fFirst.get())
+   if (!fFirst)
       return;
 
    // Scan again the list and invoke RecursiveRemove for all objects
@@ -331,18 +330,18 @@ void THashList::RecursiveRemove(TObject *obj)
    // marked as empty by another thread (Eventhough we hold the
    // read lock if one of the call to RecursiveRemove request
    // the write lock then the read lock will be suspended and
-   // another thread can modify the list; thanks to the shared_pointer
-   // forward-and-backward links, our view of the list is still intact
+   // another thread can modify the list; thanks to the references held
+   // on the current and next links, our view of the list is still intact
    // but might contains node will nullptr payload)
-   auto lnk  = fFirst;
-   decltype(lnk) next;
-   while (lnk.get()) {
+   TObjLinkPtr_t lnk(fFirst);
+   TObjLinkPtr_t next;
+   while (lnk) {
       next = lnk->NextSP();
       TObject *ob = lnk->GetObject();
       if (ob && ob->TestBit(kNotDeleted)) {
          ob->RecursiveRemove(obj);
       }
-      lnk = next;
+      lnk = std::move(next);
    }
 }
 
@@ -23,8 +23,10 @@ the object pointer also a previous and next pointer.
 #include "TClass.h"
 #include "TROOT.h"
 #include "TVirtualMutex.h"
+#include "TError.h"
 
 #include <string>
+#include <vector>
 namespace std {} using namespace std;
 
 
@@ -155,10 +157,10 @@ void TList::AddBefore(const TObject *before, TObject *obj)
          Error("AddBefore", "before not found, object not added");
          return;
       }
-      if (t == fFirst.get())
+      if (t == fFirst)
          TList::AddFirst(obj);
       else {
-         NewLink(obj, t->fPrev.lock());
+         NewLink(obj, t->fPrev);
          fSize++;
          Changed();
       }
@@ -179,10 +181,11 @@ void TList::AddBefore(TObjLink *before, TObject *obj)
    if (!before)
       TList::AddFirst(obj);
    else {
-      if (before == fFirst.get())
+      if (!before->CheckAlive("TList::AddBefore")) return;
+      if (before == fFirst)
          TList::AddFirst(obj);
       else {
-         NewLink(obj, before->fPrev.lock());
+         NewLink(obj, before->fPrev);
          fSize++;
          Changed();
       }
@@ -209,10 +212,10 @@ void TList::AddAfter(const TObject *after, TObject *obj)
          Error("AddAfter", "after not found, object not added");
          return;
       }
-      if (t == fLast.get())
+      if (t == fLast)
          TList::AddLast(obj);
       else {
-         NewLink(obj, t->shared_from_this());
+         NewLink(obj, t);
          fSize++;
          Changed();
       }
@@ -235,10 +238,11 @@ void TList::AddAfter(TObjLink *after, TObject *obj)
    if (!after)
       TList::AddLast(obj);
    else {
-      if (after == fLast.get())
+      if (!after->CheckAlive("TList::AddAfter")) return;
+      if (after == fLast)
          TList::AddLast(obj);
       else {
-         NewLink(obj, after->shared_from_this());
+         NewLink(obj, after);
          fSize++;
          Changed();
       }
@@ -259,10 +263,10 @@ void TList::AddAt(TObject *obj, Int_t idx)
    TObjLink *lnk = LinkAt(idx);
    if (!lnk)
       TList::AddLast(obj);
-   else if (lnk == fFirst.get())
+   else if (lnk == fFirst)
       TList::AddFirst(obj);
    else {
-      NewLink(obj, lnk->fPrev.lock());
+      NewLink(obj, lnk->fPrev);
       fSize++;
       Changed();
    }
@@ -280,9 +284,9 @@ TObject *TList::After(const TObject *obj) const
 
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
 
-   auto cached = fCache.lock();
-   if (cached.get() && cached->GetObject() && cached->GetObject()->IsEqual(obj)) {
-      t = cached.get();
+   TObjLink *cached = fCache;
+   if (cached && cached->GetObject() && cached->GetObject()->IsEqual(obj)) {
+      t = cached;
       ((TList*)this)->fCache = cached->fNext;  //cast const away, fCache should be mutable
    } else {
       Int_t idx;
@@ -320,9 +324,9 @@ TObject *TList::Before(const TObject *obj) const
 
    TObjLink *t;
 
-   auto cached = fCache.lock();
-   if (cached.get() && cached->GetObject() && cached->GetObject()->IsEqual(obj)) {
-      t = cached.get();
+   TObjLink *cached = fCache;
+   if (cached && cached->GetObject() && cached->GetObject()->IsEqual(obj)) {
+      t = cached;
       ((TList*)this)->fCache = cached->fPrev;  //cast const away, fCache should be mutable
    } else {
       Int_t idx;
@@ -368,14 +372,11 @@ void TList::Clear(Option_t *option)
    // we re-use fCache to inform RecursiveRemove of the node currently
    // being cleared/deleted.
    while (fFirst) {
-      auto tlk = fFirst;
-      fFirst = fFirst->fNext;
+      auto tlk = UnlinkFirst();
       fSize--;
 
 
       // Make node available to RecursiveRemove
-      tlk->fNext.reset();
-      tlk->fPrev.reset();
       fCache = tlk;
 
       // delete only heap objects marked OK to clear
@@ -392,11 +393,13 @@ void TList::Clear(Option_t *option)
             }
          }
       }
-      // delete tlk;
+      if (fCache == tlk)
+         fCache = nullptr;
+      ReleaseLink(tlk);
    }
-   fFirst.reset();
-   fLast.reset();
-   fCache.reset();
+   fFirst = nullptr;
+   fLast = nullptr;
+   fCache = nullptr;
    fSize = 0;
    Changed();
 }
@@ -429,13 +432,10 @@ void TList::Delete(Option_t *option)
       // we re-use fCache to inform RecursiveRemove of the node currently
       // being cleared/deleted.
       while (fFirst) {
-         auto tlk = fFirst;
-         fFirst = fFirst->fNext;
+         auto tlk = UnlinkFirst();
          fSize--;
 
          // Make node available to RecursiveRemove
-         tlk->fNext.reset();
-         tlk->fPrev.reset();
          fCache = tlk;
 
          // delete only heap objects
@@ -446,24 +446,31 @@ void TList::Delete(Option_t *option)
          else if (obj && obj->IsOnHeap())
             TCollection::GarbageCollect(obj);
 
-         // delete tlk;
+         if (fCache == tlk)
+            fCache = nullptr;
+         ReleaseLink(tlk);
       }
 
-      fFirst.reset();
-      fLast.reset();
-      fCache.reset();
+      fFirst = nullptr;
+      fLast = nullptr;
+      fCache = nullptr;
       fSize  = 0;
 
    } else {
 
       auto first = fFirst;    //pointer to first entry in linked list
-      fFirst.reset();
-      fLast.reset();
-      fCache.reset();
+      fFirst = nullptr;
+      fLast = nullptr;
+      fCache = nullptr;
       fSize  = 0;
       while (first) {
          auto tlk = first;
          first = first->fNext;
+         // Detach the link as UnlinkFirst does: its neighbours are (or
+         // are about to be) released, so a cursor still on it must not
+         // take a reference to them.
+         tlk->fNext = nullptr;
+         tlk->fPrev = nullptr;
          // delete only heap objects
          auto obj = tlk->GetObject();
          tlk->SetObject(nullptr);
@@ -473,8 +480,8 @@ void TList::Delete(Option_t *option)
          else if (obj && obj->IsOnHeap())
             TCollection::GarbageCollect(obj);
 
-         // The formerly first token, when tlk goes out of scope has no more references
-         // because of the fFirst.reset()
+         // The formerly first token is no longer reachable from the list.
+         ReleaseLink(tlk);
       }
    }
 
@@ -549,7 +556,7 @@ TObjLink *TList::FindLink(const TObject *obj, Int_t &idx) const
    if (!fFirst) return 0;
 
    TObject *object;
-   TObjLink *lnk = fFirst.get();
+   TObjLink *lnk = fFirst;
    idx = 0;
 
    while (lnk) {
@@ -620,7 +627,7 @@ TObjLink *TList::LinkAt(Int_t idx) const
    R__COLLECTION_READ_GUARD();
 
    Int_t    i = 0;
-   TObjLink *lnk = fFirst.get();
+   TObjLink *lnk = fFirst;
    while (i < idx && lnk) {
       i++;
       lnk = lnk->Next();
@@ -642,12 +649,12 @@ TIterator *TList::MakeIterator(Bool_t dir) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a new TObjLink.
 
-TList::TObjLinkPtr_t TList::NewLink(TObject *obj, const TObjLinkPtr_t &prev)
+TObjLink *TList::NewLink(TObject *obj, TObjLink *prev)
 {
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   auto newlink = std::make_shared<TObjLink>(obj);
+   auto newlink = new TObjLink(obj);
    if (prev) {
       InsertAfter(newlink, prev);
    }
@@ -657,18 +664,67 @@ TList::TObjLinkPtr_t TList::NewLink(TObject *obj, const TObjLinkPtr_t &prev)
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a new TObjOptLink (a TObjLink that also stores the option).
 
-TList::TObjLinkPtr_t TList::NewOptLink(TObject *obj, Option_t *opt, const TObjLinkPtr_t &prev)
+TObjLink *TList::NewOptLink(TObject *obj, Option_t *opt, TObjLink *prev)
 {
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   auto newlink = std::make_shared<TObjOptLink>(obj, opt);
+   auto newlink = new TObjOptLink(obj, opt);
    if (prev) {
       InsertAfter(newlink, prev);
    }
    return newlink;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take lnk out of the chain of the list, which must contain it. The link
+/// keeps its own fNext and fPrev, so that a cursor on it can carry on.
+
+void TList::Unlink(TObjLink *lnk)
+{
+   if (lnk->fPrev)
+      lnk->fPrev->fNext = lnk->fNext;
+   else
+      fFirst = lnk->fNext;
+   if (lnk->fNext)
+      lnk->fNext->fPrev = lnk->fPrev;
+   else
+      fLast = lnk->fPrev;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take the first link out of the chain (the list must not be empty) and
+/// return it, cut from its neighbours.
+
+TObjLink *TList::UnlinkFirst()
+{
+   TObjLink *lnk = fFirst;
+   fFirst = lnk->fNext;
+   if (fFirst)
+      fFirst->fPrev = nullptr;
+   else
+      fLast = nullptr;
+   lnk->fNext = nullptr;
+   lnk->fPrev = nullptr;
+   return lnk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop the reference of the list to lnk, once it is out of the chain.
+/// If a cursor is still on the link, the link takes a reference to its
+/// neighbours, so that the cursor can move on from it as it would have
+/// from a link still in the list.
+
+void TList::ReleaseLink(TObjLink *lnk)
+{
+   if (lnk->fRefs.load(std::memory_order_acquire) > 1) {
+      lnk->fDetached = kTRUE;
+      if (lnk->fNext) lnk->fNext->AddRef();
+      if (lnk->fPrev) lnk->fPrev->AddRef();
+   }
+   lnk->Release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove object from this collection and recursively remove the object
 /// from all other objects (and collections).
@@ -682,8 +738,8 @@ void TList::RecursiveRemove(TObject *obj)
    // When fCache is set and has no previous and next node, it represents
    // the node being cleared and/or deleted.
    {
-      auto cached = fCache.lock();
-      if (cached && cached->fNext.get() == nullptr && cached->fPrev.lock().get() == nullptr) {
+      TObjLink *cached = fCache;
+      if (cached && cached->fNext == nullptr && cached->fPrev == nullptr) {
          TObject *ob = cached->GetObject();
          if (ob && ob->TestBit(kNotDeleted)) {
             ob->RecursiveRemove(obj);
@@ -691,40 +747,28 @@ void TList::RecursiveRemove(TObject *obj)
       }
    }
 
-   if (!fFirst.get())
+   if (!fFirst)
       return;
 
-   auto lnk  = fFirst;
-   decltype(lnk) next;
-   while (lnk.get()) {
-      next = lnk->fNext;
+   // ob->RecursiveRemove() may change this list: hold on to the current and
+   // next links, which stay usable even if they are removed meanwhile.
+   TObjLinkPtr_t lnk(fFirst);
+   TObjLinkPtr_t next;
+   while (lnk) {
+      next = lnk->NextSP();
       TObject *ob = lnk->GetObject();
       if (ob && ob->TestBit(kNotDeleted)) {
          if (ob->IsEqual(obj)) {
             lnk->SetObject(nullptr);
-            if (lnk == fFirst) {
-               fFirst = next;
-               if (lnk == fLast)
-                  fLast = fFirst;
-               else
-                  fFirst->fPrev.reset();
-               // DeleteLink(lnk);
-            } else if (lnk == fLast) {
-               fLast = lnk->fPrev.lock();
-               fLast->fNext.reset();
-               // DeleteLink(lnk);
-            } else {
-               lnk->Prev()->fNext = next;
-               lnk->Next()->fPrev = lnk->fPrev;
-               // DeleteLink(lnk);
-            }
+            Unlink(lnk.get());
+            ReleaseLink(lnk.get());
             fSize--;
-            fCache.reset();
+            fCache = nullptr;
             Changed();
          } else
             ob->RecursiveRemove(obj);
       }
-      lnk = next;
+      lnk = std::move(next);
    }
 }
 
@@ -749,27 +793,10 @@ TObject *TList::Remove(TObject *obj)
 
    TObject *ob = lnk->GetObject();
    lnk->SetObject(nullptr);
-   if (lnk == fFirst.get()) {
-      fFirst = lnk->fNext;
-      // lnk is still alive as we have either fLast
-      // or the 'new' fFirst->fPrev pointing to it.
-      if (lnk == fLast.get()) {
-         fLast.reset();
-         fFirst.reset();
-      } else
-         fFirst->fPrev.reset();
-      //DeleteLink(lnk);
-   } else if (lnk == fLast.get()) {
-      fLast = lnk->fPrev.lock();
-      fLast->fNext.reset();
-      //DeleteLink(lnk);
-   } else {
-      lnk->Next()->fPrev = lnk->fPrev;
-      lnk->Prev()->fNext = lnk->fNext;
-      //DeleteLink(lnk);
-   }
+   Unlink(lnk);
+   ReleaseLink(lnk);
    fSize--;
-   fCache.reset();
+   fCache = nullptr;
    Changed();
 
    return ob;
@@ -787,29 +814,20 @@ TObject *TList::Remove(TObjLink *lnk)
 
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
 
+   if (!lnk->CheckAlive("TList::Remove")) return 0;
+#ifdef R__CHECK_TLIST_LINKS
+   if (lnk->fPrev ? lnk->fPrev->fNext != lnk : fFirst != lnk) {
+      Error("Remove", "the link %p is not in this list (list name = %s)", lnk, GetName());
+      return 0;
+   }
+#endif
+
    TObject *obj = lnk->GetObject();
    lnk->SetObject(nullptr);
-   if (lnk == fFirst.get()) {
-      fFirst = lnk->fNext;
-      // lnk is still alive as we have either fLast
-      // or the 'new' fFirst->fPrev pointing to it.
-      if (lnk == fLast.get()) {
-         fLast.reset();
-         fFirst.reset();
-      } else
-         fFirst->fPrev.reset();
-      // DeleteLink(lnk);
-   } else if (lnk == fLast.get()) {
-      fLast = lnk->fPrev.lock();
-      fLast->fNext.reset();
-      // DeleteLink(lnk);
-   } else {
-      lnk->Next()->fPrev = lnk->fPrev;
-      lnk->Prev()->fNext = lnk->fNext;
-      // DeleteLink(lnk);
-   }
+   Unlink(lnk);
+   ReleaseLink(lnk);
    fSize--;
-   fCache.reset();
+   fCache = nullptr;
    Changed();
 
    return obj;
@@ -823,21 +841,15 @@ void TList::RemoveLast()
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   TObjLink *lnk = fLast.get();
+   TObjLink *lnk = fLast;
    if (!lnk) return;
 
    lnk->SetObject(nullptr);
-   if (lnk == fFirst.get()) {
-      fFirst.reset();
-      fLast.reset();
-   } else {
-      fLast = lnk->fPrev.lock();
-      fLast->fNext.reset();
-   }
-   // DeleteLink(lnk);
+   Unlink(lnk);
+   ReleaseLink(lnk);
 
    fSize--;
-   fCache.reset();
+   fCache = nullptr;
    Changed();
 }
 
@@ -863,9 +875,9 @@ void TList::Sort(Bool_t order)
    DoSort(&fFirst, fSize);
 
    // correct back links
-   std::shared_ptr<TObjLink> ol, lnk = fFirst;
+   TObjLink *ol, *lnk = fFirst;
 
-   if (lnk.get()) lnk->fPrev.reset();
+   if (lnk) lnk->fPrev = nullptr;
    while ((ol = lnk)) {
       lnk = lnk->fNext;
       if (lnk)
@@ -881,7 +893,7 @@ void TList::Sort(Bool_t order)
 /// Depending on the flag IsAscending() the function returns
 /// true if the object in l1 <= l2 (ascending) or l2 <= l1 (descending).
 
-Bool_t TList::LnkCompare(const TObjLinkPtr_t &l1, const TObjLinkPtr_t &l2)
+Bool_t TList::LnkCompare(TObjLink *l1, TObjLink *l2)
 {
    Int_t cmp = l1->GetObject()->Compare(l2->GetObject());
 
@@ -893,12 +905,12 @@ Bool_t TList::LnkCompare(const TObjLinkPtr_t &l1, const TObjLinkPtr_t &l2)
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort linked list.
 
-std::shared_ptr<TObjLink> *TList::DoSort(std::shared_ptr<TObjLink> *head, Int_t n)
+TObjLink **TList::DoSort(TObjLink **head, Int_t n)
 {
    R__COLLECTION_WRITE_LOCKGUARD(gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   std::shared_ptr<TObjLink> p1, p2, *h2, *t2;
+   TObjLink *p1, *p2, **h2, **t2;
 
    switch (n) {
       case 0:
@@ -944,7 +956,7 @@ Wrapper around a TObject so it can be stored in a TList.
 ////////////////////////////////////////////////////////////////////////////////
 /// Insert a new link in the chain.
 
-void TList::InsertAfter(const TObjLinkPtr_t &newlink, const TObjLinkPtr_t &prev)
+void TList::InsertAfter(TObjLink *newlink, TObjLink *prev)
 {
    newlink->fNext = prev->fNext;
    newlink->fPrev = prev;
@@ -953,6 +965,56 @@ void TList::InsertAfter(const TObjLinkPtr_t &newlink, const TObjLinkPtr_t &prev)
       newlink->fNext->fPrev = newlink;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Called when the last reference to the link goes away. A link removed
+/// from its list while a cursor was on it also drops its references to its
+/// neighbours; since a single cursor may thus keep a whole chain of removed
+/// links alive, they are released in a loop rather than recursively.
+
+void TObjLink::Destroy()
+{
+   if (!fDetached) {
+#ifdef R__CHECK_TLIST_LINKS
+      fMagic = kDeadMagic;
+      fObject = nullptr;
+#else
+      delete this;
+#endif
+      return;
+   }
+
+   std::vector<TObjLink*> pending(1, this);
+   while (!pending.empty()) {
+      TObjLink *lnk = pending.back();
+      pending.pop_back();
+      TObjLink *neighbours[2] = { lnk->fDetached ? lnk->fNext : nullptr,
+                                  lnk->fDetached ? lnk->fPrev : nullptr };
+#ifdef R__CHECK_TLIST_LINKS
+      lnk->fMagic = kDeadMagic;
+      lnk->fObject = nullptr;
+#else
+      delete lnk;
+#endif
+      for (TObjLink *n : neighbours) {
+         if (n && n->fRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pending.push_back(n);
+      }
+   }
+}
+
+#ifdef R__CHECK_TLIST_LINKS
+////////////////////////////////////////////////////////////////////////////////
+/// Report (from where) the use of a link that was already deleted.
+
+Bool_t TObjLink::CheckAlive(const char *where) const
+{
+   if (fMagic == kAliveMagic)
+      return kTRUE;
+   ::CppyyLegacy::Error(where, "use of a TObjLink (%p) that was already deleted", this);
+   return kFALSE;
+}
+#endif
+
 } // namespace CppyyLegacy
 
 /** \class TListIter
@@ -968,7 +1030,7 @@ namespace CppyyLegacy {
 /// is kIterForward. To go backward use kIterBackward.
 
 TListIter::TListIter(const TList *l, Bool_t dir)
-        : fList(l), fCurCursor(0), fCursor(0), fDirection(dir), fStarted(kFALSE)
+        : fList(l), fCurCursor(), fCursor(), fDirection(dir), fStarted(kFALSE)
 {
    R__COLLECTION_ITER_GUARD(fList);
 }
@@ -1032,22 +1094,17 @@ TObject *TListIter::Next()
 
    R__COLLECTION_ITER_GUARD(fList);
 
-   if (fDirection == kIterForward) {
-      if (!fStarted) {
-         fCursor = fList->fFirst;
-         fStarted = kTRUE;
-      }
-      fCurCursor = fCursor;
-      if (fCursor) {
-         auto next = fCursor = fCursor->NextSP();
-      }
-   } else {
-      if (!fStarted) {
-         fCursor = fList->fLast;
-         fStarted = kTRUE;
-      }
-      fCurCursor = fCursor;
-      if (fCursor) fCursor = fCursor->PrevSP();
+   if (!fStarted) {
+      fCursor = TObjLinkPtr_t(fDirection == kIterForward ? fList->fFirst : fList->fLast);
+      fStarted = kTRUE;
+   }
+   // The current link takes over the reference of the cursor.
+   fCurCursor = std::move(fCursor);
+   if (fCurCursor && fCurCursor->CheckAlive("TListIter::Next"))
+      fCursor = fDirection == kIterForward ? fCurCursor->NextSP() : fCurCursor->PrevSP();
+   else {
+      fCurCursor.reset();
+      fCursor.reset();
    }
 
    if (fCurCursor) return fCurCursor->GetObject();
@@ -1167,7 +1224,7 @@ void TList::Streamer(TBuffer &b)
       nobjects = GetSize();
       b << nobjects;
 
-      TObjLink *lnk = fFirst.get();
+      TObjLink *lnk = fFirst;
       while (lnk) {
          obj = lnk->GetObject();
          b << obj;
@@ -105,6 +105,7 @@ namespace CppyyLegacy {
                                        const std::vector<std::string> &headerArray,
                                        const std::vector<std::string> &includePathArray,
                                        const std::string &fwdDeclStringRAW,
+                                       const std::string &fwdDeclTable,
                                        const std::string &fwdDeclnArgsToKeepString,
                                        const std::string &payloadCodeWrapped,
                                        const std::string &headersClassesMapString,
@@ -113,6 +114,8 @@ namespace CppyyLegacy {
 
       void ConvertToCppString(std::string &text) const;
 
+      std::string SplitFwdDeclTable(const std::string &fwdDecls, std::string &residual) const;
+
       std::ostream &WritePPIncludes(std::ostream &out) const;
 
       std::ostream &WritePPCode(std::ostream &out) const {
@@ -29,7 +29,9 @@
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/Support/Path.h"
 
+#include <cstring>
 #include <map>
+#include <sstream>
 
 #ifndef R__WIN32
 #include <unistd.h>
@@ -342,12 +344,173 @@ std::ostream &TModuleGenerator::WriteStringPairVec(const StringPairVec_t &vec,
 }
 
 
+// Start of the enum forward declarations TCling::RegisterModule looks for.
+static const char gEnumFwdDeclMarker[] = "enum  __attribute__((annotate(\"";
+
+////////////////////////////////////////////////////////////////////////////////
+/// Entry of the forward declaration table, see SplitFwdDeclTable().
+
+struct FwdDeclTableEntry_t {
+   char fKind = 0;                         // 'c' class, 's' struct, 'e' enum
+   std::vector<std::string> fScopes;       // Enclosing namespaces, outermost first
+   std::string fName;                      // Unqualified name
+   std::vector<std::string> fAnnotations;  // Content of the annotate attributes
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse one line of the forward declarations printed by cling, e.g.
+///    namespace A{class __attribute__((annotate("$clingAutoload$A.h")))  B;}
+/// Only classes and structs enclosed in plain namespaces, and the enum
+/// declarations that TCling::RegisterModule checks for existing decls
+/// (see gEnumFwdDeclMarker), are accepted; return false for anything else.
+
+static bool ParseFwdDeclLine(const std::string &line, FwdDeclTableEntry_t &entry)
+{
+   size_t pos = 0;
+   auto skipSpaces = [&]() {
+      while (pos < line.size() && isspace((unsigned char)line[pos])) ++pos;
+   };
+   auto consume = [&](const char *token) {
+      size_t len = strlen(token);
+      if (line.compare(pos, len, token) != 0) return false;
+      pos += len;
+      return true;
+   };
+   auto identifier = [&](std::string &id) {
+      size_t start = pos;
+      if (pos < line.size() && (isalpha((unsigned char)line[pos]) || line[pos] == '_'))
+         while (pos < line.size() && (isalnum((unsigned char)line[pos]) || line[pos] == '_')) ++pos;
+      id = line.substr(start, pos - start);
+      return !id.empty();
+   };
+
+   std::string id;
+   for (skipSpaces(); consume("namespace "); skipSpaces()) {
+      skipSpaces();
+      if (!identifier(id)) return false;
+      skipSpaces();
+      if (!consume("{")) return false;
+      entry.fScopes.push_back(id);
+   }
+
+   if (line.compare(pos, sizeof(gEnumFwdDeclMarker) - 1, gEnumFwdDeclMarker) == 0)
+      entry.fKind = 'e';
+   else if (consume("class "))
+      entry.fKind = 'c';
+   else if (consume("struct "))
+      entry.fKind = 's';
+   else
+      return false;
+   if (entry.fKind == 'e') consume("enum ");
+
+   for (skipSpaces();; skipSpaces()) {
+      size_t end;
+      if (consume("__attribute__((annotate(\"")) {
+         end = line.find("\")))", pos);
+         if (end == std::string::npos || line.find('\\', pos) < end) return false;
+         entry.fAnnotations.push_back(line.substr(pos, end - pos));
+         pos = end + 4;
+      } else if (consume("__attribute__((annotate(R\"ATTRDUMP(")) {
+         end = line.find(")ATTRDUMP\")))", pos);
+         if (end == std::string::npos) return false;
+         entry.fAnnotations.push_back(line.substr(pos, end - pos));
+         pos = end + 13;
+      } else {
+         break;
+      }
+   }
+   if (!identifier(entry.fName)) return false;
+   // The enum line is kept as is, only its name needs to be known.
+   if (entry.fKind == 'e') return true;
+
+   skipSpaces();
+   if (!consume(";")) return false;
+   for (size_t i = 0; i < entry.fScopes.size(); ++i) {
+      skipSpaces();
+      if (!consume("}")) return false;
+   }
+   skipSpaces();
+   return pos == line.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return str as the content of a C string literal.
+
+static std::string EscapeForStringLiteral(const std::string &str)
+{
+   std::string escaped;
+   for (char c : str) {
+      switch (c) {
+         case '\\': escaped += "\\\\"; break;
+         case '"':  escaped += "\\\""; break;
+         case '\n': escaped += "\\n"; break;
+         case '?':  escaped += "\\?"; break; // no trigraphs
+         default:   escaped += c;
+      }
+   }
+   return escaped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the simple forward declarations of fwdDecls into a compact table
+/// that TCling::RegisterModule can replay without invoking the parser, and
+/// put the remaining declarations in residual. Return the table as a C
+/// string literal, or "nullptr" if no declaration could be moved.
+///
+/// The table is a sequence of NUL-terminated fields; each entry is
+///    kind ("c", "s" or "e"), its namespaces, "", its name,
+///    its annotations, "" and, for enums only, the declaration line.
+/// An empty kind (the terminating NUL of the literal) ends the table.
+
+std::string TModuleGenerator::SplitFwdDeclTable(const std::string &fwdDecls, std::string &residual) const
+{
+   residual = fwdDecls;
+#ifdef R__WIN32
+   // MSVC limits the total length of a concatenated string literal.
+   return "nullptr";
+#else
+   if (fIsInPCH || "nullptr" == fwdDecls || "\"\"" == fwdDecls)
+      return "nullptr";
+
+   std::string table, rest, line;
+   std::istringstream in(fwdDecls);
+   while (std::getline(in, line)) {
+      FwdDeclTableEntry_t entry;
+      if (!ParseFwdDeclLine(line, entry)) {
+         // RegisterModule does not look for enum decls in the text if there
+         // is a table: keep everything as text if we cannot handle one.
+         if (line.find(gEnumFwdDeclMarker) != std::string::npos)
+            return "nullptr";
+         rest += line + "\n";
+         continue;
+      }
+      table += "\n      \"";
+      table += entry.fKind;
+      table += "\\0\"";
+      for (auto const &scope : entry.fScopes)
+         table += " \"" + scope + "\\0\"";
+      table += " \"\\0\" \"" + entry.fName + "\\0\"";
+      for (auto const &annotation : entry.fAnnotations)
+         table += " \"" + EscapeForStringLiteral(annotation) + "\\0\"";
+      table += " \"\\0\"";
+      if (entry.fKind == 'e')
+         table += " \"" + EscapeForStringLiteral(line + "\n") + "\\0\"";
+   }
+   if (table.empty())
+      return "nullptr";
+
+   residual = rest.empty() ? "\"\"" : rest;
+   return table;
+#endif
+}
+
 void TModuleGenerator::WriteRegistrationSourceImpl(std::ostream& out,
                                                    const std::string &dictName,
                                                    const std::string &demangledDictName,
                                                    const std::vector<std::string> &headerArray,
                                                    const std::vector<std::string> &includePathArray,
                                                    const std::string &fwdDeclStringRAW,
+                                                   const std::string &fwdDeclTable,
                                                    const std::string &fwdDeclnArgsToKeepString,
                                                    const std::string &payloadCodeWrapped,
                                                    const std::string &headersClassesMapString,
@@ -364,6 +527,7 @@ void TModuleGenerator::WriteRegistrationSourceImpl(std::ostream& out,
        << "    };\n";
 
    out << "    static const char* fwdDeclCode = " << fwdDeclStringRAW << ";\n"
+       << "    static const char* fwdDeclTable = " << fwdDeclTable << ";\n"
        << "    static const char* payloadCode = " << payloadCodeWrapped << ";\n";
    // classesHeaders may depen on payloadCode
    out << "    static const char* classesHeaders[] = {\n"
@@ -376,7 +540,7 @@ void TModuleGenerator::WriteRegistrationSourceImpl(std::ostream& out,
           "        TriggerDictionaryInitialization_" << dictName << "_Impl, "
                      << fwdDeclnArgsToKeepString << ", classesHeaders, "
                      << (hasCxxModule ? "/*hasCxxModule*/true" : "/*hasCxxModule*/false")
-                     << ");\n"
+                     << ", fwdDeclTable);\n"
           "      isInitialized = true;\n"
           "    }\n"
           "  }\n"
@@ -400,13 +564,14 @@ void TModuleGenerator::WriteRegistrationSource(std::ostream &out, const std::str
    if (hasCxxModule) {
       std::string emptyStr = "\"\"";
       WriteRegistrationSourceImpl(out, GetDictionaryName(), GetDemangledDictionaryName(), {}, {},
-                                  fwdDeclString, "{}",
+                                  fwdDeclString, "nullptr", "{}",
                                   emptyStr, headersClassesMapString, "0",
                                   /*HasCxxModule*/ true);
       return;
    }
 
-   std::string fwdDeclStringSanitized = fwdDeclString;
+   std::string fwdDeclStringSanitized;
+   const std::string fwdDeclTable = SplitFwdDeclTable(fwdDeclString, fwdDeclStringSanitized);
 #ifdef R__WIN32
    // Visual sudio has a limitation of 2048 characters max in raw strings, so split
    // the potentially huge DICTFWDDCLS raw string into multiple smaller ones
@@ -523,6 +688,7 @@ void TModuleGenerator::WriteRegistrationSource(std::ostream &out, const std::str
                                headerArray,
                                includePathArray,
                                fwdDeclStringRAW,
+                               fwdDeclTable,
                                fwdDeclnArgsToKeepString,
                                payloadcodeWrapped,
                                headersClassesMapString,
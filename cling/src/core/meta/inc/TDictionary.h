@@ -84,6 +84,7 @@ enum EProperty {
    kIsVirtualBase   = 0x00200000,
    kIsConstPointer  = 0x00400000,
    kIsScopedEnum    = 0x00800000,
+   kIsBitfield      = 0x01000000,
    kIsConstexpr     = 0x02000000,
    kIsExplicit      = 0x04000000,
    kIsNamespace     = 0x08000000,
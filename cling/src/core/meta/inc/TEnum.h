@@ -24,7 +24,9 @@
 #include "TDictionary.h"
 #include "THashList.h"
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 
 namespace CppyyLegacy  {
@@ -40,6 +42,11 @@ private:
    ClassInfo_t *fInfo;          //!interpreter information, owned by TEnum
    TClass      *fClass;         //!owning class
    std::string  fQualName;      // fully qualified type name
+   mutable std::vector<const TEnumConstant*> fConstantsByPos;   //! constants in declaration order
+   mutable std::vector<const TEnumConstant*> fConstantsByValue; //! same, stably sorted by value
+   mutable std::atomic<Int_t> fConstantsIndexed{-1};            //! number of constants in the arrays above, -1 before the first build
+
+   void                  BuildConstantIndex() const;
 
    enum EBits {
      kBitIsScopedEnum = BIT(14) ///< The enum is an enum class.
@@ -61,6 +68,9 @@ public:
    TClass               *GetClass() const { return fClass; }
    const TSeqCollection *GetConstants() const { return &fConstantList; }
    const TEnumConstant  *GetConstant(const char *name) const { return (TEnumConstant *)fConstantList.FindObject(name); }
+   const TEnumConstant  *GetConstantAt(Int_t idx) const;
+   const TEnumConstant  *GetConstantWithValue(Long64_t value) const;
+   const std::vector<const TEnumConstant*> &GetConstantArray() const;
    DeclId_t              GetDeclId() const;
    EDataType             GetUnderlyingType() const;
    Bool_t                IsValid();
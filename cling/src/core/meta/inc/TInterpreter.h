@@ -45,15 +45,24 @@ class TListOfEnums;
 R__EXTERN TVirtualMutex *gInterpreterMutex;
 
 #if defined (_REENTRANT) || defined (WIN32)
-# define R__LOCKGUARD_CLING(mutex)  ::CppyyLegacy::Internal::InterpreterMutexRegistrationRAII _R__UNIQUE_(R__guard)(mutex); { }
+# ifdef R__LOCK_PROFILING
+#  define R__LOCKGUARD_CLING(mutex)  ::CppyyLegacy::Internal::InterpreterMutexRegistrationRAII _R__UNIQUE_(R__guard)(mutex, __FILE__, __LINE__); { }
+# else
+#  define R__LOCKGUARD_CLING(mutex)  ::CppyyLegacy::Internal::InterpreterMutexRegistrationRAII _R__UNIQUE_(R__guard)(mutex); { }
+# endif
 #else
 # define R__LOCKGUARD_CLING(mutex)  (void)(mutex); { }
 #endif
 
 namespace Internal {
 struct InterpreterMutexRegistrationRAII {
+#ifdef R__LOCK_PROFILING
+   TProfiledLockGuard fLockGuard;
+   InterpreterMutexRegistrationRAII(TVirtualMutex* mutex, const char *file, Int_t line);
+#else
    TLockGuard fLockGuard;
    InterpreterMutexRegistrationRAII(TVirtualMutex* mutex);
+#endif
    ~InterpreterMutexRegistrationRAII();
 };
 } // namespace Internal
@@ -92,13 +101,13 @@ public:
       typedef void (*Dtor_t)(void*, unsigned long, int);
 
       CallFuncIFacePtr_t():
-         fKind(kUninitialized), fGeneric(0), fDirect(0) {}
+         fKind(kUninitialized), fGeneric(0), fDirect(0), fTarget(0) {}
       CallFuncIFacePtr_t(Generic_t func, bool as_iface) :
-         fKind(kGeneric), fGeneric(as_iface ? func : 0), fDirect(as_iface ? 0 : func) {}
+         fKind(kGeneric), fGeneric(as_iface ? func : 0), fDirect(as_iface ? 0 : func), fTarget(0) {}
       CallFuncIFacePtr_t(Ctor_t func):
-         fKind(kCtor), fCtor(func), fDirect(0) {}
+         fKind(kCtor), fCtor(func), fDirect(0), fTarget(0) {}
       CallFuncIFacePtr_t(Dtor_t func):
-         fKind(kDtor), fDtor(func), fDirect(0) {}
+         fKind(kDtor), fDtor(func), fDirect(0), fTarget(0) {}
 
       EKind fKind;
       union {
@@ -107,6 +116,28 @@ public:
          Dtor_t fDtor;
       };
       Generic_t fDirect;
+      // If set, the generic wrapper is shared by all functions of the same
+      // signature and must be passed fTarget (the function) instead of the object.
+      void *fTarget;
+   };
+
+   // Value of a default argument that could be folded to a constant.
+   struct DefaultArgValue_t {
+      enum EKind {
+         kNone,        // the argument has no default
+         kRuntime,     // the default must be evaluated at run time (use the text)
+         kInteger,     // fInt (integral types, bool, enumerators)
+         kUnsigned,    // fUInt
+         kFloat,       // fFloat
+         kNullPointer, // nullptr, NULL, 0 for a pointer argument
+         kString       // fString (string literal, or a std::string built from one)
+      };
+
+      EKind       fKind  = kNone;
+      Long64_t    fInt   = 0;
+      ULong64_t   fUInt  = 0;
+      Double_t    fFloat = 0.;
+      std::string fString;
    };
 
    class SuspendAutoParsing {
@@ -188,7 +219,8 @@ public:
                                    const FwdDeclArgsToKeepCollection_t& fwdDeclArgsToKeep,
                                    const char** classesHeaders,
                                    Bool_t lateRegistration = false,
-                                   Bool_t hasCxxModule = false) = 0;
+                                   Bool_t hasCxxModule = false,
+                                   const char* fwdDeclTable = nullptr) = 0;
    virtual void     RegisterTClassUpdate(TClass *oldcl,DictFuncPtr_t dict) = 0;
    virtual void     UnRegisterTClassUpdate(const TClass *oldcl) = 0;
    virtual Int_t    SetClassSharedLibs(const char *cls, const char *libs) = 0;
@@ -239,6 +271,7 @@ public:
    // Misc
    virtual int    DisplayIncludePath(FILE * /* fout */) const {return 0;}
    virtual void  *FindSym(const char * /* entry */) const {return 0;}
+   virtual Bool_t GetJITSymbol(const void * /* addr */, const char *& /* name */, const void *& /* symaddr */) const {return kFALSE;}
    virtual void   GenericError(const char * /* error */) const {;}
    virtual Long_t GetExecByteCode() const {return 0;}
    virtual int    GetSecurityError() const{return 0;}
@@ -264,6 +297,10 @@ public:
    // core/meta helper functions.
    virtual EReturnType MethodCallReturnType(TFunction *func) const = 0;
    virtual ULong64_t GetInterpreterStateMarker() const = 0;
+   // Marker of the last change to the declarations of 'scope' (global scope if null);
+   // a list loaded when GetDeclStateMarker() was at least that value is up to date.
+   virtual ULong64_t GetScopeStateMarker(ClassInfo_t * /* scope */) const { return GetInterpreterStateMarker(); }
+   virtual ULong64_t GetDeclStateMarker() const { return GetInterpreterStateMarker(); }
    virtual bool DiagnoseIfInterpreterException(const std::exception &e) const = 0;
 
    typedef TDictionary::DeclId_t DeclId_t;
@@ -298,7 +335,7 @@ public:
    virtual MethodInfo_t *CallFunc_FactoryMethod(CallFunc_t* /* func */) const {return 0;}
    virtual void   CallFunc_Init(CallFunc_t* /* func */) const {;}
    virtual Bool_t CallFunc_IsValid(CallFunc_t* /* func */) const {return 0;}
-   virtual CallFuncIFacePtr_t CallFunc_IFacePtr(CallFunc_t* /* func */, bool /* as_iface */) const {return CallFuncIFacePtr_t();}
+   virtual CallFuncIFacePtr_t CallFunc_IFacePtr(CallFunc_t* /* func */, bool /* as_iface */, bool /* allow_shared */ = false) const {return CallFuncIFacePtr_t();}
 
    virtual void   CallFunc_SetFunc(CallFunc_t* /* func */, MethodInfo_t * /* info */) const {;}
 
@@ -421,6 +458,8 @@ public:
    virtual int    MethodArgInfo_Next(MethodArgInfo_t * /* marginfo */) const {return 0;}
    virtual Long_t MethodArgInfo_Property(MethodArgInfo_t * /* marginfo */) const {return 0;}
    virtual const char *MethodArgInfo_DefaultValue(MethodArgInfo_t * /* marginfo */) const {return 0;}
+   virtual DefaultArgValue_t MethodArgInfo_DefaultConstant(MethodArgInfo_t * /* marginfo */) const {
+      DefaultArgValue_t value; value.fKind = DefaultArgValue_t::kRuntime; return value; }
    virtual const char *MethodArgInfo_Name(MethodArgInfo_t * /* marginfo */) const {return 0;}
    virtual const char *MethodArgInfo_TypeName(MethodArgInfo_t * /* marginfo */) const {return 0;}
    virtual std::string MethodArgInfo_TypeNormalizedName(MethodArgInfo_t * /* marginfo */) const = 0;
@@ -475,8 +514,14 @@ namespace CppyyLegacy {
 typedef TInterpreter *CreateInterpreter_t(void* shlibHandle, const char* argv[]);
 typedef void *DestroyInterpreter_t(TInterpreter*);
 
+#ifdef R__LOCK_PROFILING
+inline CppyyLegacy::Internal::InterpreterMutexRegistrationRAII::InterpreterMutexRegistrationRAII(TVirtualMutex* mutex,
+                                                                                                 const char *file, Int_t line):
+   fLockGuard(mutex, file, line)
+#else
 inline CppyyLegacy::Internal::InterpreterMutexRegistrationRAII::InterpreterMutexRegistrationRAII(TVirtualMutex* mutex):
    fLockGuard(mutex)
+#endif
 {
    if (gCoreMutex)
       ::gCling->SnapshotMutexState(gCoreMutex);
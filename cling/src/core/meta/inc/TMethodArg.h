@@ -22,6 +22,7 @@
 
 #include "TDictionary.h"
 #include "TDataMember.h"
+#include "TInterpreter.h"
 
 
 namespace CppyyLegacy {
@@ -44,6 +45,7 @@ public:
    TMethodArg(MethodArgInfo_t *info = 0, TFunction *method = 0);
    virtual       ~TMethodArg();
    const char    *GetDefault() const;
+   TInterpreter::DefaultArgValue_t GetDefaultValue() const;
    TFunction     *GetMethod() const { return fMethod; }
    const char    *GetFullTypeName() const;
    std::string    GetTypeNormalizedName() const;
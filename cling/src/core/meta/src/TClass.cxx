@@ -2020,6 +2020,18 @@ ESTLType TClass::GetCollectionType() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the proxy describing the collection (if any).
+///
+/// With threads, each thread gets its own copy of the proxy.  The caller-owned
+/// environments of TGenCollectionProxy (see TCollectionProxyEnv) do not make
+/// a shared proxy safe yet, as the proxy still holds per-use state:
+///  - the pushed environment, used by TStreamerInfo::ReadBufferSTL and
+///    WriteBufferSTL (through TVirtualCollectionProxy::At), by the
+///    TClassStreamer overloads (Streamer(TBuffer&,void*,int), operator()) and
+///    by the slow iterators of GetFunctionCreateIterators;
+///  - the on-file class, set by SetOnFileClass before each read
+///    (TBufferFile::ReadFastArray, TEmulatedCollectionProxy::ReadBuffer);
+///  - the lazily built member-wise action sequences and iterator functions.
+/// The copy can only be dropped once all of these are owned by the caller.
 
 TVirtualCollectionProxy *TClass::GetCollectionProxy() const
 {
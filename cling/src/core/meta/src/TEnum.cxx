@@ -13,6 +13,7 @@
 The TEnum class implements the enum type.
 */
 
+#include <algorithm>
 #include <iostream>
 
 #include "TEnum.h"
@@ -76,6 +77,69 @@ void TEnum::AddConstant(TEnumConstant *constant)
    fConstantList.Add(constant);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// (Re)build the flat arrays of constants if constants were added since the
+/// last build.  Constants are only ever added (by AddConstant or by the
+/// streamer of fConstantList), so comparing the sizes is enough.  The
+/// arrays are published by the release store of fConstantsIndexed, so a
+/// reader that sees the count (acquire) also sees the filled arrays.
+
+void TEnum::BuildConstantIndex() const
+{
+   if (fConstantsIndexed.load(std::memory_order_acquire) == fConstantList.GetSize())
+      return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   if (fConstantsIndexed.load(std::memory_order_relaxed) == fConstantList.GetSize())
+      return;
+
+   fConstantsByPos.clear();
+   fConstantsByPos.reserve(fConstantList.GetSize());
+   for (TObject *obj : fConstantList)
+      fConstantsByPos.push_back((const TEnumConstant *)obj);
+
+   fConstantsByValue = fConstantsByPos;
+   std::stable_sort(fConstantsByValue.begin(), fConstantsByValue.end(),
+                    [](const TEnumConstant *a, const TEnumConstant *b) { return a->GetValue() < b->GetValue(); });
+   fConstantsIndexed.store((Int_t)fConstantsByPos.size(), std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the constants of the enum in declaration order; the array is
+/// updated (and the references into it invalidated) when constants are added.
+
+const std::vector<const TEnumConstant*> &TEnum::GetConstantArray() const
+{
+   BuildConstantIndex();
+   return fConstantsByPos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the idx-th constant of the enum (in declaration order), in
+/// constant time, or nullptr if idx is out of range.
+
+const TEnumConstant *TEnum::GetConstantAt(Int_t idx) const
+{
+   BuildConstantIndex();
+   if (idx < 0 || idx >= (Int_t)fConstantsByPos.size())
+      return nullptr;
+   return fConstantsByPos[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the first declared constant with the given value, or nullptr if
+/// there is none.
+
+const TEnumConstant *TEnum::GetConstantWithValue(Long64_t value) const
+{
+   BuildConstantIndex();
+   auto iter = std::lower_bound(fConstantsByValue.begin(), fConstantsByValue.end(), value,
+                                [](const TEnumConstant *c, Long64_t v) { return c->GetValue() < v; });
+   if (iter == fConstantsByValue.end() || (*iter)->GetValue() != value)
+      return nullptr;
+   return *iter;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return true if this enum object is pointing to a currently
 /// loaded enum.  If a enum is unloaded after the TEnum
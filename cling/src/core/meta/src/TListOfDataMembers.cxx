@@ -421,11 +421,12 @@ void TListOfDataMembers::Load()
 
    R__LOCKGUARD(gInterpreterMutex);
 
-   ULong64_t currentTransaction = gInterpreter->GetInterpreterStateMarker();
-   if (currentTransaction == fLastLoadMarker) {
+   // Only reload if declarations were added to this scope since the last load.
+   ULong64_t scopeMarker = gInterpreter->GetScopeStateMarker(fClass ? fClass->GetClassInfo() : nullptr);
+   if (scopeMarker <= fLastLoadMarker) {
       return;
    }
-   fLastLoadMarker = currentTransaction;
+   fLastLoadMarker = gInterpreter->GetDeclStateMarker();
 
    // In the case of namespace, even if we have loaded before we need to
    // load again in case there was new data member added.
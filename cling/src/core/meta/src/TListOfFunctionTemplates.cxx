@@ -364,11 +364,12 @@ void TListOfFunctionTemplates::Load()
 
    R__LOCKGUARD(gInterpreterMutex);
 
-   ULong64_t currentTransaction = gInterpreter->GetInterpreterStateMarker();
-   if (currentTransaction == fLastLoadMarker) {
+   // Only reload if declarations were added to this scope since the last load.
+   ULong64_t scopeMarker = gInterpreter->GetScopeStateMarker(fClass ? fClass->GetClassInfo() : nullptr);
+   if (scopeMarker <= fLastLoadMarker) {
       return;
    }
-   fLastLoadMarker = currentTransaction;
+   fLastLoadMarker = gInterpreter->GetDeclStateMarker();
 
    gInterpreter->LoadFunctionTemplates(fClass);
 }
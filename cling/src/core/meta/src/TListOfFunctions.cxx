@@ -384,11 +384,12 @@ void TListOfFunctions::Load()
 
    R__LOCKGUARD(gInterpreterMutex);
 
-   ULong64_t currentTransaction = gInterpreter->GetInterpreterStateMarker();
-   if (currentTransaction == fLastLoadMarker) {
+   // Only reload if declarations were added to this scope since the last load.
+   ULong64_t scopeMarker = gInterpreter->GetScopeStateMarker(fClass ? fClass->GetClassInfo() : nullptr);
+   if (scopeMarker <= fLastLoadMarker) {
       return;
    }
-   fLastLoadMarker = currentTransaction;
+   fLastLoadMarker = gInterpreter->GetDeclStateMarker();
 
    ClassInfo_t *info;
    if (fClass) info = fClass->GetClassInfo();
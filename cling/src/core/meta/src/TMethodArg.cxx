@@ -59,6 +59,16 @@ const char *TMethodArg::GetDefault() const
    return gCling->MethodArgInfo_DefaultValue(fInfo);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get the default value of the method argument folded to a constant, if
+/// possible. A kind of kRuntime means that the text returned by GetDefault()
+/// has to be evaluated.
+
+TInterpreter::DefaultArgValue_t TMethodArg::GetDefaultValue() const
+{
+   return gCling->MethodArgInfo_DefaultConstant(fInfo);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get full type description of method argument, e.g.: "class TDirectory*".
 
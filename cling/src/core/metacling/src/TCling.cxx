@@ -75,8 +75,11 @@ clang/LLVM technology.
 #include "TKey.h"
 #include "ClingRAII.h"
 
+#include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/Attr.h"
 #include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclarationName.h"
 #include "clang/AST/GlobalDecl.h"
 #include "clang/AST/RecordLayout.h"
@@ -111,6 +114,8 @@ clang/LLVM technology.
 #include "cling/Utils/SourceNormalization.h"
 #include "cling/Interpreter/Exception.h"
 
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/Module.h"
 
@@ -159,6 +164,29 @@ clang/LLVM technology.
 #include <dlfcn.h>
 #endif
 
+#ifdef R__LINUX
+#include <link.h>
+
+// The GDB JIT interface (see llvm/lib/ExecutionEngine/GDBRegistrationListener.cpp)
+// through which the JIT announces the objects it loaded; walked to name the
+// JIT-ed frames of a stack trace. Weak, in case no listener is linked in.
+extern "C" {
+   struct TClingJITCodeEntry {
+      TClingJITCodeEntry *fNext;
+      TClingJITCodeEntry *fPrev;
+      const char         *fSymfileAddr;
+      uint64_t            fSymfileSize;
+   };
+   struct TClingJITDescriptor {
+      uint32_t            fVersion;
+      uint32_t            fActionFlag;
+      TClingJITCodeEntry *fRelevantEntry;
+      TClingJITCodeEntry *fFirstEntry;
+   };
+   extern TClingJITDescriptor __jit_debug_descriptor __attribute__((weak));
+}
+#endif
+
 #if defined(__CYGWIN__)
 #include <sys/cygwin.h>
 #define HMODULE void *
@@ -491,9 +519,10 @@ TEnum* TCling::CreateEnum(void *VD, TClass *cl) const
    return enumType;
 }
 
-void TCling::HandleNewDecl(const void* DV, bool isDeserialized, std::set<TClass*> &modifiedTClasses) {
-   // Handle new declaration.
-   // Record the modified class, struct and namespaces in 'modifiedTClasses'.
+void TCling::HandleNewDecl(const void* DV, bool isDeserialized) {
+   // Handle new declaration: refresh the class info of new or completed
+   // classes, structs, enums and namespaces.  The lists of members, globals,
+   // functions and enums are refreshed lazily (see MarkDeclContextDirty).
 
    const clang::Decl* D = static_cast<const clang::Decl*>(DV);
 
@@ -508,47 +537,103 @@ void TCling::HandleNewDecl(const void* DV, bool isDeserialized, std::set<TClass*
    if (const clang::CXXRecordDecl* RD = dyn_cast<clang::CXXRecordDecl>(D)) {
       if (RD->getDescribedClassTemplate())
          return;
-   } else if (const clang::FunctionDecl* FD = dyn_cast<clang::FunctionDecl>(D)) {
-      if (FD->getDescribedFunctionTemplate())
-         return;
    }
 
    if (const RecordDecl *TD = dyn_cast<RecordDecl>(D)) {
       if (TD->isCanonicalDecl() || TD->isThisDeclarationADefinition())
          TCling__UpdateClassInfo(TD);
    }
-   else if (const NamedDecl *ND = dyn_cast<NamedDecl>(D)) {
+   else if (const TagDecl *TD = dyn_cast<TagDecl>(D)) {
+      // Mostly just for EnumDecl (the other TagDecl are handled
+      // by the 'RecordDecl' if statement.
+      TCling__UpdateClassInfo(TD);
+   } else if (const NamespaceDecl* NSD = dyn_cast<NamespaceDecl>(D)) {
+      TCling__UpdateClassInfo(NSD);
+   }
+}
 
-      if (const TagDecl *TD = dyn_cast<TagDecl>(D)) {
-         // Mostly just for EnumDecl (the other TagDecl are handled
-         // by the 'RecordDecl' if statement.
-         TCling__UpdateClassInfo(TD);
-      } else if (const NamespaceDecl* NSD = dyn_cast<NamespaceDecl>(D)) {
-         TCling__UpdateClassInfo(NSD);
+////////////////////////////////////////////////////////////////////////////////
+/// Record that the scope(s) of the declaration D received new declarations,
+/// so that the TListOf* of those scopes (and only those) reload on their next
+/// use.  Declarations in inline namespaces and transparent contexts (linkage
+/// specifications, unscoped enums) are visible in the enclosing scope, which
+/// is marked too.  If 'recurse', the scopes opened by D itself (namespace
+/// bodies, tag definitions) and the ones nested in them are marked as well;
+/// this is needed for the top level declarations of a transaction, whose
+/// content is not listed separately.
+
+void TCling::MarkDeclContextDirty(const clang::Decl *D, bool recurse)
+{
+   const ULong64_t marker = ++fDeclStateMarker;
+
+   for (const clang::DeclContext *DC = D->getDeclContext(); DC; DC = DC->getParent()) {
+      if (DC->isFunctionOrMethod())
+         break;
+      fScopeStateMarkers[DC->getPrimaryContext()] = marker;
+      if (!DC->isTransparentContext() && !DC->isInlineNamespace())
+         break;
+   }
+
+   if (!recurse)
+      return;
+
+   llvm::SmallVector<const clang::DeclContext*, 8> todo;
+   if (const clang::DeclContext *DC = dyn_cast<clang::DeclContext>(D))
+      todo.push_back(DC);
+   while (!todo.empty()) {
+      const clang::DeclContext *DC = todo.pop_back_val();
+      if (const clang::TagDecl *TD = dyn_cast<clang::TagDecl>(DC)) {
+         if (!TD->isThisDeclarationADefinition())
+            continue;
+      } else if (!isa<clang::NamespaceDecl>(DC) && !isa<clang::LinkageSpecDecl>(DC)) {
+         continue;
       }
+      fScopeStateMarkers[DC->getPrimaryContext()] = marker;
+      // Do not trigger deserialization: what is not loaded yet cannot be in a list.
+      for (const clang::Decl *Child : DC->noload_decls()) {
+         if (isa<clang::NamespaceDecl>(Child) || isa<clang::LinkageSpecDecl>(Child)
+             || isa<clang::TagDecl>(Child))
+            todo.push_back(cast<clang::DeclContext>(Child));
+      }
+   }
+}
 
-      // We care about declarations on the global scope.
-      if (!isa<TranslationUnitDecl>(ND->getDeclContext()))
-         return;
+////////////////////////////////////////////////////////////////////////////////
+/// Force all the TListOf* to reload on their next use, e.g. after the
+/// initial transaction or after declarations were unloaded.
 
-      // Enums are lazyly created, thus we don not need to handle them here.
-      if (isa<EnumDecl>(ND))
-         return;
+void TCling::MarkAllScopesDirty()
+{
+   fAllScopesStateMarker = ++fDeclStateMarker;
+   // The per scope markers are now all superseded.
+   fScopeStateMarkers.clear();
+}
 
-      // ROOT says that global is enum(lazylycreated)/var/field declared on the global
-      // scope.
-      if (!(isa<VarDecl>(ND)))
-         return;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the value of GetDeclStateMarker() when the declarations of 'scope'
+/// (the global scope if null) last changed.  A list loaded while
+/// GetDeclStateMarker() was at least that value is up to date.
 
-      // Skip if already in the list.
-      if (gROOT->GetListOfGlobals()->FindObject(ND->getNameAsString().c_str()))
-         return;
+ULong64_t TCling::GetScopeStateMarker(ClassInfo_t *scope) const
+{
+   R__LOCKGUARD(gInterpreterMutex);
 
-      // Put the global constants and global enums in the corresponding lists.
-      gROOT->GetListOfGlobals()->Add(new TGlobal((DataMemberInfo_t *)
-                                                 new TClingDataMemberInfo(GetInterpreterImpl(),
-                                                                          cast<ValueDecl>(ND), 0)));
+   const clang::Decl *D = nullptr;
+   if (scope) {
+      D = ((TClingClassInfo*)scope)->GetDecl();
+      if (!D)
+         return fDeclStateMarker;
+   } else {
+      D = fInterpreter->getCI()->getASTContext().getTranslationUnitDecl();
    }
+   const clang::DeclContext *DC = dyn_cast<clang::DeclContext>(D);
+   if (!DC)
+      return fDeclStateMarker;
+
+   auto iter = fScopeStateMarkers.find(DC->getPrimaryContext());
+   if (iter == fScopeStateMarkers.end() || iter->second < fAllScopesStateMarker)
+      return fAllScopesStateMarker;
+   return iter->second;
 }
 
 extern "C"
@@ -1399,7 +1484,7 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
 : TInterpreter(name, title), fMore(0), fGlobalsListSerial(-1), fMapfile(nullptr),
   fRootmapFiles(nullptr), fNormalizedCtxt(0),
   fPrevLoadedDynLibInfo(0), fClingCallbacks(0), fAutoLoadCallBack(0),
-  fTransactionCount(0), fHeaderParsingOnDemand(true), fIsAutoParsingSuspended(kFALSE)
+  fTransactionCount(0), fDeclStateMarker(1), fAllScopesStateMarker(1), fHeaderParsingOnDemand(true), fIsAutoParsingSuspended(kFALSE)
 {
    fPrompt[0] = 0;
    const bool fromRootCling = IsFromRootCling();
@@ -1696,6 +1781,15 @@ void TCling::Initialize()
 
 void TCling::ShutDown()
 {
+   if (gDebug > 0 && fClingCallbacks) {
+      unsigned long long hits, queries;
+      fClingCallbacks->GetNegativeLookupStats(hits, queries);
+      Info("TCling::ShutDown", "negative lookup cache: %llu hits in %llu failed lookups (%.1f%%)",
+           hits, queries, queries ? 100. * hits / queries : 0.);
+   }
+   if (gDebug > 0)
+      TClingCallFunc::PrintWrapperStats();
+
    fIsShuttingDown = true;
    ResetGlobals();
 }
@@ -1995,6 +2089,117 @@ namespace {
       }
    };
 
+   //////////////////////////////////////////////////////////////////////////////
+   /// Replay the compact forward declaration table written by
+   /// TModuleGenerator::SplitFwdDeclTable(). The classes and structs are
+   /// added to the AST directly, without lexing or parsing, and marked as
+   /// having an external lexical storage like ExtLexicalStorageAdder does for
+   /// the parsed ones. The enum declarations for which no decl exists yet are
+   /// appended to enumFwdDecls, to be declared with the textual payload.
+
+   void DeclareFwdDeclTable(cling::Interpreter &interp, const char *table, std::string &enumFwdDecls)
+   {
+      Sema &S = interp.getSema();
+      ASTContext &C = S.getASTContext();
+      TranslationUnitDecl *TU = C.getTranslationUnitDecl();
+
+      // Collects the new decls into a transaction of their own, such that the
+      // interpreter callbacks see them as if they were parsed.
+      cling::Interpreter::PushTransactionRAII RAII(&interp);
+
+      std::map<std::string, NamespaceDecl*> openedScopes; // by "ns1::ns2::"
+      std::vector<Decl*> topLevelDecls;
+      auto addToContext = [&](NamedDecl *ND, DeclContext *DC) {
+         if (DC == TU) {
+            S.PushOnScopeChains(ND, S.TUScope, /*AddToContext*/ true);
+            topLevelDecls.push_back(ND);
+         } else {
+            DC->addDecl(ND);
+         }
+      };
+      auto nextField = [](const char *&field) {
+         const char *current = field;
+         field += strlen(field) + 1;
+         return current;
+      };
+
+      const char *field = table;
+      while (*field) {
+         const char kind = *nextField(field);
+         std::vector<const char*> scopes;
+         while (*field)
+            scopes.push_back(nextField(field));
+         ++field;
+         const char *name = nextField(field);
+         std::vector<const char*> annotations;
+         while (*field)
+            annotations.push_back(nextField(field));
+         ++field;
+
+         if (kind == 'e') {
+            const char *enumFwdDecl = nextField(field);
+            DeclContext *DC = nullptr;
+            bool scopesFound = true;
+            for (const char *scope : scopes) {
+               DC = cling::utils::Lookup::Namespace(&S, scope, DC);
+               if (!DC) {
+                  scopesFound = false;
+                  break;
+               }
+            }
+            if (!scopesFound || !cling::utils::Lookup::Named(&S, name, DC))
+               enumFwdDecls += enumFwdDecl;
+            continue;
+         }
+
+         DeclContext *DC = TU;
+         std::string path;
+         for (const char *scope : scopes) {
+            path += scope;
+            path += "::";
+            NamespaceDecl *&opened = openedScopes[path];
+            if (!opened) {
+               NamespaceDecl *prev = cling::utils::Lookup::Namespace(&S, scope, DC);
+               if (prev) prev = prev->getMostRecentDecl();
+               opened = NamespaceDecl::Create(C, DC, prev && prev->isInline(), SourceLocation(), SourceLocation(),
+                                              &C.Idents.get(scope), prev);
+               addToContext(opened, DC);
+            }
+            DC = opened;
+         }
+
+         // Only a class declared in this very scope is redeclared; one made
+         // visible through a using directive is not.
+         NamedDecl *prev = cling::utils::Lookup::Named(&S, name, DC);
+         if (prev && prev != (NamedDecl*)-1
+             && !prev->getDeclContext()->getRedeclContext()->Equals(DC->getRedeclContext()))
+            prev = nullptr;
+         CXXRecordDecl *prevRD = nullptr;
+         if (prev) {
+            prevRD = prev != (NamedDecl*)-1 ? dyn_cast<CXXRecordDecl>(prev) : nullptr;
+            if (!prevRD) {
+               if (gDebug > 1)
+                  Info("TCling::RegisterModule",
+                       "Not forward declaring %s%s: the name is already in use", path.c_str(), name);
+               continue;
+            }
+            prevRD = prevRD->getMostRecentDecl();
+         }
+
+         CXXRecordDecl *RD = CXXRecordDecl::Create(C, kind == 's' ? TTK_Struct : TTK_Class, DC, SourceLocation(),
+                                                   SourceLocation(), &C.Idents.get(name), prevRD);
+         SourceRange noRange;
+         for (const char *annotation : annotations)
+            RD->addAttr(new (C) AnnotateAttr(noRange, C, annotation, 0));
+         addToContext(RD, DC);
+
+         for (TagDecl *reDecl = RD; reDecl; reDecl = reDecl->getPreviousDecl())
+            reDecl->setHasExternalLexicalStorage();
+      }
+
+      for (Decl *D : topLevelDecls)
+         S.getASTConsumer().HandleTopLevelDecl(DeclGroupRef(D));
+   }
 
 }
 
@@ -2098,7 +2303,8 @@ void TCling::RegisterModule(const char* modulename,
                             const FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
                             const char** classesHeaders,
                             Bool_t lateRegistration /*=false*/,
-                            Bool_t hasCxxModule /*=false*/)
+                            Bool_t hasCxxModule /*=false*/,
+                            const char* fwdDeclTable /*=nullptr*/)
 {
    const bool fromRootCling = IsFromRootCling();
    // We need the dictionary initialization but we don't want to inject the
@@ -2127,6 +2333,8 @@ void TCling::RegisterModule(const char* modulename,
    // the failed one or only the one in this module, but for now this is
    // better than nothing.
    fLookedUpClasses.clear();
+   if (fClingCallbacks)
+      fClingCallbacks->InvalidateNegativeLookups();
 
    // Make sure we do not set off autoloading or autoparsing during the
    // module registration!
@@ -2201,7 +2409,12 @@ void TCling::RegisterModule(const char* modulename,
       // We now parse the forward declarations. All the classes are then modified
       // in order for them to have an external lexical storage.
       std::string fwdDeclsCodeLessEnums;
-      {
+      if (fwdDeclTable) {
+         // The simple declarations come precompiled in the table; the enum
+         // declarations only appear there, so the text is taken as is.
+         DeclareFwdDeclTable(*fInterpreter, fwdDeclTable, fwdDeclsCodeLessEnums);
+         fwdDeclsCodeLessEnums += fwdDeclsCode;
+      } else {
          // Search for enum forward decls and only declare them if no
          // declaration exists yet.
          std::string fwdDeclsLine;
@@ -5185,6 +5398,10 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 
    R__LOCKGUARD(gInterpreterMutex);
 
+   // The new map entries may resolve names that failed to autoload before.
+   if (fClingCallbacks)
+      fClingCallbacks->InvalidateNegativeLookups();
+
    // open the [system].rootmap files
    if (!fMapfile) {
       fMapfile = new TEnv();
@@ -6404,11 +6621,11 @@ void TCling::UpdateAllCanvases()
 ////////////////////////////////////////////////////////////////////////////////
 
 void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
-   std::set<TClass*> modifiedTClasses; // TClasses that require update after this transaction
-
    // If the transaction does not contain anything we can return earlier.
    if (!HandleNewTransaction(T)) return;
 
+   R__LOCKGUARD(gInterpreterMutex);
+
    bool isTUTransaction = false;
    if (!T.empty() && T.decls_begin() + 1 == T.decls_end() && !T.hasNestedTransactions()) {
       clang::Decl* FirstDecl = *(T.decls_begin()->m_DGR.begin());
@@ -6419,21 +6636,30 @@ void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
       }
    }
 
-   std::set<const void*> TransactionDeclSet;
+   if (isTUTransaction) {
+      MarkAllScopesDirty();
+   }
+
+   llvm::SmallPtrSet<const clang::Decl*, 16> TransactionDeclSet;
    if (!isTUTransaction && T.decls_end() - T.decls_begin()) {
       const clang::Decl* WrapperFD = T.getWrapperFD();
       for (cling::Transaction::const_iterator I = T.decls_begin(), E = T.decls_end();
           I != E; ++I) {
-         if (I->m_Call != cling::Transaction::kCCIHandleTopLevelDecl
-             && I->m_Call != cling::Transaction::kCCIHandleTagDeclDefinition)
+         if (I->m_Call == cling::Transaction::kCCINone)
             continue;
+         const bool isTopLevel = I->m_Call == cling::Transaction::kCCIHandleTopLevelDecl
+                                 || I->m_Call == cling::Transaction::kCCIHandleTagDeclDefinition;
 
          for (DeclGroupRef::const_iterator DI = I->m_DGR.begin(),
                  DE = I->m_DGR.end(); DI != DE; ++DI) {
             if (*DI == WrapperFD)
                continue;
+            // Instantiations and implicit definitions can also add to a scope.
+            MarkDeclContextDirty(*DI, isTopLevel);
+            if (!isTopLevel)
+               continue;
             TransactionDeclSet.insert(*DI);
-            ((TCling*)gCling)->HandleNewDecl(*DI, false, modifiedTClasses);
+            HandleNewDecl(*DI, false);
          }
       }
    }
@@ -6444,45 +6670,12 @@ void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
            E = T.deserialized_decls_end(); I != E; ++I) {
       for (DeclGroupRef::const_iterator DI = I->m_DGR.begin(),
               DE = I->m_DGR.end(); DI != DE; ++DI)
-         if (TransactionDeclSet.find(*DI) == TransactionDeclSet.end()) {
+         if (!TransactionDeclSet.count(*DI)) {
+            MarkDeclContextDirty(*DI, /*recurse*/false);
             //FIXME: HandleNewDecl should take DeclGroupRef
-            ((TCling*)gCling)->HandleNewDecl(*DI, /*isDeserialized*/true,
-                                             modifiedTClasses);
+            HandleNewDecl(*DI, /*isDeserialized*/true);
          }
    }
-
-
-   // When fully building the reflection info in TClass, a deserialization
-   // could be triggered, which may result in request for building the
-   // reflection info for the same TClass. This in turn will clear the caches
-   // for the TClass in-flight and cause null ptr derefs.
-   // FIXME: This is a quick fix, solving most of the issues. The actual
-   // question is: Shouldn't TClass provide a lock mechanism on update or lock
-   // itself until the update is done.
-   //
-   std::vector<TClass*> modifiedTClassesDiff(modifiedTClasses.size());
-   std::vector<TClass*>::iterator it;
-   it = set_difference(modifiedTClasses.begin(), modifiedTClasses.end(),
-                       ((TCling*)gCling)->GetModTClasses().begin(),
-                       ((TCling*)gCling)->GetModTClasses().end(),
-                       modifiedTClassesDiff.begin());
-   modifiedTClassesDiff.resize(it - modifiedTClassesDiff.begin());
-
-   // Lock the TClass for updates
-   ((TCling*)gCling)->GetModTClasses().insert(modifiedTClassesDiff.begin(),
-                                              modifiedTClassesDiff.end());
-   for (std::vector<TClass*>::const_iterator I = modifiedTClassesDiff.begin(),
-           E = modifiedTClassesDiff.end(); I != E; ++I) {
-      // Make sure the TClass has not been deleted.
-      if (!gROOT->GetListOfClasses()->FindObject(*I)) {
-         continue;
-      }
-      // Could trigger deserialization of decls.
-      cling::Interpreter::PushTransactionRAII RAII(GetInterpreterImpl());
-      // Unlock the TClass for updates
-      ((TCling*)gCling)->GetModTClasses().erase(*I);
-
-   }
 }
 
 ///\brief Invalidate stored TCling state for declarations included in transaction `T'.
@@ -6491,6 +6684,11 @@ void TCling::UpdateListsOnUnloaded(const cling::Transaction &T)
 {
    HandleNewTransaction(T);
 
+   {
+      R__LOCKGUARD(gInterpreterMutex);
+      MarkAllScopesDirty();
+   }
+
    auto Lists = std::make_tuple((TListOfDataMembers *)gROOT->GetListOfGlobals(),
                                 (TListOfFunctions *)gROOT->GetListOfGlobalFunctions(),
                                 (TListOfFunctionTemplates *)gROOT->GetListOfFunctionTemplates(),
@@ -7016,6 +7214,73 @@ void* TCling::FindSym(const char* entry) const
    return fInterpreter->getAddressOfGlobal(entry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the JIT-ed function that contains addr, by scanning the symbol tables
+/// of the objects registered by the JIT through the GDB JIT interface. On
+/// success, name is set to the (mangled) symbol name and symaddr to the start
+/// of the function. Meant to be called from the stack trace printed on a
+/// crash: takes no lock and does not allocate. Linux only.
+
+Bool_t TCling::GetJITSymbol(const void* addr, const char*& name, const void*& symaddr) const
+{
+#ifdef R__LINUX
+   if (!&__jit_debug_descriptor)
+      return kFALSE;
+
+   const uintptr_t target = (uintptr_t)addr;
+   uintptr_t best = 0;
+   const char *bestname = nullptr;
+   for (const TClingJITCodeEntry *entry = __jit_debug_descriptor.fFirstEntry; entry; entry = entry->fNext) {
+      const char *image = entry->fSymfileAddr;
+      const uint64_t size = entry->fSymfileSize;
+      if (!image || size < sizeof(ElfW(Ehdr)) || memcmp(image, ELFMAG, SELFMAG))
+         continue;
+      const ElfW(Ehdr) *ehdr = (const ElfW(Ehdr)*)image;
+      if (!ehdr->e_shoff || ehdr->e_shentsize != sizeof(ElfW(Shdr))
+          || ehdr->e_shoff + (uint64_t)ehdr->e_shnum * sizeof(ElfW(Shdr)) > size)
+         continue;
+      const ElfW(Shdr) *shdrs = (const ElfW(Shdr)*)(image + ehdr->e_shoff);
+      for (unsigned i = 0; i < ehdr->e_shnum; ++i) {
+         const ElfW(Shdr) &symtab = shdrs[i];
+         if (symtab.sh_type != SHT_SYMTAB || symtab.sh_entsize != sizeof(ElfW(Sym))
+             || symtab.sh_link >= ehdr->e_shnum || symtab.sh_offset + symtab.sh_size > size)
+            continue;
+         const ElfW(Shdr) &strtab = shdrs[symtab.sh_link];
+         if (strtab.sh_offset + strtab.sh_size > size)
+            continue;
+         const ElfW(Sym) *syms = (const ElfW(Sym)*)(image + symtab.sh_offset);
+         const char *strs = image + strtab.sh_offset;
+         for (size_t isym = 0, nsyms = symtab.sh_size / sizeof(ElfW(Sym)); isym < nsyms; ++isym) {
+            const ElfW(Sym) &sym = syms[isym];
+            if (ELF64_ST_TYPE(sym.st_info) != STT_FUNC || sym.st_shndx == SHN_UNDEF
+                || sym.st_shndx >= ehdr->e_shnum || sym.st_name >= strtab.sh_size)
+               continue;
+            // Relocatable objects (what the JIT registers) carry the load
+            // address of each section in its header.
+            uintptr_t start = (uintptr_t)sym.st_value;
+            if (ehdr->e_type == ET_REL)
+               start += (uintptr_t)shdrs[sym.st_shndx].sh_addr;
+            if (target < start || start <= best)
+               continue;
+            if (sym.st_size && target >= start + sym.st_size)
+               continue;
+            best = start;
+            bestname = strs + sym.st_name;
+         }
+      }
+   }
+
+   if (!bestname || !bestname[0])
+      return kFALSE;
+   name = bestname;
+   symaddr = (const void*)best;
+   return kTRUE;
+#else
+   (void)addr; (void)name; (void)symaddr;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Let the interpreter issue a generic error, and set its error state.
 
@@ -7362,12 +7627,15 @@ bool TCling::CallFunc_IsValid(CallFunc_t* func) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Return the wrapper for calling func.  If allow_shared, the wrapper may be
+/// shared by all functions of the same signature, in which case the returned
+/// fTarget must be passed in place of the object.
 
 TInterpreter::CallFuncIFacePtr_t
-TCling::CallFunc_IFacePtr(CallFunc_t* func, bool as_iface) const
+TCling::CallFunc_IFacePtr(CallFunc_t* func, bool as_iface, bool allow_shared) const
 {
    TClingCallFunc* f = (TClingCallFunc*) func;
-   return f->IFacePtr(as_iface);
+   return f->IFacePtr(as_iface, allow_shared);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -8530,6 +8798,14 @@ const char* TCling::MethodArgInfo_DefaultValue(MethodArgInfo_t* marginfo) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TInterpreter::DefaultArgValue_t TCling::MethodArgInfo_DefaultConstant(MethodArgInfo_t* marginfo) const
+{
+   TClingMethodArgInfo* info = (TClingMethodArgInfo*) marginfo;
+   return info->DefaultConstant();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 const char* TCling::MethodArgInfo_Name(MethodArgInfo_t* marginfo) const
 {
    TClingMethodArgInfo* info = (TClingMethodArgInfo*) marginfo;
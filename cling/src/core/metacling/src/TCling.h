@@ -149,6 +149,9 @@ private: // Data Members
    std::vector<std::pair<TClass*,DictFuncPtr_t> > fClassesToUpdate;
    void* fAutoLoadCallBack;
    ULong64_t fTransactionCount; // Cling counter for commited or unloaded transactions which changed the AST.
+   ULong64_t fDeclStateMarker;  // Counter bumped each time declarations are added to or removed from scopes.
+   ULong64_t fAllScopesStateMarker; // Value of fDeclStateMarker when all scopes were last invalidated.
+   std::unordered_map<const clang::DeclContext*, ULong64_t> fScopeStateMarkers; // Value of fDeclStateMarker when a (primary) DeclContext last received declarations.
 
    typedef void* SpecialObjectLookupCtx_t;
    typedef std::unordered_map<std::string, TObject*> SpecialObjectMap_t;
@@ -217,6 +220,8 @@ public: // Public Interface
    virtual const char* GetSTLIncludePath() const;
    TObjArray*  GetRootMapFiles() const { return fRootmapFiles; }
    ULong64_t GetInterpreterStateMarker() const { return fTransactionCount;}
+   ULong64_t GetScopeStateMarker(ClassInfo_t *scope) const;
+   ULong64_t GetDeclStateMarker() const { return fDeclStateMarker; }
    virtual void Initialize();
    virtual void ShutDown();
    void    InspectMembers(TMemberInspector&, const void* obj, const TClass* cl, Bool_t isTransient);
@@ -242,7 +247,8 @@ public: // Public Interface
                           const FwdDeclArgsToKeepCollection_t& fwdDeclsArgToSkip,
                           const char** classesHeaders,
                           Bool_t lateRegistration = false,
-                          Bool_t hasCxxModule = false);
+                          Bool_t hasCxxModule = false,
+                          const char* fwdDeclTable = nullptr);
    void    RegisterTClassUpdate(TClass *oldcl,DictFuncPtr_t dict);
    void    UnRegisterTClassUpdate(const TClass *oldcl);
 
@@ -314,6 +320,7 @@ public: // Public Interface
    // Misc
    virtual int    DisplayIncludePath(FILE* fout) const;
    virtual void*  FindSym(const char* entry) const;
+   virtual Bool_t GetJITSymbol(const void* addr, const char*& name, const void*& symaddr) const;
    virtual void   GenericError(const char* error) const;
    virtual Long_t GetExecByteCode() const;
    virtual int    GetSecurityError() const;
@@ -349,7 +356,7 @@ public: // Public Interface
    virtual MethodInfo_t* CallFunc_FactoryMethod(CallFunc_t* func) const;
    virtual void   CallFunc_Init(CallFunc_t* func) const;
    virtual bool   CallFunc_IsValid(CallFunc_t* func) const;
-   virtual CallFuncIFacePtr_t CallFunc_IFacePtr(CallFunc_t* func, bool as_iface) const;
+   virtual CallFuncIFacePtr_t CallFunc_IFacePtr(CallFunc_t* func, bool as_iface, bool allow_shared = false) const;
    virtual void   CallFunc_SetFunc(CallFunc_t* func, MethodInfo_t* info) const;
 
    virtual std::string CallFunc_GetWrapperCode(CallFunc_t* func, bool as_iface) const;
@@ -475,6 +482,7 @@ public: // Public Interface
    virtual int    MethodArgInfo_Next(MethodArgInfo_t* marginfo) const;
    virtual Long_t MethodArgInfo_Property(MethodArgInfo_t* marginfo) const;
    virtual const char* MethodArgInfo_DefaultValue(MethodArgInfo_t* marginfo) const;
+   virtual DefaultArgValue_t MethodArgInfo_DefaultConstant(MethodArgInfo_t* marginfo) const;
    virtual const char* MethodArgInfo_Name(MethodArgInfo_t* marginfo) const;
    virtual const char* MethodArgInfo_TypeName(MethodArgInfo_t* marginfo) const;
    virtual std::string MethodArgInfo_TypeNormalizedName(MethodArgInfo_t *marginfo) const;
@@ -509,7 +517,9 @@ public: // Public Interface
 
    std::set<TClass*>& GetModTClasses() { return fModTClasses; }
 
-   void HandleNewDecl(const void* DV, bool isDeserialized, std::set<TClass*>& modifiedClasses);
+   void HandleNewDecl(const void* DV, bool isDeserialized);
+   void MarkDeclContextDirty(const clang::Decl *D, bool recurse);
+   void MarkAllScopesDirty();
    void UpdateListsOnCommitted(const cling::Transaction &T);
    void UpdateListsOnUnloaded(const cling::Transaction &T);
    void InvalidateGlobal(const clang::Decl *D);
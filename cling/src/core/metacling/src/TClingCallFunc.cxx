@@ -66,11 +66,17 @@ C++ interpreter and the Clang C++ compiler, not CINT.
 
 #include "clang/Sema/SemaInternal.h"
 
+#include <chrono>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <string>
 #include <sstream>
 
+#ifdef R__LINUX
+#include <sys/mman.h>
+#endif
+
 
 using namespace CppyyLegacy;
 using namespace llvm;
@@ -92,6 +98,45 @@ static inline WrapperStore_t& get_wrapper_store(bool as_iface) {
 }
 static map<const Decl *, void *> gCtorWrapperStore;
 static map<const Decl *, void *> gDtorWrapperStore;
+// Signature-shared wrappers, keyed by canonical function type; null if the
+// wrapper failed to compile, so that it is not attempted again.
+static map<const clang::Type *, void *> gSharedWrapperStore;
+
+// Wrapper statistics, see TClingCallFunc::PrintWrapperStats().
+static ULong64_t gWrappersCompiled = 0LL;       // all wrappers, including shared ones
+static ULong64_t gSharedWrappersCompiled = 0LL;
+static ULong64_t gSharedWrapperUses = 0LL;      // functions served by a shared wrapper
+static double    gWrapperCompileTime = 0.;      // in seconds
+
+// Code pages holding the wrappers' entry points: each wrapper is a module
+// of its own, so a large bound API scatters them over many pages.
+static const uintptr_t kWrapperPageSize   = 4096;
+static const uintptr_t kWrapperRegionSize = 2*1024*1024;  // a huge page
+static std::set<uintptr_t> gWrapperCodePages;
+static std::set<uintptr_t> gWrapperCodeRegions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the code page of a newly compiled wrapper.  With CPPYY_WRAPPER_HUGEPAGES
+/// set, the 2 MiB region around it is advised for transparent huge pages the first
+/// time a wrapper lands in it, so that the wrappers of a region share one iTLB
+/// entry once khugepaged has collapsed it.  Called with gInterpreterMutex held.
+
+static void record_wrapper_code(void *F)
+{
+   if (!F) return;
+   uintptr_t addr = (uintptr_t)F;
+   gWrapperCodePages.insert(addr & ~(kWrapperPageSize - 1));
+   uintptr_t region = addr & ~(kWrapperRegionSize - 1);
+   if (!gWrapperCodeRegions.insert(region).second)
+      return;
+#if defined(R__LINUX) && defined(MADV_HUGEPAGE)
+   static const bool advise = gSystem->Getenv("CPPYY_WRAPPER_HUGEPAGES") != nullptr;
+   // The region is not necessarily all mapped; the advice still applies to the
+   // mapped parts of it (ENOMEM only reports the holes).
+   if (advise)
+      madvise((void*)region, kWrapperRegionSize, MADV_HUGEPAGE);
+#endif
+}
 
 static inline
 void indent(ostringstream &buf, int indent_level)
@@ -224,8 +269,13 @@ size_t TClingCallFunc::CalculateMinRequiredArguments()
 void *TClingCallFunc::compile_wrapper(const string &wrapper_name, const string &wrapper,
                                       bool withAccessControl/*=true*/)
 {
-   return fInterp->compileFunction(wrapper_name, wrapper, false /*ifUnique*/,
-                                   false /* withAccessControl */);
+   auto start = std::chrono::steady_clock::now();
+   void *F = fInterp->compileFunction(wrapper_name, wrapper, false /*ifUnique*/,
+                                      false /* withAccessControl */);
+   gWrapperCompileTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   ++gWrappersCompiled;
+   record_wrapper_code(F);
+   return F;
 }
 
 void TClingCallFunc::collect_type_info(QualType &QT, ostringstream &typedefbuf, std::ostringstream &callbuf,
@@ -433,12 +483,13 @@ void TClingCallFunc::make_narg_call(const std::string &return_type, const unsign
    // we supply the object parameter.
    // Therefore we only use it in cases where we know it works and set this variable
    // to true when we do.
-   bool ShouldCastFunction = optype.empty() && \
+   // A signature-shared wrapper always casts, to the pointer passed as 'obj'.
+   bool ShouldCastFunction = fCallThroughTarget || (optype.empty() && \
                              !isa<CXXMethodDecl>(FD) && N == FD->getNumParams() \
                              && !FD->isTemplateInstantiation() && return_type != "(lambda)" \
-                             && !FD->getReturnType()->isFunctionPointerType();
+                             && !FD->getReturnType()->isFunctionPointerType());
    if (ShouldCastFunction) {
-      callbuf << "((" << return_type << " (&)(";
+      callbuf << "((" << return_type << (fCallThroughTarget ? " (*)(" : " (&)(");
       for (unsigned i = 0U; i < N; ++i) {
          if (i) {
             callbuf << ',';
@@ -510,7 +561,9 @@ void TClingCallFunc::make_narg_call(const std::string &return_type, const unsign
        function_name = function_name.substr(0, function_name.find(','))+'>';
 #endif
 
-   if (optype.empty() || N == 1) {
+   if (fCallThroughTarget) {
+      callbuf << "obj";
+   } else if (optype.empty() || N == 1) {
       bool isMethod = false;
       if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(FD)) {
          // This is a class, struct, or union member.
@@ -1223,6 +1276,80 @@ tcling_callfunc_Wrapper_t TClingCallFunc::make_wrapper(bool as_iface)
    return (tcling_callfunc_Wrapper_t)F;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the canonical signature under which the wrapper of the current
+/// function can be shared, or null if it needs its own wrapper.  Sharing is
+/// possible for non-inline free functions and static methods without default
+/// arguments whose address is known; 'target' is set to that address.
+
+const clang::Type *TClingCallFunc::get_shared_signature(void *&target)
+{
+   target = nullptr;
+
+   const FunctionDecl *FD = GetDecl();
+   if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(FD)) {
+      if (!MD->isStatic())
+         return nullptr;
+   }
+   if (FD->isInlined() || FD->isVariadic() || FD->isDeleted() || FD->isConstexpr()
+       || FD->isTemplateInstantiation() || FD->isOverloadedOperator()
+       || FD->getNumParams() != GetMinRequiredArguments())
+      return nullptr;
+
+   // The types must be nameable from the wrapper (see make_narg_call).
+   QualType RT = FD->getReturnType();
+   if (RT->isFunctionPointerType() || RT->isUndeducedType())
+      return nullptr;
+   if (const CXXRecordDecl *RD = RT.getCanonicalType()->getAsCXXRecordDecl()) {
+      if (RD->isLambda() || RD->getAccess() == AS_private || RD->getAccess() == AS_protected)
+         return nullptr;
+   }
+   for (const ParmVarDecl *PVD : FD->parameters()) {
+      const CXXRecordDecl *RD = PVD->getType().getCanonicalType()->getAsCXXRecordDecl();
+      if (RD && (RD->getAccess() == AS_private || RD->getAccess() == AS_protected))
+         return nullptr;
+   }
+
+   // Only functions that are already compiled; do not emit anything here.
+   target = fInterp->getAddressOfGlobal(GlobalDecl(FD));
+   if (!target)
+      return nullptr;
+
+   return FD->getASTContext().getCanonicalType(FD->getType()).getTypePtr();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the wrapper shared by all functions of 'signature'; it calls the
+/// function pointer received as its 'obj' argument.  A failure is remembered
+/// as well: the functions of that signature then get wrappers of their own.
+
+tcling_callfunc_Wrapper_t TClingCallFunc::make_shared_wrapper(const clang::Type *signature)
+{
+   R__LOCKGUARD_CLING(gInterpreterMutex);
+
+   string wrapper_name;
+   string wrapper;
+
+   fCallThroughTarget = true;
+   int ok = get_wrapper_code(wrapper_name, wrapper, false);
+   fCallThroughTarget = false;
+   if (!ok) {
+      gSharedWrapperStore.insert(make_pair(signature, nullptr));
+      return 0;
+   }
+
+   void *F = compile_wrapper(wrapper_name, wrapper);
+   gSharedWrapperStore.insert(make_pair(signature, F));
+   if (F) {
+      ++gSharedWrappersCompiled;
+   } else {
+      ::CppyyLegacy::Error("TClingCallFunc::make_shared_wrapper",
+            "Failed to compile\n  ==== SOURCE BEGIN ====\n%s\n  ==== SOURCE END ====",
+            wrapper.c_str());
+   }
+   return (tcling_callfunc_Wrapper_t)F;
+}
+
 tcling_callfunc_ctor_Wrapper_t TClingCallFunc::make_ctor_wrapper(const TClingClassInfo *info)
 {
    // Make a code string that follows this pattern:
@@ -1662,13 +1789,33 @@ bool TClingCallFunc::IsValid() const
    return fMethod->IsValid();
 }
 
-TInterpreter::CallFuncIFacePtr_t TClingCallFunc::IFacePtr(bool as_iface)
+TInterpreter::CallFuncIFacePtr_t TClingCallFunc::IFacePtr(bool as_iface, bool allow_shared /*= false*/)
 {
    if (!IsValid()) {
       ::CppyyLegacy::Error("TClingCallFunc::IFacePtr(kind)",
             "Attempt to get interface while invalid.");
       return TInterpreter::CallFuncIFacePtr_t();
    }
+   if (allow_shared) {
+      R__LOCKGUARD_CLING(gInterpreterMutex);
+      void *target = nullptr;
+      if (const clang::Type *signature = get_shared_signature(target)) {
+         tcling_callfunc_Wrapper_t F;
+         auto I = gSharedWrapperStore.find(signature);
+         if (I != gSharedWrapperStore.end()) {
+            F = (tcling_callfunc_Wrapper_t) I->second;   // null after a failure
+         } else {
+            F = make_shared_wrapper(signature);
+         }
+         if (F) {
+            ++gSharedWrapperUses;
+            TInterpreter::CallFuncIFacePtr_t faceptr(F, as_iface);
+            faceptr.fTarget = target;
+            return faceptr;
+         }
+         // Fall back to a wrapper of its own.
+      }
+   }
    if (!fWrapper) {
       const FunctionDecl *decl = GetDecl();
 
@@ -1684,6 +1831,19 @@ TInterpreter::CallFuncIFacePtr_t TClingCallFunc::IFacePtr(bool as_iface)
    return TInterpreter::CallFuncIFacePtr_t(fWrapper, as_iface);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Print the number of compiled wrappers and the time spent compiling them.
+
+void TClingCallFunc::PrintWrapperStats()
+{
+   ::CppyyLegacy::Info("TClingCallFunc::PrintWrapperStats",
+         "%llu wrappers compiled in %.3f s; %llu signature-shared wrappers serve %llu functions",
+         gWrappersCompiled, gWrapperCompileTime, gSharedWrappersCompiled, gSharedWrapperUses);
+   ::CppyyLegacy::Info("TClingCallFunc::PrintWrapperStats",
+         "wrapper code spans %llu pages of 4 KiB in %llu regions of 2 MiB",
+         (ULong64_t)gWrapperCodePages.size(), (ULong64_t)gWrapperCodeRegions.size());
+}
+
 void TClingCallFunc::SetFunc(const TClingClassInfo *info, const char *method, const char *arglist,
                              intptr_t *poffset)
 {
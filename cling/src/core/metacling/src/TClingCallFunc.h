@@ -42,6 +42,7 @@ class BuiltinType;
 class Expr;
 class FunctionDecl;
 class CXXMethodDecl;
+class Type;
 }
 
 namespace cling {
@@ -76,6 +77,8 @@ private:
    size_t fMinRequiredArguments = -1;
    /// Pointer to compiled wrapper, we do *not* own.
    tcling_callfunc_Wrapper_t fWrapper;
+   /// Generate a signature-shared wrapper, calling through the pointer passed as 'obj'.
+   bool fCallThroughTarget = false;
 
 private:
    enum EReferenceType {
@@ -107,6 +110,8 @@ private:
                                    std::ostringstream& buf, int indent_level);
 
    tcling_callfunc_Wrapper_t      make_wrapper(bool as_iface);
+   const clang::Type*             get_shared_signature(void*& target);
+   tcling_callfunc_Wrapper_t      make_shared_wrapper(const clang::Type* signature);
    tcling_callfunc_ctor_Wrapper_t make_ctor_wrapper(const TClingClassInfo* info);
    tcling_callfunc_dtor_Wrapper_t make_dtor_wrapper(const TClingClassInfo* info);
 
@@ -156,7 +161,8 @@ public:
    void Init(std::unique_ptr<TClingMethodInfo>);
    void* InterfaceMethod(bool as_iface);
    bool IsValid() const;
-   TInterpreter::CallFuncIFacePtr_t IFacePtr(bool as_iface);
+   TInterpreter::CallFuncIFacePtr_t IFacePtr(bool as_iface, bool allow_shared = false);
+   static void PrintWrapperStats();
    const clang::FunctionDecl *GetDecl() {
       if (!fDecl)
          fDecl = fMethod->GetMethodDecl();
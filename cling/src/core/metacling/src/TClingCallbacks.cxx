@@ -34,6 +34,8 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 
+#include <algorithm>
+
 #include "TClingUtils.h"
 #include "ClingRAII.h"
 
@@ -82,7 +84,8 @@ TClingCallbacks::TClingCallbacks(cling::Interpreter* interp, bool hasCodeGen)
    : InterpreterCallbacks(interp),
      fLastLookupCtx(0), fROOTSpecialNamespace(0),
      fFirstRun(true), fIsAutoloading(false), fIsAutoloadingRecursively(false),
-     fIsAutoParsingSuspended(false), fPPOldFlag(false), fPPChanged(false) {
+     fIsAutoParsingSuspended(false), fPPOldFlag(false), fPPChanged(false),
+     fLookupGeneration(0), fNegativeLookupHits(0), fNegativeLookupQueries(0) {
    if (hasCodeGen) {
       Transaction* T = 0;
       m_Interpreter->declare("namespace __CppyyLegacy_SpecialObjects{}", &T);
@@ -387,6 +390,20 @@ bool TClingCallbacks::LookupObject(clang::TagDecl* Tag) {
 }
 
 
+// Return the context that, together with the name and the lookup kind,
+// determines the outcome of a failed lookup from the scope S: local scopes
+// are skipped as whatever they declare was already found by Sema.
+//
+static const DeclContext *getNegativeLookupContext(Scope *S, Sema &SemaR) {
+   for (; S; S = S->getParent()) {
+      if (const DeclContext *DC = S->getEntity()) {
+         if (!DC->isFunctionOrMethod())
+            return DC->getPrimaryContext();
+      }
+   }
+   return SemaR.getASTContext().getTranslationUnitDecl();
+}
+
 // The symbol might be defined in the ROOT class autoloading map so we have to
 // try to autoload it first and do secondary lookup to try to find it.
 //
@@ -416,6 +433,17 @@ bool TClingCallbacks::tryAutoParseInternal(llvm::StringRef Name, LookupResult &R
            || kind == Sema::LookupNamespaceName))
         return false;
 
+     // A name that could not be found before will not be found now either,
+     // unless something was declared or loaded since: skip the autoload /
+     // autoparse attempt and its (expensive) lookups.
+     const IdentifierInfo *II = R.getLookupName().getAsIdentifierInfo();
+     const DeclContext *lookupDC = nullptr;
+     if (!FE && II && !fIsAutoParsingSuspended) {
+        lookupDC = getNegativeLookupContext(S, SemaR);
+        if (isKnownNegativeLookup(II->getName(), kind, lookupDC))
+           return false;
+     }
+
      fIsAutoloadingRecursively = true;
 
      bool lookupSuccess = false;
@@ -462,11 +490,80 @@ bool TClingCallbacks::tryAutoParseInternal(llvm::StringRef Name, LookupResult &R
 
      if (lookupSuccess)
        return true;
+
+     if (lookupDC)
+        addNegativeLookup(II->getName(), kind, lookupDC);
    }
 
    return false;
 }
 
+bool TClingCallbacks::isKnownNegativeLookup(llvm::StringRef Name, unsigned Kind,
+                                            const DeclContext *DC) {
+   ++fNegativeLookupQueries;
+   auto iter = fNegativeLookups.find(Name.str());
+   if (iter == fNegativeLookups.end())
+      return false;
+   for (const NegativeLookup_t &entry : iter->second) {
+      if (entry.fKind == Kind && entry.fDC == DC && entry.fGeneration == fLookupGeneration) {
+         ++fNegativeLookupHits;
+         return true;
+      }
+   }
+   return false;
+}
+
+void TClingCallbacks::addNegativeLookup(llvm::StringRef Name, unsigned Kind,
+                                        const DeclContext *DC) {
+   // Bound the memory used by the cache; it refills with the names in use.
+   const size_t kMaxNegativeLookups = 16384;
+   if (fNegativeLookups.size() >= kMaxNegativeLookups)
+      fNegativeLookups.clear();
+
+   std::vector<NegativeLookup_t> &entries = fNegativeLookups[Name.str()];
+   const unsigned long long generation = fLookupGeneration;
+   entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                [generation](const NegativeLookup_t &entry) {
+                                   return entry.fGeneration != generation;
+                                }),
+                 entries.end());
+   entries.push_back({Kind, DC, generation});
+}
+
+// Forget the failed lookups of the names declared by the transaction T.
+//
+void TClingCallbacks::forgetNegativeLookups(const Transaction &T) {
+   if (fNegativeLookups.empty())
+      return;
+
+   llvm::SmallVector<const Decl*, 16> todo;
+   for (auto I = T.decls_begin(), E = T.decls_end(); I != E; ++I)
+      todo.append(I->m_DGR.begin(), I->m_DGR.end());
+   for (auto I = T.deserialized_decls_begin(), E = T.deserialized_decls_end(); I != E; ++I)
+      todo.append(I->m_DGR.begin(), I->m_DGR.end());
+
+   while (!todo.empty()) {
+      const Decl *D = todo.pop_back_val();
+      if (isa<UsingDirectiveDecl>(D)) {
+         // Makes a whole namespace visible.
+         InvalidateNegativeLookups();
+         return;
+      }
+      if (const NamedDecl *ND = dyn_cast<NamedDecl>(D)) {
+         if (const IdentifierInfo *II = ND->getDeclName().getAsIdentifierInfo())
+            fNegativeLookups.erase(II->getName().str());
+      }
+      // Do not trigger deserialization: what is not loaded yet is not visible.
+      const DeclContext *DC = dyn_cast<DeclContext>(D);
+      if (DC && (isa<NamespaceDecl>(D) || isa<LinkageSpecDecl>(D)
+                 || (isa<TagDecl>(D) && cast<TagDecl>(D)->isThisDeclarationADefinition())))
+         todo.append(DC->noload_decls_begin(), DC->noload_decls_end());
+   }
+
+   for (auto I = T.nested_begin(), E = T.nested_end(); I != E; ++I)
+      forgetNegativeLookups(**I);
+}
+
 bool TClingCallbacks::tryResolveAtRuntimeInternal(LookupResult &R, Scope *S) {
    if (!fROOTSpecialNamespace) {
       // init error or rootcling
@@ -674,6 +771,8 @@ void TClingCallbacks::TransactionCommitted(const Transaction &T) {
    if (fFirstRun && T.empty())
       Initialize();
 
+   forgetNegativeLookups(T);
+
    TCling__UpdateListsOnCommitted(T, m_Interpreter);
 }
 
@@ -683,6 +782,7 @@ void TClingCallbacks::TransactionUnloaded(const Transaction &T) {
    if (T.empty())
       return;
 
+   InvalidateNegativeLookups();
    TCling__UpdateListsOnUnloaded(T);
 }
 
@@ -692,6 +792,7 @@ void TClingCallbacks::TransactionRollback(const Transaction &T) {
    if (T.empty())
       return;
 
+   InvalidateNegativeLookups();
    TCling__TransactionRollback(T);
 }
 
@@ -714,11 +815,14 @@ void TClingCallbacks::DeclDeserialized(const clang::Decl* D) {
 
 void TClingCallbacks::LibraryLoaded(const void* dyLibHandle,
                                     llvm::StringRef canonicalName) {
+   // The library may have registered dictionaries (TClassTable).
+   InvalidateNegativeLookups();
    TCling__LibraryLoadedRTTI(dyLibHandle, canonicalName);
 }
 
 void TClingCallbacks::LibraryUnloaded(const void* dyLibHandle,
                                       llvm::StringRef canonicalName) {
+   InvalidateNegativeLookups();
    TCling__LibraryUnloadedRTTI(dyLibHandle, canonicalName);
 }
 
@@ -12,10 +12,14 @@
 #include "cling/Interpreter/InterpreterCallbacks.h"
 
 #include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace clang {
    class Decl;
+   class DeclContext;
    class LookupResult;
    class NamespaceDecl;
    class Scope;
@@ -49,6 +53,19 @@ private:
    bool fIsAutoParsingSuspended;
    bool fPPOldFlag;
    bool fPPChanged;
+
+   // Negative lookup cache: names for which tryAutoParseInternal found
+   // nothing, with the lookup kind and context and the generation at that
+   // time.  An entry is only valid while its generation is current.
+   struct NegativeLookup_t {
+      unsigned fKind;
+      const clang::DeclContext *fDC;
+      unsigned long long fGeneration;
+   };
+   std::unordered_map<std::string, std::vector<NegativeLookup_t>> fNegativeLookups;
+   unsigned long long fLookupGeneration;
+   unsigned long long fNegativeLookupHits;
+   unsigned long long fNegativeLookupQueries;
 public:
    TClingCallbacks(cling::Interpreter* interp, bool hasCodeGen);
 
@@ -62,6 +79,15 @@ public:
    void SetAutoParsingSuspended(bool val = true) { fIsAutoParsingSuspended = val; }
    bool IsAutoParsingSuspended() { return fIsAutoParsingSuspended; }
 
+   // Forget all failed lookups, e.g. because a library, rootmap or PCM may
+   // provide new names.  Names declared by a transaction are forgotten
+   // individually when it is committed.
+   void InvalidateNegativeLookups() { ++fLookupGeneration; }
+   void GetNegativeLookupStats(unsigned long long &hits, unsigned long long &queries) const {
+      hits = fNegativeLookupHits;
+      queries = fNegativeLookupQueries;
+   }
+
    virtual bool LibraryLoadingFailed(const std::string&, const std::string&, bool, bool);
 
    void InclusionDirective(clang::SourceLocation /*HashLoc*/, const clang::Token & /*IncludeTok*/,
@@ -120,6 +146,9 @@ private:
    bool tryResolveAtRuntimeInternal(clang::LookupResult &R, clang::Scope *S);
    bool shouldResolveAtRuntime(clang::LookupResult &R, clang::Scope *S);
    bool tryInjectImplicitAutoKeyword(clang::LookupResult &R, clang::Scope *S);
+   bool isKnownNegativeLookup(llvm::StringRef Name, unsigned Kind, const clang::DeclContext *DC);
+   void addNegativeLookup(llvm::StringRef Name, unsigned Kind, const clang::DeclContext *DC);
+   void forgetNegativeLookups(const cling::Transaction &T);
 };
 
 } // namespace CppyyLegacy
@@ -500,6 +500,10 @@ long TClingDataMemberInfo::Property() const
          property |= kIsStatic;
       }
    }
+   if (const clang::FieldDecl *fieldd = llvm::dyn_cast<clang::FieldDecl>(GetDecl())) {
+      if (fieldd->isBitField())
+         property |= kIsBitfield;
+   }
    if (llvm::isa<clang::EnumConstantDecl>(GetDecl())) {
       // Enumeration constant are considered to be 'static' data member in
       // the CINT (and thus ROOT) scheme.
@@ -27,8 +27,10 @@ the Clang C++ compiler, not CINT.
 #include "ThreadLocalStorage.h"
 
 #include "cling/Interpreter/Interpreter.h"
+#include "clang/AST/APValue.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Decl.h"
+#include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/PrettyPrinter.h"
@@ -109,11 +111,11 @@ long TClingMethodArgInfo::Property() const
    return property;
 }
 
-const char *TClingMethodArgInfo::DefaultValue() const
+/// Return the default argument expression of the current parameter, after
+/// instantiating it if needed (the uninstantiated one if that fails).
+
+const clang::Expr *TClingMethodArgInfo::GetDefaultExpr() const
 {
-   if (!IsValid()) {
-      return 0;
-   }
    const clang::ParmVarDecl *pvd = GetDecl();
    // Instantiate default arg if needed
    if (pvd->hasUninstantiatedDefaultArg()) {
@@ -124,13 +126,20 @@ const char *TClingMethodArgInfo::DefaultValue() const
                                                 const_cast<clang::FunctionDecl*>(fd),
                                                 const_cast<clang::ParmVarDecl*>(pvd));
    }
-   const clang::Expr *expr = 0;
    if (pvd->hasUninstantiatedDefaultArg()) {
       // We tried to instantiate it above; if we fail, use the uninstantiated one.
-      expr = pvd->getUninstantiatedDefaultArg();
-   } else {
-      expr = pvd->getDefaultArg();
+      return pvd->getUninstantiatedDefaultArg();
+   }
+   return pvd->getDefaultArg();
+}
+
+const char *TClingMethodArgInfo::DefaultValue() const
+{
+   if (!IsValid()) {
+      return 0;
    }
+   const clang::ParmVarDecl *pvd = GetDecl();
+   const clang::Expr *expr = GetDefaultExpr();
    clang::ASTContext &context = pvd->getASTContext();
    clang::PrintingPolicy policy(context.getPrintingPolicy());
    TTHREAD_TLS_DECL( std::string, buf );
@@ -163,6 +172,110 @@ const char *TClingMethodArgInfo::DefaultValue() const
    return buf.c_str();
 }
 
+/// If the default argument expression is a std::string built from nothing or
+/// from a string literal, store its value in str and return true.
+
+static bool GetStdStringDefault(const clang::Expr *expr, const clang::ASTContext &context, std::string &str)
+{
+   const clang::Expr *e = expr->IgnoreImplicit();
+   if (auto cast = llvm::dyn_cast<clang::CXXFunctionalCastExpr>(e))
+      e = cast->getSubExpr()->IgnoreImplicit();
+   auto construct = llvm::dyn_cast<clang::CXXConstructExpr>(e);
+   if (!construct)
+      return false;
+
+   auto spec = llvm::dyn_cast_or_null<clang::ClassTemplateSpecializationDecl>(
+      construct->getType()->getAsCXXRecordDecl());
+   if (!spec || !spec->isInStdNamespace() || spec->getName() != "basic_string" ||
+       !context.hasSameType(spec->getTemplateArgs()[0].getAsType(), context.CharTy))
+      return false;
+
+   str.clear();
+   unsigned nargs = construct->getNumArgs();
+   if (nargs == 0)
+      return true;
+   auto literal = llvm::dyn_cast<clang::StringLiteral>(construct->getArg(0)->IgnoreImplicit());
+   if (!literal || literal->getCharByteWidth() != 1)
+      return false;
+   // anything but the literal (e.g. a length, or a non-default allocator) is left to run time
+   for (unsigned iarg = 1; iarg < nargs; ++iarg) {
+      if (!llvm::isa<clang::CXXDefaultArgExpr>(construct->getArg(iarg)))
+         return false;
+   }
+   // std::string(const char*) stops at the first embedded NUL
+   llvm::StringRef bytes = literal->getString();
+   str = bytes.substr(0, bytes.find('\0')).str();
+   return true;
+}
+
+/// Evaluate the default argument of the current parameter at compile time.
+/// Integral, floating point and null pointer constants (including
+/// enumerators and constexpr values), string literals and std::string
+/// built from those are returned as typed values; anything else is
+/// flagged kRuntime, to be evaluated from the text of DefaultValue().
+
+TInterpreter::DefaultArgValue_t TClingMethodArgInfo::DefaultConstant() const
+{
+   typedef TInterpreter::DefaultArgValue_t Value_t;
+   Value_t value;
+   if (!IsValid()) {
+      return value;
+   }
+   const clang::ParmVarDecl *pvd = GetDecl();
+   if (!pvd->hasDefaultArg() && !pvd->hasInheritedDefaultArg()) {
+      return value;
+   }
+
+   value.fKind = Value_t::kRuntime;
+   const clang::Expr *expr = GetDefaultExpr();
+   if (!expr || pvd->hasUninstantiatedDefaultArg() || expr->isValueDependent() || expr->isTypeDependent()) {
+      return value;
+   }
+
+   clang::ASTContext &context = pvd->getASTContext();
+   if (auto literal = llvm::dyn_cast<clang::StringLiteral>(expr->IgnoreParenImpCasts())) {
+      if (literal->getCharByteWidth() == 1) {
+         value.fKind = Value_t::kString;
+         value.fString = literal->getString().str();
+      }
+      return value;
+   }
+   if (GetStdStringDefault(expr, context, value.fString)) {
+      value.fKind = Value_t::kString;
+      return value;
+   }
+
+   clang::QualType qt = pvd->getType().getCanonicalType();
+   if (qt->isAnyPointerType() || qt->isNullPtrType() || qt->isMemberPointerType()) {
+      if (expr->isNullPointerConstant(context, clang::Expr::NPC_ValueDependentIsNotNull) != clang::Expr::NPCK_NotNull)
+         value.fKind = Value_t::kNullPointer;
+      return value;
+   }
+
+   clang::Expr::EvalResult result;
+   if (!expr->EvaluateAsRValue(result, context) || result.HasSideEffects) {
+      return value;
+   }
+   const clang::APValue &val = result.Val;
+   if (val.isInt()) {
+      const llvm::APSInt &ival = val.getInt();
+      if (ival.isSigned() && ival.getMinSignedBits() <= 64) {
+         value.fKind = Value_t::kInteger;
+         value.fInt = ival.getSExtValue();
+      } else if (!ival.isSigned() && ival.getActiveBits() <= 64) {
+         value.fKind = Value_t::kUnsigned;
+         value.fUInt = ival.getZExtValue();
+      }
+   } else if (val.isFloat()) {
+      llvm::APFloat fval = val.getFloat();
+      bool losesInfo = false;
+      fval.convert(llvm::APFloat::IEEEdouble(), llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+      value.fKind = Value_t::kFloat;
+      value.fFloat = fval.convertToDouble();
+   }
+   return value;
+}
+
 const TClingTypeInfo *TClingMethodArgInfo::Type() const
 {
    TTHREAD_TLS_DECL_ARG( TClingTypeInfo, ti, fInterp);
@@ -27,10 +27,12 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TClingDeclInfo.h"
+#include "TInterpreter.h"
 #include "clang/AST/Decl.h"
 
 
 namespace clang {
+   class Expr;
    class ParmVarDecl;
 }
 
@@ -50,6 +52,8 @@ private:
    cling::Interpreter       *fInterp; // Cling interpreter, we do *not* own.
    int                       fIdx; // Iterator, current parameter index.
 
+   const clang::Expr     *GetDefaultExpr() const;
+
 public:
 
    explicit TClingMethodArgInfo(cling::Interpreter *interp) : TClingDeclInfo(nullptr), fInterp(interp), fIdx(-1) {}
@@ -65,6 +69,7 @@ public:
    int                    Next();
    long                   Property() const;
    const char            *DefaultValue() const;
+   TInterpreter::DefaultArgValue_t DefaultConstant() const;
    const TClingTypeInfo  *Type() const;
    const char            *TypeName() const;
 
@@ -174,6 +174,14 @@ public:
    TVirtualRWMutex::Hint_t *WriteLock();
    void WriteUnLock(TVirtualRWMutex::Hint_t *);
 
+   /// Re-entry depth of the calling thread; `hint` is the value returned by ReadLock().
+   size_t GetRecurseDepth(TVirtualRWMutex::Hint_t *hint, bool write) const
+   {
+      if (write)
+         return fRecurseCounts.fWriteRecurse;
+      return hint ? *reinterpret_cast<const size_t *>(hint) : 0;
+   }
+
    std::unique_ptr<State> GetStateBefore();
    std::unique_ptr<StateDelta> Rewind(const State &earlierState);
    void Apply(std::unique_ptr<StateDelta> &&delta);
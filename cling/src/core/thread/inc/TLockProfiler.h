@@ -0,0 +1,83 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TLockProfiler
+#define ROOT_TLockProfiler
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TLockProfiler                                                        //
+//                                                                      //
+// Lock contention profiler for gCoreMutex (and gInterpreterMutex /     //
+// gROOTMutex, which alias it).  Requires a build with                  //
+// -Dlockprofiler=ON, which makes the lock guard macros report their    //
+// call site.  Each thread records into its own ring buffer of events   //
+// and its own per call site summary, so recording never contends.      //
+//                                                                      //
+// Enable it by setting CPPYY_LOCK_PROFILE to an output file name (a    //
+// .json name produces a Chrome trace, anything else a flat profile)    //
+// or through the C API below.  The profile is written at exit.         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TVirtualLockProfiler.h"
+
+#include <string>
+
+
+namespace CppyyLegacy {
+
+class TLockProfiler : public TVirtualLockProfiler {
+
+public:
+   enum EFormat {
+      kFlat        = 0,  // One line per call site and mode, sorted by total wait time
+      kChromeTrace = 1   // Chrome trace-event JSON (chrome://tracing, Perfetto)
+   };
+
+private:
+   std::string fOutput;      // File written at exit, if any
+   size_t      fRingSize;    // Number of events kept per thread
+
+   TLockProfiler();
+   TLockProfiler(const TLockProfiler&);             // not implemented
+   TLockProfiler& operator=(const TLockProfiler&);  // not implemented
+
+public:
+   virtual ~TLockProfiler() { }
+
+   void Record(const void *mutex, const char *file, Int_t line, EMode mode, size_t depth,
+               ULong64_t start, ULong64_t wait, ULong64_t hold) override;
+
+   static TLockProfiler &Instance();
+
+   static Bool_t  Enable(const char *output = nullptr, size_t ringSize = 0);
+   static void    Disable();
+   static void    Reset();
+   static Bool_t  Dump(const char *path, EFormat format);
+   static EFormat FormatFor(const char *path);
+};
+
+} // namespace CppyyLegacy
+
+extern "C" {
+   // Start profiling; 'output' (may be null) is written at exit.  Returns 0
+   // on success, -1 if the library was built without R__LOCK_PROFILING.
+   int  cppyy_lock_profiler_enable(const char *output);
+   void cppyy_lock_profiler_disable();
+   // Forget all the recorded acquisitions.
+   void cppyy_lock_profiler_reset();
+   // Write the profile now; 'format' is 0 for flat, 1 for Chrome trace and
+   // -1 to deduce it from the file extension.  Returns 0 on success.
+   int  cppyy_lock_profiler_dump(const char *path, int format);
+}
+
+#endif
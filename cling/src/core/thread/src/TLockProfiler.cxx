@@ -0,0 +1,437 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TLockProfiler
+\ingroup Thread
+
+Lock contention profiler for gCoreMutex.
+
+When ROOT is built with `-Dlockprofiler=ON` (which defines R__LOCK_PROFILING),
+R__LOCKGUARD, R__READ_LOCKGUARD and R__WRITE_LOCKGUARD pass `__FILE__` and
+`__LINE__` to their guard, which then reports, for each acquisition, the time
+spent waiting for the lock, the time it was held, the mode (exclusive, read or
+write) and the re-entry depth of the calling thread as counted by the
+TReentrantRWLock RecurseCounts.  Without that build option the macros are
+unchanged and nothing is recorded.
+
+Every thread owns a log made of a ring buffer of the most recent events and of
+a per call site summary.  Only the owning thread writes to it, so the lock
+protecting it is uncontended except while dumping or resetting.  The logs of
+finished threads are kept until exit.
+
+The profile is either a flat table, one line per call site and mode sorted by
+total wait time, or a Chrome trace-event JSON file showing the wait and hold
+phase of the buffered events per thread (open with chrome://tracing or
+Perfetto).
+
+Profiling starts when the library is loaded if `CPPYY_LOCK_PROFILE` names an
+output file (a `.json` name selects the Chrome trace), and the profile is then
+written at exit.  `CPPYY_LOCK_PROFILE_EVENTS` sets the size of the per-thread
+ring buffer (default 65536 events).  The same can be done through the
+`cppyy_lock_profiler_*` C functions.
+*/
+
+#include "TLockProfiler.h"
+#include "ROOT/TSpinMutex.hxx"
+#include "ThreadLocalStorage.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+
+namespace CppyyLegacy {
+
+namespace {
+
+const size_t kDefaultRingSize = 65536;
+
+struct LockEvent_t {
+   const char *fFile;
+   Int_t       fLine;
+   Int_t       fMode;
+   size_t      fDepth;
+   ULong64_t   fStart;
+   ULong64_t   fWait;
+   ULong64_t   fHold;
+};
+
+struct SiteKey_t {
+   const char *fFile;
+   Int_t       fLine;
+   Int_t       fMode;
+
+   bool operator==(const SiteKey_t &other) const
+   {
+      return fFile == other.fFile && fLine == other.fLine && fMode == other.fMode;
+   }
+};
+
+struct SiteKeyHash_t {
+   size_t operator()(const SiteKey_t &key) const
+   {
+      return std::hash<const void*>()(key.fFile) ^ (size_t(key.fLine) << 2) ^ size_t(key.fMode);
+   }
+};
+
+struct SiteStats_t {
+   ULong64_t fCount     = 0;
+   ULong64_t fWaitTotal = 0;
+   ULong64_t fWaitMax   = 0;
+   ULong64_t fHoldTotal = 0;
+   ULong64_t fHoldMax   = 0;
+   size_t    fMaxDepth  = 0;
+
+   void Add(const SiteStats_t &other)
+   {
+      fCount     += other.fCount;
+      fWaitTotal += other.fWaitTotal;
+      fHoldTotal += other.fHoldTotal;
+      fWaitMax    = std::max(fWaitMax, other.fWaitMax);
+      fHoldMax    = std::max(fHoldMax, other.fHoldMax);
+      fMaxDepth   = std::max(fMaxDepth, other.fMaxDepth);
+   }
+};
+
+// Everything recorded by one thread.
+struct ThreadLog_t {
+   UInt_t                   fThreadIndex;
+   TSpinMutex               fLock;        // Taken by the owner when recording, by others when dumping
+   std::vector<LockEvent_t> fEvents;      // Ring buffer of the most recent events
+   size_t                   fNext = 0;    // Next slot to fill in fEvents
+   bool                     fWrapped = false;
+   std::unordered_map<SiteKey_t, SiteStats_t, SiteKeyHash_t> fSites;
+
+   ThreadLog_t(UInt_t index, size_t ringSize) : fThreadIndex(index) { fEvents.resize(ringSize); }
+
+   void Clear()
+   {
+      fNext = 0;
+      fWrapped = false;
+      fSites.clear();
+   }
+};
+
+// Logs of all the threads, including the finished ones.  Never destroyed, so
+// that threads still running during the static destruction can record safely.
+struct ThreadLogs_t {
+   std::mutex                                 fMutex;
+   std::vector<std::unique_ptr<ThreadLog_t>>  fLogs;
+};
+
+ThreadLogs_t &GetThreadLogs()
+{
+   static ThreadLogs_t *logs = new ThreadLogs_t;
+   return *logs;
+}
+
+ThreadLog_t &GetThreadLog(size_t ringSize)
+{
+   TTHREAD_TLS_DECL_ARG(ThreadLog_t*, threadLog, nullptr);
+   if (!threadLog) {
+      ThreadLogs_t &logs = GetThreadLogs();
+      std::lock_guard<std::mutex> lock(logs.fMutex);
+      logs.fLogs.emplace_back(new ThreadLog_t(logs.fLogs.size(), ringSize ? ringSize : 1));
+      threadLog = logs.fLogs.back().get();
+   }
+   return *threadLog;
+}
+
+const char *ModeName(Int_t mode)
+{
+   switch (mode) {
+      case TVirtualLockProfiler::kRead:  return "read";
+      case TVirtualLockProfiler::kWrite: return "write";
+      default:                           return "exclusive";
+   }
+}
+
+// Print 'str' as the content of a JSON string.
+void PrintJSONString(FILE *out, const char *str)
+{
+   for (const char *c = str; *c; ++c) {
+      if (*c == '"' || *c == '\\')
+         fputc('\\', out);
+      fputc(*c, out);
+   }
+}
+
+std::once_flag gAtExitFlag;
+
+void DumpAtExit()
+{
+   TLockProfiler::Disable();
+}
+
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, the profiler is a singleton (see Instance()).
+
+TLockProfiler::TLockProfiler() : fRingSize(kDefaultRingSize)
+{
+   if (const char *events = std::getenv("CPPYY_LOCK_PROFILE_EVENTS")) {
+      long n = std::atol(events);
+      if (n > 0)
+         fRingSize = n;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the profiler; it is never deleted.
+
+TLockProfiler &TLockProfiler::Instance()
+{
+   static TLockProfiler *instance = new TLockProfiler;
+   return *instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record one acquisition in the log of the calling thread.
+
+void TLockProfiler::Record(const void * /* mutex */, const char *file, Int_t line, EMode mode, size_t depth,
+                           ULong64_t start, ULong64_t wait, ULong64_t hold)
+{
+   ThreadLog_t &log = GetThreadLog(fRingSize);
+   std::lock_guard<TSpinMutex> lock(log.fLock);
+
+   LockEvent_t &event = log.fEvents[log.fNext];
+   event.fFile  = file;
+   event.fLine  = line;
+   event.fMode  = mode;
+   event.fDepth = depth;
+   event.fStart = start;
+   event.fWait  = wait;
+   event.fHold  = hold;
+   if (++log.fNext == log.fEvents.size()) {
+      log.fNext = 0;
+      log.fWrapped = true;
+   }
+
+   SiteStats_t &stats = log.fSites[SiteKey_t{file, line, mode}];
+   ++stats.fCount;
+   stats.fWaitTotal += wait;
+   stats.fHoldTotal += hold;
+   stats.fWaitMax  = std::max(stats.fWaitMax, wait);
+   stats.fHoldMax  = std::max(stats.fHoldMax, hold);
+   stats.fMaxDepth = std::max(stats.fMaxDepth, depth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start recording.  If 'output' is given, the profile is written there at
+/// exit, in the format deduced from its extension.  A non-zero 'ringSize'
+/// overrides the number of events kept for threads that did not record yet.
+/// Returns false if the lock guards were compiled without R__LOCK_PROFILING,
+/// in which case nothing would ever be recorded.
+
+Bool_t TLockProfiler::Enable(const char *output /* = nullptr */, size_t ringSize /* = 0 */)
+{
+#ifdef R__LOCK_PROFILING
+   TLockProfiler &profiler = Instance();
+   if (ringSize)
+      profiler.fRingSize = ringSize;
+   if (output && *output) {
+      profiler.fOutput = output;
+      // Create the registry before registering the handler so that it is
+      // still usable when the handler runs.
+      GetThreadLogs();
+      std::call_once(gAtExitFlag, []() { atexit(DumpAtExit); });
+   }
+   gLockProfiler.store(&profiler, std::memory_order_release);
+   return kTRUE;
+#else
+   (void)output;
+   (void)ringSize;
+   ::CppyyLegacy::Warning("TLockProfiler::Enable", "not available, rebuild with -Dlockprofiler=ON");
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop recording and, if an output file was requested, write the profile.
+
+void TLockProfiler::Disable()
+{
+   TVirtualLockProfiler *expected = &Instance();
+   if (!gLockProfiler.compare_exchange_strong(expected, nullptr))
+      return;
+   TLockProfiler &profiler = Instance();
+   if (!profiler.fOutput.empty()) {
+      std::string output;
+      output.swap(profiler.fOutput);
+      Dump(output.c_str(), FormatFor(output.c_str()));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget everything recorded so far.
+
+void TLockProfiler::Reset()
+{
+   ThreadLogs_t &logs = GetThreadLogs();
+   std::lock_guard<std::mutex> lock(logs.fMutex);
+   for (auto &log : logs.fLogs) {
+      std::lock_guard<TSpinMutex> loglock(log->fLock);
+      log->Clear();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kChromeTrace for a '.json' file name and kFlat otherwise.
+
+TLockProfiler::EFormat TLockProfiler::FormatFor(const char *path)
+{
+   size_t len = path ? strlen(path) : 0;
+   if (len >= 5 && strcmp(path + len - 5, ".json") == 0)
+      return kChromeTrace;
+   return kFlat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the profile recorded so far to 'path' ("-" for stdout).
+
+Bool_t TLockProfiler::Dump(const char *path, EFormat format)
+{
+   FILE *out = (path && strcmp(path, "-") != 0) ? fopen(path, "w") : stdout;
+   if (!out) {
+      ::CppyyLegacy::Error("TLockProfiler::Dump", "cannot open %s for writing", path);
+      return kFALSE;
+   }
+
+   ThreadLogs_t &logs = GetThreadLogs();
+   std::lock_guard<std::mutex> lock(logs.fMutex);
+
+   if (format == kFlat) {
+      // Merge the threads; the same header may be seen through several
+      // __FILE__ literals, hence the key on the file name.
+      std::map<std::tuple<std::string, Int_t, Int_t>, SiteStats_t> sites;
+      ULong64_t total = 0;
+      for (auto &log : logs.fLogs) {
+         std::lock_guard<TSpinMutex> loglock(log->fLock);
+         for (auto &site : log->fSites) {
+            sites[std::make_tuple(std::string(site.first.fFile), site.first.fLine, site.first.fMode)].Add(site.second);
+            total += site.second.fCount;
+         }
+      }
+      std::vector<std::pair<std::string, SiteStats_t>> sorted;
+      std::vector<const char*> modes;
+      sorted.reserve(sites.size());
+      for (auto &site : sites) {
+         sorted.emplace_back(std::get<0>(site.first) + ":" + std::to_string(std::get<1>(site.first)), site.second);
+         modes.push_back(ModeName(std::get<2>(site.first)));
+      }
+      std::vector<size_t> order(sorted.size());
+      for (size_t i = 0; i < order.size(); ++i)
+         order[i] = i;
+      std::sort(order.begin(), order.end(), [&sorted](size_t a, size_t b) {
+         return sorted[a].second.fWaitTotal > sorted[b].second.fWaitTotal;
+      });
+
+      fprintf(out, "# Lock contention profile: %llu acquisitions from %lu call sites in %lu threads\n",
+              (unsigned long long)total, (unsigned long)sorted.size(), (unsigned long)logs.fLogs.size());
+      fprintf(out, "# %-9s %12s %14s %12s %14s %12s %9s  %s\n", "mode", "count", "wait_tot[us]", "wait_max[us]",
+              "hold_tot[us]", "hold_max[us]", "max_depth", "call site");
+      for (size_t i : order) {
+         const SiteStats_t &stats = sorted[i].second;
+         fprintf(out, "  %-9s %12llu %14.3f %12.3f %14.3f %12.3f %9lu  %s\n", modes[i],
+                 (unsigned long long)stats.fCount, stats.fWaitTotal / 1e3, stats.fWaitMax / 1e3,
+                 stats.fHoldTotal / 1e3, stats.fHoldMax / 1e3, (unsigned long)stats.fMaxDepth, sorted[i].first.c_str());
+      }
+   } else {
+      ULong64_t origin = 0;
+      for (auto &log : logs.fLogs) {
+         std::lock_guard<TSpinMutex> loglock(log->fLock);
+         size_t n = log->fWrapped ? log->fEvents.size() : log->fNext;
+         for (size_t i = 0; i < n; ++i)
+            if (!origin || log->fEvents[i].fStart < origin)
+               origin = log->fEvents[i].fStart;
+      }
+
+      fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+      const char *sep = "\n";
+      for (auto &log : logs.fLogs) {
+         std::lock_guard<TSpinMutex> loglock(log->fLock);
+         size_t n = log->fWrapped ? log->fEvents.size() : log->fNext;
+         size_t first = log->fWrapped ? log->fNext : 0;
+         for (size_t k = 0; k < n; ++k) {
+            const LockEvent_t &event = log->fEvents[(first + k) % log->fEvents.size()];
+            const char *phases[2] = {"wait", "hold"};
+            ULong64_t begin[2] = {event.fStart, event.fStart + event.fWait};
+            ULong64_t duration[2] = {event.fWait, event.fHold};
+            for (int p = 0; p < 2; ++p) {
+               fprintf(out, "%s{\"name\":\"", sep);
+               PrintJSONString(out, event.fFile);
+               fprintf(out, ":%d\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u,"
+                       "\"args\":{\"mode\":\"%s\",\"depth\":%lu}}",
+                       event.fLine, phases[p], (begin[p] - origin) / 1e3, duration[p] / 1e3, log->fThreadIndex,
+                       ModeName(event.fMode), (unsigned long)event.fDepth);
+               sep = ",\n";
+            }
+         }
+      }
+      fprintf(out, "\n]}\n");
+   }
+
+   if (out != stdout)
+      fclose(out);
+   else
+      fflush(out);
+   return kTRUE;
+}
+
+namespace {
+
+// Honour CPPYY_LOCK_PROFILE as soon as the library is loaded.
+struct TLockProfilerInit {
+   TLockProfilerInit()
+   {
+      if (const char *output = std::getenv("CPPYY_LOCK_PROFILE"))
+         TLockProfiler::Enable(output);
+   }
+} gLockProfilerInit;
+
+} // unnamed namespace
+
+} // namespace CppyyLegacy
+
+extern "C" {
+
+int cppyy_lock_profiler_enable(const char *output)
+{
+   return CppyyLegacy::TLockProfiler::Enable(output) ? 0 : -1;
+}
+
+void cppyy_lock_profiler_disable()
+{
+   CppyyLegacy::TLockProfiler::Disable();
+}
+
+void cppyy_lock_profiler_reset()
+{
+   CppyyLegacy::TLockProfiler::Reset();
+}
+
+int cppyy_lock_profiler_dump(const char *path, int format)
+{
+   using CppyyLegacy::TLockProfiler;
+   TLockProfiler::EFormat fmt = format < 0 ? TLockProfiler::FormatFor(path) : TLockProfiler::EFormat(format);
+   return TLockProfiler::Dump(path, fmt) ? 0 : -1;
+}
+
+} // extern "C"
@@ -60,6 +60,16 @@ void TRWMutexImp<MutexT, RecurseCountsT>::WriteUnLock(TVirtualRWMutex::Hint_t *h
    fMutexImp.WriteUnLock(hint);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of times the calling thread holds the lock in the given
+/// mode; `hint` is the value returned by ReadLock(), used in read mode.
+
+template <typename MutexT, typename RecurseCountsT>
+size_t TRWMutexImp<MutexT, RecurseCountsT>::GetRecurseDepth(TVirtualRWMutex::Hint_t *hint, Bool_t write)
+{
+   return fMutexImp.GetRecurseDepth(hint, write);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create mutex and return pointer to it.
 
@@ -27,6 +27,7 @@ public:
    void ReadUnLock(Hint_t *) override;
    Hint_t * WriteLock() override;
    void WriteUnLock(Hint_t *) override;
+   size_t GetRecurseDepth(Hint_t *hint, Bool_t write) override;
 
    TVirtualRWMutex *Factory(Bool_t /*recursive*/ = kFALSE) override;
    std::unique_ptr<State> GetStateBefore() override;
@@ -201,6 +201,9 @@ extern "C" {
 #   endif
 #   include <dlfcn.h>
 #endif
+#if defined(HAVE_BACKTRACE_SYMBOLS_FD) && defined(HAVE_DLADDR)
+#   include <cxxabi.h>
+#endif
 
 #ifdef HAVE_BACKTRACE_SYMBOLS_FD
    // The maximum stack trace depth for systems where we request the
@@ -547,6 +550,107 @@ static void DylibAdded(const struct mach_header *mh, intptr_t /* vmaddr_slide */
 }
 #endif
 
+#if defined(HAVE_BACKTRACE_SYMBOLS_FD) && defined(HAVE_DLADDR)
+// Demangling buffer of InProcessStackTrace(), allocated ahead of any crash.
+static char   *gStackTraceDemangleBuf  = nullptr;
+static size_t  gStackTraceDemangleSize = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare for InProcessStackTrace(): the first call to backtrace() loads
+/// libgcc_s, which allocates, so better have it done before a crash.
+
+static void WarmUpStackTrace()
+{
+   void *trace[2];
+   backtrace(trace, 2);
+   if (!gStackTraceDemangleBuf) {
+      gStackTraceDemangleSize = 4096;
+      gStackTraceDemangleBuf  = (char *)malloc(gStackTraceDemangleSize);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the demangled symname, or symname itself if it cannot be demangled.
+
+static const char *DemangleFrame(const char *symname)
+{
+   if (!gStackTraceDemangleBuf || strncmp(symname, "_Z", 2))
+      return symname;
+   int    status = 0;
+   size_t size   = gStackTraceDemangleSize;
+   char  *res    = abi::__cxa_demangle(symname, gStackTraceDemangleBuf, &size, &status);
+   if (!res)
+      return symname;
+   // __cxa_demangle() reallocates the buffer if the name does not fit
+   gStackTraceDemangleBuf  = res;
+   gStackTraceDemangleSize = size;
+   return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the stack trace of the calling thread to fd, skipping the innermost
+/// skip frames, without spawning any process. Frames are named through
+/// dladdr(), or by the interpreter for JIT-ed code; frames without a name are
+/// printed as library + offset, ready for addr2line. Returns the number of
+/// frames written.
+
+static int InProcessStackTrace(int fd, int skip)
+{
+#ifdef R__B64
+   const char *format1 = " 0x%016lx in %.500s %s 0x%lx from %.200s\n";
+   const char *format2 = " 0x%016lx in %.500s %s 0x%lx (JIT)\n";
+   const char *format3 = " 0x%016lx in <unknown function> from %.200s + 0x%lx\n";
+   const char *format4 = " 0x%016lx in <unknown function>\n";
+#else
+   const char *format1 = " 0x%08lx in %.500s %s 0x%lx from %.200s\n";
+   const char *format2 = " 0x%08lx in %.500s %s 0x%lx (JIT)\n";
+   const char *format3 = " 0x%08lx in <unknown function> from %.200s + 0x%lx\n";
+   const char *format4 = " 0x%08lx in <unknown function>\n";
+#endif
+
+   char  buffer[1024];
+   void *trace[kMAX_BACKTRACE_DEPTH];
+   int   depth   = backtrace(trace, kMAX_BACKTRACE_DEPTH);
+   int   nframes = 0;
+   for (int n = skip; n < depth; n++) {
+      ULong_t addr = (ULong_t) trace[n];
+      Dl_info info;
+      const char *jitname = nullptr;
+      const void *jitaddr = nullptr;
+      int len;
+
+      if (dladdr(trace[n], &info) && info.dli_fname && info.dli_fname[0]) {
+         ULong_t libaddr = (ULong_t) info.dli_fbase;
+         ULong_t symaddr = (ULong_t) info.dli_saddr;
+         if (info.dli_sname && info.dli_sname[0] && symaddr) {
+            Bool_t gte = (addr >= symaddr);
+            len = snprintf(buffer, sizeof(buffer), format1, addr, DemangleFrame(info.dli_sname),
+                           gte ? "+" : "-", gte ? addr - symaddr : symaddr - addr, info.dli_fname);
+         } else {
+            len = snprintf(buffer, sizeof(buffer), format3, addr, info.dli_fname,
+                           addr >= libaddr ? addr - libaddr : addr);
+         }
+      } else if (gCling && gCling->GetJITSymbol(trace[n], jitname, jitaddr)) {
+         len = snprintf(buffer, sizeof(buffer), format2, addr, DemangleFrame(jitname),
+                        "+", addr - (ULong_t) jitaddr);
+      } else {
+         len = snprintf(buffer, sizeof(buffer), format4, addr);
+      }
+
+      if (len < 0)
+         continue;
+      if (len >= (int)sizeof(buffer)) {
+         len = sizeof(buffer) - 1;
+         buffer[len - 1] = '\n';
+      }
+      if (write(fd, buffer, len) < 0)
+         break;
+      ++nframes;
+   }
+   return nframes;
+}
+#endif
+
 } // namespace CppyyLegacy
 
 ClassImp(TUnixSystem);
@@ -607,6 +711,10 @@ Bool_t TUnixSystem::Init()
    SetRootSys();
 #endif
 
+#if defined(HAVE_BACKTRACE_SYMBOLS_FD) && defined(HAVE_DLADDR)
+   WarmUpStackTrace();
+#endif
+
    // This is a fallback in case TROOT::GetRootSys() can't determine ROOTSYS
    gRootDir = FoundationUtils::GetFallbackRootSys().c_str();
 
@@ -1933,12 +2041,37 @@ void* addrlist[kMAX_BACKTRACE_DEPTH];
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Print a stack trace.
+///
+/// On Linux and MacOS X the trace is produced within the process (see
+/// InProcessStackTrace()), which takes milliseconds rather than the seconds
+/// needed to attach gdb. Set Root.StacktraceGdb to get the gdb backtrace
+/// (with line numbers and the other threads) instead; it is also the fallback
+/// if the in-process trace cannot be produced.
 
 void TUnixSystem::StackTrace()
 {
    if (!gEnv->GetValue("Root.Stacktrace", 1))
       return;
 
+#if defined(HAVE_BACKTRACE_SYMBOLS_FD) && defined(HAVE_DLADDR)
+   if (!gEnv->GetValue("Root.StacktraceGdb", 0)) {
+      std::cout.flush();
+      fflush(stdout);
+      std::cerr.flush();
+      fflush(stderr);
+
+      // skip the frame of InProcessStackTrace() itself
+      if (InProcessStackTrace(STDERR_FILENO, 1) > 0) {
+         const char *mess = gEnv->GetValue("Root.StacktraceMessage", "");
+         if (mess && mess[0]) {
+            if (write(STDERR_FILENO, mess, strlen(mess)) < 0 || write(STDERR_FILENO, "\n", 1) < 0)
+               Warning("StackTrace", "problems writing message (errno: %d)", TSystem::GetErrno());
+         }
+         return;
+      }
+   }
+#endif
+
 #ifndef R__MACOSX
    TString gdbscript = gEnv->GetValue("Root.StacktraceScript", "");
    gdbscript = gdbscript.Strip();
@@ -34,7 +34,7 @@ def getArgs():
       cxxflags = argv[2]
    extraHeadersList = ""
    if argc > 3:
-      extraHeadersList = argv[2:]
+      extraHeadersList = argv[3:]
    return pchFileName, cxxflags, extraHeadersList
 
 #-------------------------------------------------------------------------------
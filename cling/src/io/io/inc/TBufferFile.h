@@ -65,6 +65,7 @@ protected:
    UInt_t CheckObject(UInt_t offset, const TClass *cl, Bool_t readClass = kFALSE);
 
    void  WriteObjectClass(const void *actualObjStart, const TClass *actualClass, Bool_t cacheReuse) override;
+   Bool_t IsExactTBufferFile() const;
 
 public:
    enum { kStreamedMemberWise = BIT(14) }; //added to version number to know if a collection has been stored member-wise
@@ -231,6 +232,7 @@ public:
    void     ReadTString(TString   &s) override;
    void     ReadStdString(std::string *s) override;
    using    TBuffer::ReadStdString;
+   void     ReadStdStrings(std::string *s, Int_t n, size_t stride = sizeof(std::string)) override;
    void     ReadCharStar(char* &s) override;
 
    void     WriteBool(Bool_t       b) override;
@@ -250,6 +252,7 @@ public:
    void     WriteTString(const TString &s) override;
    using    TBuffer::WriteStdString;
    void     WriteStdString(const std::string *s) override;
+   void     WriteStdStrings(const std::string *s, Int_t n, size_t stride = sizeof(std::string)) override;
    void     WriteCharStar(char *s) override;
 
    // Utilities for TClass
@@ -23,6 +23,12 @@
 #include "Compression.h"
 #include "TDirectory.h"
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 
 namespace CppyyLegacy {
 
@@ -33,6 +39,16 @@ class TFile;
 class TDirectoryFile : public TDirectory {
 
 protected:
+   /// Identity of a key listed by the keys records. A key removed and rewritten
+   /// in the same free slot keeps its location, so the location alone is not enough.
+   struct TKeyOnFile {
+      Int_t       fNbytes;
+      Short_t     fCycle;
+      UInt_t      fDatime;
+      std::string fName;
+      Bool_t      Matches(const TKey &key) const;
+   };
+
    Bool_t      fModified{kFALSE};        ///< True if directory has been modified
    Bool_t      fWritable{kFALSE};        ///< True if directory is writable
    TDatime     fDatimeC;                 ///< Date and time when directory is created
@@ -45,10 +61,19 @@ protected:
    Long64_t    fSeekKeys{0};             ///< Location of Keys record on file
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
+   Bool_t      fIncrementalKeys{kFALSE}; ///<! Flush the keys list as chained delta records
+   Bool_t      fKeysOnFileValid{kFALSE}; ///<! True if fKeysOnFile describes the keys records on file
+   std::vector<std::pair<Long64_t,Int_t>> fKeysChain; ///<! Location and size of the keys records on file, oldest first
+   std::unordered_map<Long64_t,TKeyOnFile> fKeysOnFile; ///<! Keys described by the keys records, by location
 
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
+   Int_t       ReadKeysEntries(char *&buffer, Int_t nkeys, Long64_t fsize, std::unordered_map<Long64_t,TKey*> *byseek);
+   void        WriteAllKeys(TFile *f);
+   Bool_t      WriteKeysDelta(TFile *f);
+   void        InsertKeyOnFile(const TKey &key);
+   void        SkipKeysDelta();
 
 private:
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
@@ -68,6 +93,7 @@ public:
           void        Build(TFile* motherFile = nullptr, TDirectory* motherDir = nullptr) override { BuildDirectoryFile(motherFile, motherDir); }
           TObject    *CloneObject(const TObject *obj, Bool_t autoadd = kTRUE) override;
           void        Close(Option_t *option="") override;
+          void        CompactKeys();
           void        Copy(TObject &) const override { MayNotUse("Copy(TObject &)"); }
           Bool_t      cd(const char *path = nullptr) override;
           void        Delete(const char *namecycle="") override;
@@ -85,6 +111,7 @@ public:
            void       *GetObjectChecked(const char *namecycle, const TClass* cl) override;
            void       *GetObjectUnchecked(const char *namecycle) override;
            Int_t       GetBufferSize() const override;
+           Bool_t      GetIncrementalKeys() const { return fIncrementalKeys; }
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
@@ -110,6 +137,7 @@ public:
            void        SaveSelf(Bool_t force = kFALSE) override;
            Int_t       SaveObjectAs(const TObject *obj, const char *filename="", Option_t *option="") const override;
            void        SetBufferSize(Int_t bufsize) override;
+           void        SetIncrementalKeys(Bool_t on = kTRUE);
            void        SetModified() override {fModified = kTRUE;}
            void        SetSeekDir(Long64_t v) override { fSeekDir = v; }
            void        SetWritable(Bool_t writable=kTRUE) override;
@@ -117,6 +145,8 @@ public:
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsize=0) override;
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsize=0) const override;
            Int_t       WriteTObject(const TObject *obj, const char *name=nullptr, Option_t *option="", Int_t bufsize=0) override;
+           Int_t       WriteMany(const std::vector<const TObject*> &objects, const std::vector<std::string> &names = {},
+                                 Option_t *option="", Int_t bufsize=0, Int_t nthreads=0);
            Int_t       WriteObjectAny(const void *obj, const char *classname, const char *name, Option_t *option="", Int_t bufsize=0) override;
            Int_t       WriteObjectAny(const void *obj, const TClass *cl, const char *name, Option_t *option="", Int_t bufsize=0) override;
            void        WriteDirHeader() override;
@@ -39,10 +39,10 @@ protected:
    void WriteItems(int nElements, TBuffer &b);
 
    // Shrink the container
-   void Shrink(UInt_t nCurr, UInt_t left, Bool_t force);
+   void Shrink(EnvironBase_t &env, UInt_t nCurr, UInt_t left, Bool_t force) const;
 
    // Expand the container
-   void Expand(UInt_t nCurr, UInt_t left);
+   void Expand(EnvironBase_t &env, UInt_t nCurr, UInt_t left) const;
 
 private:
    TEmulatedCollectionProxy &operator=(const TEmulatedCollectionProxy &); // Not implemented.
@@ -99,6 +99,14 @@ public:
    // Block commit of containees
    virtual void Commit(void* env);
 
+   // Reentrant interface, see TGenCollectionProxy.
+   virtual void  *At(EnvironBase_t &env, UInt_t idx) const;
+   virtual void   Clear(EnvironBase_t &env, const char *opt = "") const;
+   virtual void   Resize(EnvironBase_t &env, UInt_t n, Bool_t force_delete) const;
+   virtual UInt_t Size(EnvironBase_t &env) const;
+   virtual void  *Allocate(EnvironBase_t &env, UInt_t n, Bool_t forceDelete) const;
+   virtual void   Commit(EnvironBase_t &env, void *from) const;
+
    // Insert data into the container where data is a C-style array of the actual type contained in the collection
    // of the given size.   For associative container (map, etc.), the data type is the pair<key,value>.
    virtual void  Insert(const void *data, void *container, size_t size);
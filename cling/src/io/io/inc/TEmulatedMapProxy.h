@@ -47,6 +47,10 @@ public:
    // Return the current size of the container
    virtual UInt_t Size() const;
 
+   // Reentrant interface, see TGenCollectionProxy.
+   virtual void  *At(EnvironBase_t &env, UInt_t idx) const;
+   virtual UInt_t Size(EnvironBase_t &env) const;
+
    // Read portion of the streamer
    virtual void ReadBuffer(TBuffer &buff, void *pObj);
    virtual void ReadBuffer(TBuffer &buff, void *pObj, const TClass *onfile);
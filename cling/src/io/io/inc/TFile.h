@@ -21,6 +21,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <mutex>
 
 #include "Compression.h"
 #include "TDirectoryFile.h"
@@ -61,8 +62,8 @@ protected:
    Double_t         fSumBuffer{0};            ///<Sum of buffer sizes of objects written so far
    Double_t         fSum2Buffer{0};           ///<Sum of squares of buffer sizes of objects written so far
    Long64_t         fBytesWrite{0};           ///<Number of bytes written to this file
-   Long64_t         fBytesRead{0};            ///<Number of bytes read from this file
-   Long64_t         fBytesReadExtra{0};       ///<Number of extra bytes (overhead) read by the readahead buffer
+   std::atomic<Long64_t> fBytesRead{0};       ///<Number of bytes read from this file
+   std::atomic<Long64_t> fBytesReadExtra{0};  ///<Number of extra bytes (overhead) read by the readahead buffer
    Long64_t         fBEGIN{0};                ///<First used byte in file
    Long64_t         fEND{0};                  ///<Last used byte in file
    Long64_t         fSeekFree{0};             ///<Location on disk of free segments structure
@@ -74,7 +75,7 @@ protected:
    Int_t            fNbytesInfo{0};           ///<Number of bytes for StreamerInfo record
    Int_t            fWritten{0};              ///<Number of objects written so far
    Int_t            fNProcessIDs{0};          ///<Number of TProcessID written to this file
-   Int_t            fReadCalls{0};            ///<Number of read calls ( not counting the cache calls )
+   std::atomic<Int_t> fReadCalls{0};          ///<Number of read calls ( not counting the cache calls )
    TString          fRealName;                ///<Effective real file name (not original url)
    TString          fOption;                  ///<File options
    Char_t           fUnits{0};                ///<Number of bytes for file pointers
@@ -95,6 +96,7 @@ protected:
 
    TList           *fInfoCache{nullptr};      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases{nullptr};     ///<!Time info about open phases
+   std::recursive_mutex fWriteMutex;          ///<!Serializes file updates made while TDirectoryFile::WriteMany streams objects
 
    static TList    *fgAsyncOpenRequests; //List of handles for pending open requests
 
@@ -124,6 +126,7 @@ protected:
    virtual Int_t       SysOpen(const char *pathname, Int_t flags, UInt_t mode);
    virtual Int_t       SysClose(Int_t fd);
    virtual Int_t       SysRead(Int_t fd, void *buf, Int_t len);
+   virtual Int_t       SysReadAt(Int_t fd, void *buf, Int_t len, Long64_t offset);
    virtual Int_t       SysWrite(Int_t fd, const void *buf, Int_t len);
    virtual Long64_t    SysSeek(Int_t fd, Long64_t offset, Int_t whence);
    virtual Int_t       SysStat(Int_t fd, Long_t *id, Long64_t *size, Long_t *flags, Long_t *modtime);
@@ -172,6 +175,7 @@ public:
            Long64_t    GetArchiveOffset() const { return fArchiveOffset; }
            Int_t       GetBestBuffer() const;
            TArrayC    *GetClassIndex() const { return fClassIndex; }
+   std::recursive_mutex &GetWriteMutex() { return fWriteMutex; }
            Int_t       GetCompressionAlgorithm() const;
            Int_t       GetCompressionLevel() const;
            Int_t       GetCompressionSettings() const;
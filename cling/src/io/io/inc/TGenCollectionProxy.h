@@ -15,6 +15,7 @@
 #include "TBuffer.h"
 #include "TVirtualCollectionProxy.h"
 #include "TCollectionProxyInfo.h"
+#include "ROOT/TSpinMutex.hxx"
 
 #include <atomic>
 #include <string>
@@ -284,9 +285,12 @@ public:
       }
    };
 
-protected:
+   /// Iteration environment large enough for the iterator of any proxied collection.
+   /// It can be allocated on the stack by the callers of the reentrant interface.
    typedef CppyyLegacy::Detail::TCollectionProxyInfo::Environ<char[64]> Env_t;
    typedef CppyyLegacy::Detail::TCollectionProxyInfo::EnvironBase EnvironBase_t;
+
+protected:
    typedef std::vector<TStaging*>          Staged_t;  ///< Collection of pre-allocated staged array for associative containers.
    typedef std::vector<EnvironBase_t*>     Proxies_t;
    mutable TObjArray *fReadMemberWise;                                   ///< Array of bundle of TStreamerInfoActions to stream out (read)
@@ -317,7 +321,8 @@ protected:
    int           fValDiff;   ///< Offset between two consecutive value_types (memory layout).
    Proxies_t     fProxyList; ///< Stack of recursive proxies
    Proxies_t     fProxyKept; ///< Optimization: Keep proxies once they were created
-   Staged_t      fStaged;    ///< Optimization: Keep staged array once they were created
+   mutable Staged_t fStaged; ///< Optimization: Keep staged array once they were created
+   mutable TSpinMutex fStagedLock; ///< Protect fStaged, which is shared by all environments
    int           fSTL_type;  ///< STL container type
    Info_t        fTypeinfo;  ///< Type information
    TClass*       fOnFileClass; ///< On file class
@@ -336,6 +341,10 @@ protected:
    virtual void DeleteItem(Bool_t force, void* ptr) const;
    // Allow to check function pointers.
    void CheckFunctions()  const;
+   // Get a staging area for 'n' elements, reusing a kept one if possible.
+   TStaging *AcquireStaging(UInt_t n) const;
+   // Feed the staged content into its target collection and keep the staging area.
+   void CommitStaging(TStaging *s) const;
 
    // Set pointer to the TClass representing the content.
    virtual void UpdateValueClass(const TClass *oldcl, TClass *newcl);
@@ -412,6 +421,39 @@ public:
    // Block commit of containees.
    virtual void Commit(void* env);
 
+   // Reentrant interface: the iteration state is kept in the caller-owned
+   // environment 'env' (typically an Env_t on the stack) rather than in the
+   // proxy, so that nested and concurrent uses of one proxy do not need
+   // PushProxy/PopProxy.  Other state is still per proxy, so TClass keeps giving
+   // each thread its own copy (see TClass::GetCollectionProxy).
+
+   // Prepare the environment 'env' to proxy the collection at 'objstart'.
+   void InitEnv(EnvironBase_t &env, void *objstart) const;
+
+   // Return the address of the value at index 'idx'.
+   virtual void *At(EnvironBase_t &env, UInt_t idx) const;
+
+   // Clear the container.
+   virtual void Clear(EnvironBase_t &env, const char *opt = "") const;
+
+   // Resize the container.
+   virtual void Resize(EnvironBase_t &env, UInt_t n, Bool_t force_delete) const;
+
+   // Return the current size of the container.
+   virtual UInt_t Size(EnvironBase_t &env) const;
+
+   // Block allocation of containees.
+   virtual void* Allocate(EnvironBase_t &env, UInt_t n, Bool_t forceDelete) const;
+
+   // Block commit of containees.
+   virtual void Commit(EnvironBase_t &env, void *from) const;
+
+   // Position the iterator on the first element and return its address.
+   void *First(EnvironBase_t &env) const { return env.fStart = fFirst.invoke(&env); }
+
+   // Advance the iterator by env.fIdx elements and return the address of the element reached.
+   void *Next(EnvironBase_t &env) const { return fNext.invoke(&env); }
+
    // Streamer function.
    virtual void Streamer(TBuffer &refBuffer);
 
@@ -465,6 +507,46 @@ public:
 
 };
 
+/** @class TCollectionProxyEnv TGenCollectionProxy.h TGenCollectionProxy.h
+ *
+ * Caller-owned iteration environment for a collection.
+ *
+ * Drop-in replacement for TVirtualCollectionProxy::TPushPop for code that
+ * only needs Size, At, Clear, Allocate and Commit.  When the proxy supports
+ * the reentrant interface (TVirtualCollectionProxy::kIsReentrant) the state
+ * is kept in this object and the proxy is left untouched; otherwise it falls
+ * back to PushProxy/PopProxy.
+ */
+class TCollectionProxyEnv {
+   TVirtualCollectionProxy    *fProxy;    ///< Proxy of the collection.
+   TGenCollectionProxy        *fGenProxy; ///< Same as fProxy when it is reentrant, null otherwise.
+   TGenCollectionProxy::Env_t  fEnv;      ///< Iteration state used with fGenProxy.
+
+   TCollectionProxyEnv(const TCollectionProxyEnv&);            // Not implemented
+   TCollectionProxyEnv &operator=(const TCollectionProxyEnv&); // Not implemented
+
+public:
+   TCollectionProxyEnv(TVirtualCollectionProxy *proxy, void *objstart) : fProxy(proxy), fGenProxy(0)
+   {
+      if (proxy->GetProperties() & TVirtualCollectionProxy::kIsReentrant) {
+         fGenProxy = static_cast<TGenCollectionProxy*>(proxy);
+         fGenProxy->InitEnv(fEnv, objstart);
+      } else {
+         fProxy->PushProxy(objstart);
+      }
+   }
+   ~TCollectionProxyEnv()
+   {
+      if (!fGenProxy) fProxy->PopProxy();
+   }
+
+   UInt_t Size() { return fGenProxy ? fGenProxy->Size(fEnv) : fProxy->Size(); }
+   void  *At(UInt_t idx) { return fGenProxy ? fGenProxy->At(fEnv, idx) : fProxy->At(idx); }
+   void   Clear(const char *opt = "") { if (fGenProxy) fGenProxy->Clear(fEnv, opt); else fProxy->Clear(opt); }
+   void  *Allocate(UInt_t n, Bool_t forceDelete) { return fGenProxy ? fGenProxy->Allocate(fEnv, n, forceDelete) : fProxy->Allocate(n, forceDelete); }
+   void   Commit(void *from) { if (fGenProxy) fGenProxy->Commit(fEnv, from); else fProxy->Commit(from); }
+};
+
 template <typename T>
 struct AnyCollectionProxy : public TGenCollectionProxy  {
    AnyCollectionProxy()
@@ -22,13 +22,13 @@ class TGenCollectionStreamer : public TGenCollectionProxy {
 
 protected:
    void ReadMapHelper(StreamHelper *i, Value *v, Bool_t vsn3,  TBuffer &b);
-   void ReadMap(int nElements, TBuffer &b, const TClass *onfileClass);
-   void ReadPairFromMap(int nElements, TBuffer &b);
-   void ReadObjects(int nElements, TBuffer &b, const TClass *onfileClass);
-   void ReadPrimitives(int nElements, TBuffer &b, const TClass *onfileClass);
-   void WriteMap(int nElements, TBuffer &b);
-   void WriteObjects(int nElements, TBuffer &b);
-   void WritePrimitives(int nElements, TBuffer &b);
+   void ReadMap(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onfileClass);
+   void ReadPairFromMap(EnvironBase_t &env, int nElements, TBuffer &b);
+   void ReadObjects(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onfileClass);
+   void ReadPrimitives(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onfileClass);
+   void WriteMap(EnvironBase_t &env, int nElements, TBuffer &b);
+   void WriteObjects(EnvironBase_t &env, int nElements, TBuffer &b);
+   void WritePrimitives(EnvironBase_t &env, int nElements, TBuffer &b);
 
 //   typedef void (TGenCollectionStreamer::*ReadBufferConv_t)(TBuffer &b, void *obj, const TClass *onFileClass);
 //   ReadBufferConv_t fReadBufferConvFunc;
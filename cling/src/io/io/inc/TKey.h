@@ -52,6 +52,8 @@ protected:
    virtual Int_t    Read(const char *name) { return TObject::Read(name); }
    virtual void     Create(Int_t nbytes, TFile* f = 0);
            void     Build(TDirectory* motherDir, const char* classname, Long64_t filepos);
+           Int_t    CompressBuffer();
+           void     FinishBuffer(Int_t nbytes);
    virtual void     Reset(); // Currently only for the use of TBasket.
    virtual Int_t    WriteFileKeepBuffer(TFile *f = 0);
 
@@ -63,10 +65,12 @@ protected:
    TKey(const char *name, const char *title, const TClass *cl, Int_t nbytes, TDirectory* motherDir);
    TKey(const TString &name, const TString &title, const TClass *cl, Int_t nbytes, TDirectory* motherDir);
    TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* motherDir);
+   TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* motherDir, Long64_t filepos);
    TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, TDirectory* motherDir);
    TKey(Long64_t pointer, Int_t nbytes, TDirectory* motherDir = 0);
    virtual ~TKey();
 
+           Bool_t      Commit();
    virtual void        Delete(Option_t *option="");
    virtual void        DeleteBuffer();
    virtual void        FillBuffer(char *&buffer);
@@ -0,0 +1,53 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMakeProject
+#define ROOT_TMakeProject
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMakeProject                                                         //
+//                                                                      //
+// Helper functions for TFile::MakeProject: generate C++ declarations   //
+// for the classes of a file that are only known through their          //
+// TStreamerInfo (i.e. that are emulated).                              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace CppyyLegacy {
+
+class TList;
+class TStreamerInfo;
+
+class TMakeProject {
+
+public:
+   struct TClassDecl {
+      std::string    fName;        // Fully qualified class name
+      std::string    fForward;     // Forward declaration, wrapped in its namespaces
+      std::string    fDefinition;  // Class definition, wrapped in its namespaces
+      TStreamerInfo *fInfo;        // StreamerInfo the definition was generated from
+      std::vector<std::string> fHeaders; // Headers of the CppyyLegacy classes used by the definition
+   };
+
+   static std::vector<TClassDecl> GenerateDeclarations(const TList *infos, const char *classes = "*");
+   static std::string QualifyTypeName(const char *typeName, std::set<std::string> *headers = nullptr);
+};
+
+} // namespace CppyyLegacy
+
+#endif
@@ -15,6 +15,9 @@
 #include "TFile.h"
 #include <vector>
 #include <memory>
+#ifndef R__WIN32
+#include <sys/uio.h>
+#endif
 
 
 namespace CppyyLegacy {
@@ -47,19 +50,30 @@ protected:
       UChar_t   *fBuffer{nullptr};
       Long64_t   fSize{0};
    };
-   TMemBlock    fBlockList;               ///< Collection of memory blocks of size fgDefaultBlockSize
+   struct TBlockStart {
+      Long64_t   fStart;                  ///< Offset of the block in the file
+      TMemBlock *fBlock;
+   };
+
+   TMemBlock    fBlockList;               ///< Collection of memory blocks, growing geometrically from fDefaultBlockSize
    ExternalDataPtr_t fExternalData;       ///< shared file data / content
    Bool_t       fIsOwnedByROOT{kFALSE};   ///< if this is a C-style memory region
    Long64_t     fSize{0};                 ///< Total file size (sum of the size of the chunks)
    Long64_t     fSysOffset{0};            ///< Seek offset in file
    TMemBlock   *fBlockSeek{nullptr};      ///< Pointer to the block we seeked to.
    Long64_t     fBlockOffset{0};          ///< Seek offset within the block
+   std::vector<TBlockStart> fBlockIndex;  ///< Start of each block of fBlockList, for seeking; updated when blocks are added
 
    constexpr static Long64_t fgDefaultBlockSize = 2 * 1024 * 1024;
+   constexpr static Long64_t fgMaxBlockSize = 64 * 1024 * 1024;
    Long64_t fDefaultBlockSize = fgDefaultBlockSize;
 
    Bool_t IsExternalData() const { return !fIsOwnedByROOT; }
 
+   void       UpdateBlockIndex();
+   TMemBlock *FindBlock(Long64_t offset, Long64_t &blockStart) const;
+   Long64_t   NextBlockSize() const;
+
    Long64_t MemRead(Int_t fd, void *buf, Long64_t len) const;
 
    // Overload TFile interfaces.
@@ -68,6 +82,7 @@ protected:
    Int_t    SysReadImpl(Int_t fd, void *buf, Long64_t len);
    Int_t    SysWriteImpl(Int_t fd, const void *buf, Long64_t len);
    Int_t    SysRead(Int_t fd, void *buf, Int_t len) override;
+   Int_t    SysReadAt(Int_t fd, void *buf, Int_t len, Long64_t offset) override;
    Int_t    SysWrite(Int_t fd, const void *buf, Int_t len) override;
    Long64_t SysSeek(Int_t fd, Long64_t offset, Int_t whence) override;
    Int_t    SysStat(Int_t fd, Long_t *id, Long64_t *size, Long_t *flags, Long_t *modtime) override;
@@ -101,6 +116,10 @@ public:
 
    virtual Long64_t CopyTo(void *to, Long64_t maxsize) const;
    virtual void     CopyTo(TBuffer &tobuf) const;
+#ifndef R__WIN32
+   Long64_t GetBlocks(std::vector<iovec> &blocks) const;
+#endif
+   Bool_t   AdoptBlock(char *buffer, Long64_t size);
    Long64_t GetSize() const override;
 
    void ResetErrno() const override;
@@ -77,12 +77,19 @@ namespace TStreamerInfoActions {
          TStreamerInfoVecPtrLoopAction_t fVecPtrLoopAction;
          TStreamerInfoLoopAction_t       fLoopAction;
       };
+      union {
+         // Same as above but only called by TBufferFile::ApplySequence for a buffer that is
+         // exactly a TBufferFile; same as the generic action when there is no specialization.
+         TStreamerInfoAction_t           fFileAction;
+         TStreamerInfoVecPtrLoopAction_t fFileVecPtrLoopAction;
+         TStreamerInfoLoopAction_t       fFileLoopAction;
+      };
       TConfiguration              *fConfiguration;
    private:
       // assignment operator must be the default because the 'copy' constructor is actually a move constructor and must be used.
    public:
-      TConfiguredAction() : fAction(0), fConfiguration(0) {}
-      TConfiguredAction(const TConfiguredAction &rval) : TObject(rval), fAction(rval.fAction), fConfiguration(rval.fConfiguration)
+      TConfiguredAction() : fAction(0), fFileAction(0), fConfiguration(0) {}
+      TConfiguredAction(const TConfiguredAction &rval) : TObject(rval), fAction(rval.fAction), fFileAction(rval.fFileAction), fConfiguration(rval.fConfiguration)
       {
          // WARNING: Technically this is a move constructor ...
          const_cast<TConfiguredAction&>(rval).fConfiguration = 0;
@@ -94,22 +101,35 @@ namespace TStreamerInfoActions {
          TConfiguredAction tmp(rval); // this does a move.
          TObject::operator=(tmp);     // we are missing TObject::Swap
          std::swap(fAction,tmp.fAction);
+         std::swap(fFileAction,tmp.fFileAction);
          std::swap(fConfiguration,tmp.fConfiguration);
          return *this;
       };
 
-      TConfiguredAction(TStreamerInfoAction_t action, TConfiguration *conf) : fAction(action), fConfiguration(conf)
+      TConfiguredAction(TStreamerInfoAction_t action, TConfiguration *conf) : fAction(action), fFileAction(action), fConfiguration(conf)
       {
          // Usual constructor.
       }
-      TConfiguredAction(TStreamerInfoVecPtrLoopAction_t action, TConfiguration *conf) : fVecPtrLoopAction(action), fConfiguration(conf)
+      TConfiguredAction(TStreamerInfoVecPtrLoopAction_t action, TConfiguration *conf) : fVecPtrLoopAction(action), fFileVecPtrLoopAction(action), fConfiguration(conf)
       {
          // Usual constructor.
       }
-      TConfiguredAction(TStreamerInfoLoopAction_t action, TConfiguration *conf) : fLoopAction(action), fConfiguration(conf)
+      TConfiguredAction(TStreamerInfoLoopAction_t action, TConfiguration *conf) : fLoopAction(action), fFileLoopAction(action), fConfiguration(conf)
       {
          // Usual constructor.
       }
+      TConfiguredAction(TStreamerInfoAction_t action, TStreamerInfoAction_t fileAction, TConfiguration *conf) : fAction(action), fFileAction(fileAction), fConfiguration(conf)
+      {
+         // Constructor with a version of the action specialized for TBufferFile.
+      }
+      TConfiguredAction(TStreamerInfoVecPtrLoopAction_t action, TStreamerInfoVecPtrLoopAction_t fileAction, TConfiguration *conf) : fVecPtrLoopAction(action), fFileVecPtrLoopAction(fileAction), fConfiguration(conf)
+      {
+         // Constructor with a version of the action specialized for TBufferFile.
+      }
+      TConfiguredAction(TStreamerInfoLoopAction_t action, TStreamerInfoLoopAction_t fileAction, TConfiguration *conf) : fLoopAction(action), fFileLoopAction(fileAction), fConfiguration(conf)
+      {
+         // Constructor with a version of the action specialized for TBufferFile.
+      }
       ~TConfiguredAction() {
          // Usual destructor.
          // Idea: the configuration ownership might be moved to a single list so that
@@ -129,6 +149,20 @@ namespace TStreamerInfoActions {
          return fLoopAction(buffer, start_collection, end_collection, loopconf, fConfiguration);
       }
 
+      // Same as the operator() but using the TBufferFile specialization of the action;
+      // buffer must be exactly a TBufferFile (not a derived class).
+      inline Int_t ApplyTBufferFile(TBuffer &buffer, void *object) const {
+         return fFileAction(buffer, object, fConfiguration);
+      }
+
+      inline Int_t ApplyTBufferFile(TBuffer &buffer, void *start_collection, const void *end_collection) const {
+         return fFileVecPtrLoopAction(buffer, start_collection, end_collection, fConfiguration);
+      }
+
+      inline Int_t ApplyTBufferFile(TBuffer &buffer, void *start_collection, const void *end_collection, const TLoopConfiguration *loopconf) const {
+         return fFileLoopAction(buffer, start_collection, end_collection, loopconf, fConfiguration);
+      }
+
       ClassDef(TConfiguredAction,0); // A configured action
    };
 
@@ -182,6 +216,10 @@ namespace TStreamerInfoActions {
       void AddAction( action_t action, TConfiguration *conf ) {
          fActions.push_back( TConfiguredAction(action, conf) );
       }
+      template <typename action_t>
+      void AddAction( action_t action, action_t fileAction, TConfiguration *conf ) {
+         fActions.push_back( TConfiguredAction(action, fileAction, conf) );
+      }
       void AddAction(const TConfiguredAction &action ) {
          fActions.push_back( action );
       }
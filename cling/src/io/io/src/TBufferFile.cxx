@@ -280,6 +280,82 @@ void TBufferFile::WriteStdString(const std::string *obj)
    WriteFastArray(obj->data(),nbig);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read n std::string, the i-th one being at (char*)s + i*stride.
+///
+/// All the length prefixes are decoded (and checked against the end of the
+/// buffer) in a first pass; the strings are then assigned straight from the
+/// buffer, without going through the per element virtual calls.
+
+void TBufferFile::ReadStdStrings(std::string *s, Int_t n, size_t stride)
+{
+   if (n <= 0) return;
+
+   char *cur = fBufCur;
+   for (Int_t i = 0; i < n; ++i) {
+      if (cur >= fBufMax) {
+         Error("ReadStdStrings", "reading past the end of the buffer (string %d of %d)", i, n);
+         return;
+      }
+      Int_t nbig = (UChar_t)*cur++;
+      if (nbig == 255) {
+         if (fBufMax - cur < (Long_t)sizeof(Int_t)) {
+            Error("ReadStdStrings", "reading past the end of the buffer (string %d of %d)", i, n);
+            return;
+         }
+         frombuf(cur, &nbig);
+      }
+      if (nbig < 0 || nbig > fBufMax - cur) {
+         Error("ReadStdStrings", "invalid length %d for string %d of %d", nbig, i, n);
+         return;
+      }
+      cur += nbig;
+   }
+
+   for (Int_t i = 0; i < n; ++i) {
+      Int_t nbig = (UChar_t)*fBufCur++;
+      if (nbig == 255)
+         frombuf(fBufCur, &nbig);
+      ((std::string*)((char*)s + i*stride))->assign(fBufCur, nbig);
+      fBufCur += nbig;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write n std::string, the i-th one being at (char*)s + i*stride.
+///
+/// The buffer is expanded once for the whole block, which is then filled
+/// in place.
+
+void TBufferFile::WriteStdStrings(const std::string *s, Int_t n, size_t stride)
+{
+   if (n <= 0) return;
+
+   Long64_t total = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      Long64_t len = ((const std::string*)((const char*)s + i*stride))->length();
+      total += len + (len > 254 ? 1 + sizeof(Int_t) : 1);
+   }
+   if (total > kMaxInt - fBufSize) {
+      Error("WriteStdStrings", "the %d strings (%lld bytes) do not fit in the buffer", n, total);
+      return;
+   }
+   if (fBufCur + total > fBufMax) AutoExpand(fBufSize + (Int_t)total);
+
+   for (Int_t i = 0; i < n; ++i) {
+      const std::string *str = (const std::string*)((const char*)s + i*stride);
+      Int_t nbig = str->length();
+      if (nbig > 254) {
+         *fBufCur++ = (char)255;
+         tobuf(fBufCur, nbig);
+      } else {
+         *fBufCur++ = (char)nbig;
+      }
+      memcpy(fBufCur, str->data(), nbig);
+      fBufCur += nbig;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read char* from TBuffer.
 
@@ -3517,6 +3593,16 @@ Int_t TBufferFile::WriteClassBuffer(const TClass *cl, void *pointer)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if this buffer is a TBufferFile and not an instance of a class
+/// deriving from it; only then can the actions specialized for TBufferFile
+/// (which bypass the virtual interface) be used.
+
+inline Bool_t TBufferFile::IsExactTBufferFile() const
+{
+   return typeid(*this) == typeid(TBufferFile);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read one collection of objects from the buffer using the StreamerInfoLoopAction.
 
@@ -3524,6 +3610,14 @@ Int_t TBufferFile::ApplySequence(const TStreamerInfoActions::TActionSequence &se
 {
    //loop on all active members
    TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
+   if (IsExactTBufferFile()) {
+      for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
+          iter != end;
+          ++iter) {
+         iter->ApplyTBufferFile(*this,obj);
+      }
+      return 0;
+   }
    for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
        iter != end;
        ++iter) {
@@ -3540,6 +3634,14 @@ Int_t TBufferFile::ApplySequenceVecPtr(const TStreamerInfoActions::TActionSequen
 {
    //loop on all active members
    TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
+   if (IsExactTBufferFile()) {
+      for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
+          iter != end;
+          ++iter) {
+         iter->ApplyTBufferFile(*this,start_collection,end_collection);
+      }
+      return 0;
+   }
    for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
        iter != end;
        ++iter) {
@@ -3557,6 +3659,14 @@ Int_t TBufferFile::ApplySequence(const TStreamerInfoActions::TActionSequence &se
    TStreamerInfoActions::TLoopConfiguration *loopconfig = sequence.fLoopConfig;
    //loop on all active members
    TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
+   if (IsExactTBufferFile()) {
+      for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
+          iter != end;
+          ++iter) {
+         iter->ApplyTBufferFile(*this,start_collection,end_collection,loopconfig);
+      }
+      return 0;
+   }
    for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
        iter != end;
        ++iter) {
@@ -344,6 +344,9 @@ void TBufferIO::TagStreamerInfo(TVirtualStreamerInfo *info)
                nindex, file->GetName());
          return;
       }
+      // Objects may be streamed concurrently by TDirectoryFile::WriteMany,
+      // so the index is only read and written under the lock.
+      std::lock_guard<std::recursive_mutex> lock(file->GetWriteMutex());
       if (cindex->fArray[number] == 0) {
          cindex->fArray[0] = 1;
          cindex->fArray[number] = 1;
@@ -44,6 +44,11 @@ End_Macro
 #include "TProcessUUID.h"
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
+#include "TVirtualRWMutex.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 
 ClassImp(CppyyLegacy::TDirectoryFile);
@@ -52,6 +57,8 @@ namespace CppyyLegacy {
 
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
+const Int_t  kKeysDelta = -1;        // nkeys value marking a delta keys record
+const size_t kMaxKeysChain = 256;    // Longest chain of keys records before compaction
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default TDirectoryFile constructor
@@ -271,6 +278,7 @@ void TDirectoryFile::BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir
    fList->UseRWLock();
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
+   fIncrementalKeys = fFile && fFile->GetIncrementalKeys();
    SetBit(kCanDelete);
 }
 
@@ -469,8 +477,11 @@ void TDirectoryFile::Close(Option_t *option)
       return;
    }
 
-   // Save the directory key list and header
+   // Save the directory key list and header; the keys records are compacted
+   // right after, so there is no point in appending delta records first.
+   SkipKeysDelta();
    Save();
+   CompactKeys();
 
    Bool_t nodelete = option ? (!strcmp(option, "nodelete") ? kTRUE : kFALSE) : kFALSE;
 
@@ -500,6 +511,49 @@ void TDirectoryFile::Close(Option_t *option)
    TDirectoryFile::CleanTargets();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the chain of delta keys records left by incremental flushes (see
+/// SetIncrementalKeys) with a single full record, in this directory and in
+/// all its subdirectories in memory. Called by Close, so that files written
+/// incrementally can be read by versions that do not know about delta records.
+
+void TDirectoryFile::CompactKeys()
+{
+   if (fList) {
+      TObject *idcur;
+      TIter    next(fList);
+      while ((idcur = next())) {
+         if (idcur->InheritsFrom(TDirectoryFile::Class())) {
+            ((TDirectoryFile*)idcur)->CompactKeys();
+         }
+      }
+   }
+
+   if (!IsWritable() || !fFile || !fFile->IsBinary() || fKeysChain.size() < 2) return;
+
+   TDirectory::TContext ctxt(this);
+   WriteAllKeys(fFile);
+   WriteDirHeader();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make the next WriteKeys of this directory and of all its subdirectories in
+/// memory write a full keys record, e.g. because CompactKeys follows.
+
+void TDirectoryFile::SkipKeysDelta()
+{
+   if (fList) {
+      TObject *idcur;
+      TIter    next(fList);
+      while ((idcur = next())) {
+         if (idcur->InheritsFrom(TDirectoryFile::Class())) {
+            ((TDirectoryFile*)idcur)->SkipKeysDelta();
+         }
+      }
+   }
+   fKeysOnFileValid = kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete Objects or/and keys in a directory
 ///
@@ -1178,37 +1232,126 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
+   fKeysChain.clear();
+   fKeysOnFile.clear();
+   fKeysOnFileValid = kFALSE;
    if ( fSeekKeys >  0) {
-      TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
-      headerkey->ReadFile();
-      buffer = headerkey->GetBuffer();
-      headerkey->ReadKeyBuffer(buffer);
-
-      TKey *key;
-      frombuf(buffer, &nkeys);
-      for (Int_t i = 0; i < nkeys; i++) {
-         key = new TKey(this);
-         key->ReadKeyBuffer(buffer);
-         if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
+      // Collect the chain of keys records, newest first; a classic record
+      // (nkeys >= 0) is always the oldest one.
+      struct KeysRecord_t { TKey *fHeader; char *fBuffer; Long64_t fSeek; Int_t fNbytes; };
+      std::vector<KeysRecord_t> records;
+      Long64_t seekkeys = fSeekKeys;
+      Int_t nbyteskeys  = fNbytesKeys;
+      while (seekkeys > 0) {
+         TKey *headerkey    = new TKey(seekkeys, nbyteskeys, this);
+         headerkey->ReadFile();
+         buffer = headerkey->GetBuffer();
+         headerkey->ReadKeyBuffer(buffer);
+         records.push_back({headerkey, buffer, seekkeys, nbyteskeys});
+
+         Int_t marker;
+         frombuf(buffer, &marker);
+         if (marker != kKeysDelta) break;
+         frombuf(buffer, &seekkeys);
+         frombuf(buffer, &nbyteskeys);
+         if (seekkeys < 0 || (seekkeys > 0 && seekkeys < 64) || seekkeys > fsize || records.size() > kMaxKeysChain) {
+            Error("ReadKeys","reading illegal keys record chain, using the last %d records", (Int_t)records.size());
             break;
          }
-         if (key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
+      }
+
+      // Replay the records, oldest first.
+      std::unordered_map<Long64_t,TKey*> byseek;
+      Bool_t chained = records.size() > 1;
+      for (auto rec = records.rbegin(); rec != records.rend(); ++rec) {
+         buffer = rec->fBuffer;
+         Int_t marker;
+         frombuf(buffer, &marker);
+         if (marker != kKeysDelta) {
+            nkeys = ReadKeysEntries(buffer, marker, fsize, chained ? &byseek : nullptr);
+         } else {
+            Long64_t seekprev;
+            Int_t nbytesprev, nadded, nremoved;
+            frombuf(buffer, &seekprev);
+            frombuf(buffer, &nbytesprev);
+            // Removals come first: a removed key may have been rewritten
+            // at the same location and be listed again as added.
+            frombuf(buffer, &nremoved);
+            for (Int_t i = 0; i < nremoved; i++) {
+               Long64_t seekkey;
+               frombuf(buffer, &seekkey);
+               auto iter = byseek.find(seekkey);
+               if (iter == byseek.end()) continue;
+               fKeys->Remove(iter->second);
+               delete iter->second;
+               byseek.erase(iter);
+               nkeys--;
+            }
+            frombuf(buffer, &nadded);
+            nkeys += ReadKeysEntries(buffer, nadded, fsize, &byseek);
          }
-         fKeys->Add(key);
+         fKeysChain.emplace_back(rec->fSeek, rec->fNbytes);
+         delete rec->fHeader;
+      }
+
+      if (fIncrementalKeys) {
+         TIter next(fKeys);
+         TKey *key;
+         while ((key = (TKey*)next()))
+            InsertKeyOnFile(*key);
+         fKeysOnFileValid = kTRUE;
       }
-      delete headerkey;
    }
 
    return nkeys;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if key is the key described by this entry of fKeysOnFile.
+
+Bool_t TDirectoryFile::TKeyOnFile::Matches(const TKey &key) const
+{
+   return fNbytes == key.GetNbytes() && fCycle == key.GetCycle()
+       && fDatime == key.GetDatime().Get() && fName == key.GetName();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record key as described by the keys records on file.
+
+void TDirectoryFile::InsertKeyOnFile(const TKey &key)
+{
+   fKeysOnFile[key.GetSeekKey()] = {key.GetNbytes(), key.GetCycle(), key.GetDatime().Get(), key.GetName()};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read nkeys key descriptions from buffer and add them to the list of keys.
+///
+/// If byseek is not null, the keys are also indexed by their location so that
+/// later delta records can remove them. Returns the number of keys read; it
+/// is less than nkeys if an illegal key was found.
+
+Int_t TDirectoryFile::ReadKeysEntries(char *&buffer, Int_t nkeys, Long64_t fsize, std::unordered_map<Long64_t,TKey*> *byseek)
+{
+   TKey *key;
+   for (Int_t i = 0; i < nkeys; i++) {
+      key = new TKey(this);
+      key->ReadKeyBuffer(buffer);
+      if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
+         Error("ReadKeys","reading illegal key, exiting after %d keys",i);
+         fKeys->Remove(key);
+         return i;
+      }
+      if (key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
+         Error("ReadKeys","reading illegal key, exiting after %d keys",i);
+         fKeys->Remove(key);
+         return i;
+      }
+      fKeys->Add(key);
+      if (byseek) (*byseek)[key->GetSeekKey()] = key;
+   }
+   return nkeys;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
@@ -1260,7 +1403,7 @@ void TDirectoryFile::Save()
 
    // recursively save all sub-directories
    if (fList && fList->FirstLink()) {
-      auto lnk = fList->FirstLink()->shared_from_this();
+      TObjLinkPtr lnk(fList->FirstLink());
       while (lnk) {
          TObject *idcur = lnk->GetObject();
          if (idcur && idcur->InheritsFrom(TDirectoryFile::Class())) {
@@ -1344,6 +1487,33 @@ void TDirectoryFile::SetBufferSize(Int_t bufsize)
    fBufferSize = bufsize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the list of keys incrementally, recursively for all subdirectories.
+///
+/// When on, each WriteKeys (e.g. from SaveSelf) appends a small record with
+/// the keys added and removed since the previous flush instead of rewriting
+/// the full list; see WriteKeys for the format. Subdirectories created or
+/// read later inherit the setting of their file. Files are compacted to the
+/// classic format on Close, but a file that is not closed properly may hold
+/// a chain that only this version can read.
+
+void TDirectoryFile::SetIncrementalKeys(Bool_t on)
+{
+   fIncrementalKeys = on;
+   fKeysOnFile.clear();
+   fKeysOnFileValid = kFALSE;
+
+   if (fList) {
+      TObject *idcur;
+      TIter    next(fList);
+      while ((idcur = next())) {
+         if (idcur->InheritsFrom(TDirectoryFile::Class())) {
+            ((TDirectoryFile*)idcur)->SetIncrementalKeys(on);
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  Set the new value of fWritable recursively
 
@@ -1655,6 +1825,150 @@ Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write a set of objects in this directory.
+///
+/// The result is the same as calling WriteTObject(objects[i], names[i],
+/// option, bufsize) for each object in turn (an empty or missing name means
+/// the object name), and the layout of the file only depends on the order
+/// of the objects. However, the objects are streamed and compressed on
+/// nthreads worker threads (0 means one per core), each into its own buffer,
+/// while the calling thread allocates the file space and writes the finished
+/// records in order as they become available.
+///
+/// The objects must not be modified while WriteMany runs. The work is done
+/// serially if thread safety has not been enabled, for a single object or
+/// for non binary files. Returns the total number of bytes written, or 0 in
+/// case of error.
+
+Int_t TDirectoryFile::WriteMany(const std::vector<const TObject*> &objects, const std::vector<std::string> &names,
+                                Option_t *option, Int_t bufsize, Int_t nthreads)
+{
+   TDirectory::TContext ctxt(this);
+
+   if (!names.empty() && names.size() != objects.size()) {
+      Error("WriteMany", "%d names were given for %d objects", (Int_t)names.size(), (Int_t)objects.size());
+      return 0;
+   }
+
+   const size_t n = objects.size();
+   if (nthreads <= 0) nthreads = std::thread::hardware_concurrency();
+   if ((size_t)nthreads > n) nthreads = n;
+   if (!gCoreMutex) nthreads = 1;   // Thread safety is not enabled.
+
+   if (nthreads <= 1 || !fFile || !fFile->IsWritable() || !fFile->IsBinary()) {
+      Int_t nbytes = 0;
+      for (size_t i = 0; i < n; ++i) {
+         const char *name = names.empty() || names[i].empty() ? nullptr : names[i].c_str();
+         Int_t nb = WriteTObject(objects[i], name, option, bufsize);
+         if (fFile && fFile->TestBit(TFile::kWriteError)) return 0;
+         nbytes += nb;
+      }
+      return nbytes;
+   }
+
+   TString opt = option;
+   opt.ToLower();
+   Int_t bsize = bufsize > 0 ? bufsize : GetBufferSize();
+
+   // Key names as WriteTObject would use them (without trailing blanks).
+   std::vector<std::string> keynames(n);
+   for (size_t i = 0; i < n; ++i) {
+      if (!objects[i]) continue;
+      keynames[i] = names.empty() || names[i].empty() ? objects[i]->GetName() : names[i];
+      keynames[i].erase(keynames[i].find_last_not_of(' ') + 1);
+   }
+
+   // Workers prepare (stream and compress) the keys in order, staying at most
+   // 'window' keys ahead of the writer to bound the memory held in buffers.
+   const Long64_t filepos = fFile->GetEND();
+   const size_t window = 4 * nthreads;
+   std::vector<TKey*> keys(n, nullptr);
+   std::vector<char> ready(n, 0);
+   size_t next = 0, written = 0;
+   std::mutex mutex;
+   std::condition_variable cond;
+
+   auto prepare = [&]() {
+      TDirectory::TContext wctxt(this);
+      while (true) {
+         size_t i;
+         {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&] { return next >= n || next < written + window; });
+            if (next >= n) return;
+            i = next++;
+         }
+         TKey *key = objects[i] ? new TKey(objects[i], keynames[i].c_str(), bsize, this, filepos) : nullptr;
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            keys[i] = key;
+            ready[i] = 1;
+         }
+         cond.notify_all();
+      }
+   };
+   std::vector<std::thread> workers;
+   for (Int_t t = 0; t < nthreads; ++t)
+      workers.emplace_back(prepare);
+
+   Int_t nbytes = 0;
+   Bool_t failed = kFALSE;
+   for (size_t i = 0; i < n; ++i) {
+      TKey *key;
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         cond.wait(lock, [&] { return ready[i] != 0; });
+         key = keys[i];
+      }
+
+      if (key && !failed) {
+         std::lock_guard<std::recursive_mutex> flock(fFile->GetWriteMutex());
+         const char *oname = keynames[i].c_str();
+         if (opt.Contains("overwrite")) {
+            TKey *oldkey = GetKey(oname);
+            if (oldkey) {
+               oldkey->Delete();
+               delete oldkey;
+            }
+         }
+         TKey *oldkey = opt.Contains("writedelete") ? GetKey(oname) : nullptr;
+         if (!key->Commit()) {
+            // The file crossed TFile::kStartBigFile: redo this one with a big key.
+            delete key;
+            key = fFile->CreateKey(this, objects[i], oname, bsize);
+         }
+         if (!key->GetSeekKey()) {
+            fKeys->Remove(key);
+            delete key;
+         } else {
+            fFile->SumBuffer(key->GetObjlen());
+            nbytes += key->WriteFile(0);
+            if (fFile->TestBit(TFile::kWriteError)) {
+               failed = kTRUE;
+            } else if (oldkey) {
+               oldkey->Delete();
+               delete oldkey;
+            }
+         }
+      } else {
+         delete key;
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         written = i + 1;
+      }
+      cond.notify_all();
+   }
+
+   for (auto &worker : workers)
+      worker.join();
+
+   if (bufsize) fFile->SetBufferSize(bufsize);
+   return failed ? 0 : nbytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write object from pointer of class classname in this directory.
 ///
@@ -1821,7 +2135,18 @@ void TDirectoryFile::WriteDirHeader()
 ////////////////////////////////////////////////////////////////////////////////
 /// Write Keys linked list on the file.
 ///
-///  The linked list of keys (fKeys) is written as a single data record
+///  The linked list of keys (fKeys) is written as a single data record.
+///
+///  With SetIncrementalKeys, a directory that already has a keys record on
+///  file only appends a delta record listing the keys added and removed
+///  since the previous flush, so that frequent SaveSelf calls on a directory
+///  with many keys do not rewrite (and leave behind) the full list each time.
+///  A delta record starts with nkeys = -1 followed by the location and size
+///  of the previous record, the locations of the removed keys and the added
+///  keys. ReadKeys follows the chain back to the full record. The chain is
+///  replaced by a single full record once it grows too long and when the
+///  directory is closed (see CompactKeys), so closed files remain readable
+///  by older versions.
 
 void TDirectoryFile::WriteKeys()
 {
@@ -1833,10 +2158,31 @@ void TDirectoryFile::WriteKeys()
       return;
    }
 
+   if (fIncrementalKeys && fKeysOnFileValid && fSeekKeys != 0 && WriteKeysDelta(f))
+      return;
+
+   WriteAllKeys(f);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the full list of keys as a single record, releasing the previous
+/// record (or chain of records).
+
+void TDirectoryFile::WriteAllKeys(TFile *f)
+{
 //*-* Delete the old keys structure if it exists
-   if (fSeekKeys != 0) {
-      f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
+   if (fKeysChain.empty() || fKeysChain.back().first != fSeekKeys) {
+      if (fSeekKeys != 0) {
+         f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
+      }
+   } else {
+      for (auto &rec : fKeysChain)
+         f->MakeFree(rec.first, rec.first + rec.second -1);
    }
+   fKeysChain.clear();
+   fKeysOnFile.clear();
+   fKeysOnFileValid = kFALSE;
+
 //*-* Write new keys record
    TIter next(fKeys);
    TKey *key;
@@ -1856,12 +2202,95 @@ void TDirectoryFile::WriteKeys()
    tobuf(buffer, nkeys);
    while ((key = (TKey*)next())) {
       key->FillBuffer(buffer);
+      if (fIncrementalKeys) InsertKeyOnFile(*key);
+   }
+
+   fSeekKeys     = headerkey->GetSeekKey();
+   fNbytesKeys   = headerkey->GetNbytes();
+   fKeysChain.emplace_back(fSeekKeys, fNbytesKeys);
+   fKeysOnFileValid = fIncrementalKeys;
+   headerkey->WriteFile();
+   delete headerkey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append a delta record with the keys added and removed since the last
+/// keys record. Returns kFALSE if a full record should be written instead,
+/// i.e. when the chain has become too long or too large to read back cheaply,
+/// or when the delta record could not be allocated.
+///
+/// A key is identified by its location, size, cycle, date and name: a key
+/// deleted and rewritten in the same free slot (e.g. with kOverwrite) is
+/// listed both as removed and as added.
+
+Bool_t TDirectoryFile::WriteKeysDelta(TFile *f)
+{
+   std::vector<TKey*> added;
+   std::vector<Long64_t> removed;
+   size_t present = 0;
+   Int_t nbytesAll = 0;
+   TIter next(fKeys);
+   TKey *key;
+   while ((key = (TKey*)next())) {
+      nbytesAll += key->Sizeof();
+      auto iter = fKeysOnFile.find(key->GetSeekKey());
+      if (iter != fKeysOnFile.end()) {
+         ++present;
+         if (iter->second.Matches(*key)) continue;
+         removed.push_back(iter->first);
+      }
+      added.push_back(key);
+   }
+   if (present < fKeysOnFile.size()) {
+      std::unordered_set<Long64_t> current;
+      current.reserve(fKeys->GetSize());
+      next.Reset();
+      while ((key = (TKey*)next()))
+         current.insert(key->GetSeekKey());
+      for (auto &entry : fKeysOnFile)
+         if (!current.count(entry.first)) removed.push_back(entry.first);
+   }
+   if (added.empty() && removed.empty())
+      return kTRUE;
+
+   Int_t nbytes = sizeof(Int_t) + sizeof(Long64_t) + sizeof(Int_t)   // marker, previous record
+                + sizeof(Int_t) + sizeof(Int_t)                      // nadded, nremoved
+                + removed.size() * sizeof(Long64_t);
+   for (TKey *k : added)
+      nbytes += k->Sizeof();
+
+   Long64_t nbytesChain = nbytes;
+   for (auto &rec : fKeysChain)
+      nbytesChain += rec.second;
+   if (fKeysChain.size() >= kMaxKeysChain || nbytesChain > 2 * (Long64_t)nbytesAll)
+      return kFALSE;
+
+   TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
+   if (headerkey->GetSeekKey() == 0) {
+      delete headerkey;
+      return kFALSE;
+   }
+   char *buffer = headerkey->GetBuffer();
+   tobuf(buffer, kKeysDelta);
+   tobuf(buffer, fSeekKeys);
+   tobuf(buffer, fNbytesKeys);
+   tobuf(buffer, (Int_t)removed.size());
+   for (Long64_t seekkey : removed) {
+      tobuf(buffer, seekkey);
+      fKeysOnFile.erase(seekkey);
+   }
+   tobuf(buffer, (Int_t)added.size());
+   for (TKey *k : added) {
+      k->FillBuffer(buffer);
+      InsertKeyOnFile(*k);
    }
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
+   fKeysChain.emplace_back(fSeekKeys, fNbytesKeys);
    headerkey->WriteFile();
    delete headerkey;
+   return kTRUE;
 }
 
 } // namespace CppyyLegacy
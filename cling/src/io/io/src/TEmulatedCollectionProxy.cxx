@@ -85,12 +85,12 @@ void TEmulatedCollectionProxy::Destructor(void* p, Bool_t dtorOnly) const
    // Virtual destructor
 
    if (!p) return;
-   if (!fEnv || fEnv->fObject != p) { // Envoid the cost of TPushPop if we don't need it
-      // FIXME: This is not thread safe.
-      TVirtualCollectionProxy::TPushPop env(const_cast<TEmulatedCollectionProxy*>(this), p);
-      const_cast<TEmulatedCollectionProxy*>(this)->Clear("force");
-   } else {
-      const_cast<TEmulatedCollectionProxy*>(this)->Clear("force");
+   {
+      // Use our own environment rather than PushProxy so that destroying a
+      // nested collection does not disturb an iteration in progress.
+      Env_t env;
+      InitEnv(env, p);
+      Clear(env, "force");
    }
    if (dtorOnly) {
       ((Cont_t*)p)->~Cont_t();
@@ -219,7 +219,18 @@ UInt_t TEmulatedCollectionProxy::Size() const
    // Return the current size of the container
 
    if ( fEnv && fEnv->fObject )   {
-      return fEnv->fSize = PCont_t(fEnv->fObject)->size()/fValDiff;
+      return Size(*fEnv);
+   }
+   Fatal("TEmulatedCollectionProxy","Size> Logic error - no proxy object set.");
+   return 0;
+}
+
+UInt_t TEmulatedCollectionProxy::Size(EnvironBase_t &env) const
+{
+   // Return the current size of the container proxied by 'env'
+
+   if ( env.fObject )   {
+      return env.fSize = PCont_t(env.fObject)->size()/fValDiff;
    }
    Fatal("TEmulatedCollectionProxy","Size> Logic error - no proxy object set.");
    return 0;
@@ -231,19 +242,25 @@ void TEmulatedCollectionProxy::Clear(const char* opt)
    Resize(0, opt && *opt=='f');
 }
 
-void TEmulatedCollectionProxy::Shrink(UInt_t nCurr, UInt_t left, Bool_t force )
+void TEmulatedCollectionProxy::Clear(EnvironBase_t &env, const char* opt) const
+{
+   // Clear the emulated collection proxied by 'env'.
+   Resize(env, 0, opt && *opt=='f');
+}
+
+void TEmulatedCollectionProxy::Shrink(EnvironBase_t &env, UInt_t nCurr, UInt_t left, Bool_t force ) const
 {
    // Shrink the container
 
    typedef std::string  String_t;
-   PCont_t c   = PCont_t(fEnv->fObject);
-   char* addr  = ((char*)fEnv->fStart) + fValDiff*left;
+   PCont_t c   = PCont_t(env.fObject);
+   char* addr  = ((char*)env.fStart) + fValDiff*left;
    size_t i;
 
    switch ( fSTL_type )  {
       case CppyyLegacy::kSTLmap:
       case CppyyLegacy::kSTLmultimap:
-         addr = ((char*)fEnv->fStart) + fValDiff*left;
+         addr = ((char*)env.fStart) + fValDiff*left;
          switch(fKey->fCase)  {
             case kIsFundamental:  // Only handle primitives this way
             case kIsEnum:
@@ -286,7 +303,7 @@ void TEmulatedCollectionProxy::Shrink(UInt_t nCurr, UInt_t left, Bool_t force )
                }
                break;
          }
-         addr = ((char*)fEnv->fStart)+fValOffset+fValDiff*left;
+         addr = ((char*)env.fStart)+fValOffset+fValDiff*left;
          // DO NOT break; just continue
 
          // General case for all values
@@ -332,20 +349,20 @@ void TEmulatedCollectionProxy::Shrink(UInt_t nCurr, UInt_t left, Bool_t force )
          }
    }
    c->resize(left*fValDiff,0);
-   fEnv->fStart = left>0 ? &(*c->begin()) : 0;
+   env.fStart = left>0 ? &(*c->begin()) : 0;
    return;
 }
 
-void TEmulatedCollectionProxy::Expand(UInt_t nCurr, UInt_t left)
+void TEmulatedCollectionProxy::Expand(EnvironBase_t &env, UInt_t nCurr, UInt_t left) const
 {
    // Expand the container
    size_t i;
-   PCont_t c   = PCont_t(fEnv->fObject);
+   PCont_t c   = PCont_t(env.fObject);
    c->resize(left*fValDiff,0);
-   void *oldstart = fEnv->fStart;
-   fEnv->fStart = left>0 ? &(*c->begin()) : 0;
+   void *oldstart = env.fStart;
+   env.fStart = left>0 ? &(*c->begin()) : 0;
 
-   char* addr = ((char*)fEnv->fStart) + fValDiff*nCurr;
+   char* addr = ((char*)env.fStart) + fValDiff*nCurr;
    switch ( fSTL_type )  {
       case CppyyLegacy::kSTLmap:
       case CppyyLegacy::kSTLmultimap:
@@ -354,13 +371,13 @@ void TEmulatedCollectionProxy::Expand(UInt_t nCurr, UInt_t left)
             case kIsEnum:
                break;
             case kIsClass:
-               if (oldstart && oldstart != fEnv->fStart) {
+               if (oldstart && oldstart != env.fStart) {
                   Long_t offset = 0;
                   for( i=0; i<=nCurr; ++i, offset += fValDiff ) {
                      // For now 'Move' only register the change of location
                      // so per se this is wrong since the object are copied via memcpy
                      // rather than a copy (or move) constructor.
-                     fKey->fType->Move(((char*)oldstart)+offset,((char*)fEnv->fStart)+offset);
+                     fKey->fType->Move(((char*)oldstart)+offset,((char*)env.fStart)+offset);
                   }
                }
                for( i=nCurr; i<left; ++i, addr += fValDiff )
@@ -377,7 +394,7 @@ void TEmulatedCollectionProxy::Expand(UInt_t nCurr, UInt_t left)
                   *(void**)addr = 0;
                break;
          }
-         addr = ((char*)fEnv->fStart)+fValOffset+fValDiff*nCurr;
+         addr = ((char*)env.fStart)+fValOffset+fValDiff*nCurr;
          // DO NOT break; just continue
 
          // General case for all values
@@ -387,13 +404,13 @@ void TEmulatedCollectionProxy::Expand(UInt_t nCurr, UInt_t left)
             case kIsEnum:
                break;
             case kIsClass:
-               if (oldstart && oldstart != fEnv->fStart) {
+               if (oldstart && oldstart != env.fStart) {
                   Long_t offset = 0;
                   for( i=0; i<=nCurr; ++i, offset += fValDiff ) {
                      // For now 'Move' only register the change of location
                      // so per se this is wrong since the object are copied via memcpy
                      // rather than a copy (or move) constructor.
-                     fVal->fType->Move(((char*)oldstart)+offset,((char*)fEnv->fStart)+offset);
+                     fVal->fType->Move(((char*)oldstart)+offset,((char*)env.fStart)+offset);
                   }
                }
                for( i=nCurr; i<left; ++i, addr += fValDiff ) {
@@ -420,17 +437,28 @@ void TEmulatedCollectionProxy::Resize(UInt_t left, Bool_t force)
    // Resize the container
 
    if ( fEnv && fEnv->fObject )   {
-      size_t nCurr = Size();
-      PCont_t c = PCont_t(fEnv->fObject);
-      fEnv->fStart = nCurr>0 ? &(*c->begin()) : 0;
+      Resize(*fEnv, left, force);
+      return;
+   }
+   Fatal("TEmulatedCollectionProxy","Resize> Logic error - no proxy object set.");
+}
+
+void TEmulatedCollectionProxy::Resize(EnvironBase_t &env, UInt_t left, Bool_t force) const
+{
+   // Resize the container proxied by 'env'
+
+   if ( env.fObject )   {
+      size_t nCurr = Size(env);
+      PCont_t c = PCont_t(env.fObject);
+      env.fStart = nCurr>0 ? &(*c->begin()) : 0;
       if ( left == nCurr )  {
          return;
       }
       else if ( left < nCurr )  {
-         Shrink(nCurr, left, force);
+         Shrink(env, nCurr, left, force);
          return;
       }
-      Expand(nCurr, left);
+      Expand(env, nCurr, left);
       return;
    }
    Fatal("TEmulatedCollectionProxy","Resize> Logic error - no proxy object set.");
@@ -440,7 +468,17 @@ void* TEmulatedCollectionProxy::At(UInt_t idx)
 {
    // Return the address of the value at index 'idx'
    if ( fEnv && fEnv->fObject )   {
-      PCont_t c = PCont_t(fEnv->fObject);
+      return At(*fEnv, idx);
+   }
+   Fatal("TEmulatedCollectionProxy","At> Logic error - no proxy object set.");
+   return 0;
+}
+
+void* TEmulatedCollectionProxy::At(EnvironBase_t &env, UInt_t idx) const
+{
+   // Return the address of the value at index 'idx' of the container proxied by 'env'
+   if ( env.fObject )   {
+      PCont_t c = PCont_t(env.fObject);
       size_t  s = c->size();
       if ( idx >= (s/fValDiff) )  {
          return 0;
@@ -459,6 +497,14 @@ void* TEmulatedCollectionProxy::Allocate(UInt_t n, Bool_t forceDelete)
    return fEnv->fObject;
 }
 
+void* TEmulatedCollectionProxy::Allocate(EnvironBase_t &env, UInt_t n, Bool_t forceDelete) const
+{
+   // Allocate the necessary space in the container proxied by 'env'.
+
+   Resize(env, n, forceDelete);
+   return env.fObject;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Insert data into the container where data is a C-style array of the actual type contained in the collection
 /// of the given size.   For associative container (map, etc.), the data type is the pair<key,value>.
@@ -472,6 +518,10 @@ void TEmulatedCollectionProxy::Commit(void* /* env */ )
 {
 }
 
+void TEmulatedCollectionProxy::Commit(EnvironBase_t & /* env */, void* /* from */ ) const
+{
+}
+
 void TEmulatedCollectionProxy::ReadItems(int nElements, TBuffer &b)
 {
    // Object input streamer
@@ -508,7 +558,8 @@ void TEmulatedCollectionProxy::ReadItems(int nElements, TBuffer &b)
       case kIsClass:
          DOLOOP( b.StreamObject(i,fVal->fType) );
       case kBIT_ISSTRING:
-         DOLOOP( i->read_std_string(b) );
+         b.ReadStdStrings((std::string*)itm, nElements, fValDiff);
+         break;
       case kIsPointer|kIsClass:
          DOLOOP( i->read_any_object(fVal,b) );
       case kIsPointer|kBIT_ISSTRING:
@@ -555,7 +606,8 @@ void TEmulatedCollectionProxy::WriteItems(int nElements, TBuffer &b)
       case kIsClass:
          DOLOOP( b.StreamObject(i,fVal->fType) );
       case kBIT_ISSTRING:
-         DOLOOP( TString(i->c_str()).Streamer(b) );
+         b.WriteStdStrings((std::string*)itm, nElements, fValDiff);
+         break;
       case kIsPointer|kIsClass:
          DOLOOP( b.WriteObjectAny(i->ptr(),fVal->fType) );
       case kBIT_ISSTRING|kIsPointer:
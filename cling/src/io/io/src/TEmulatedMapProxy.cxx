@@ -73,7 +73,17 @@ void* TEmulatedMapProxy::At(UInt_t idx)
 {
    // Return the address of the value at index 'idx'.
    if ( fEnv && fEnv->fObject )   {
-      PCont_t c = PCont_t(fEnv->fObject);
+      return At(*fEnv, idx);
+   }
+   Fatal("TEmulatedMapProxy","At> Logic error - no proxy object set.");
+   return 0;
+}
+
+void* TEmulatedMapProxy::At(EnvironBase_t &env, UInt_t idx) const
+{
+   // Return the address of the value at index 'idx' of the map proxied by 'env'.
+   if ( env.fObject )   {
+      PCont_t c = PCont_t(env.fObject);
       return idx<(c->size()/fValDiff) ? ((char*)&(*c->begin())) + idx*fValDiff : 0;
    }
    Fatal("TEmulatedMapProxy","At> Logic error - no proxy object set.");
@@ -84,8 +94,18 @@ UInt_t TEmulatedMapProxy::Size() const
 {
    // Return the current size of the container.
    if ( fEnv && fEnv->fObject )   {
-      PCont_t c = PCont_t(fEnv->fObject);
-      return fEnv->fSize = (c->size()/fValDiff);
+      return Size(*fEnv);
+   }
+   Fatal("TEmulatedMapProxy","Size> Logic error - no proxy object set.");
+   return 0;
+}
+
+UInt_t TEmulatedMapProxy::Size(EnvironBase_t &env) const
+{
+   // Return the current size of the map proxied by 'env'.
+   if ( env.fObject )   {
+      PCont_t c = PCont_t(env.fObject);
+      return env.fSize = (c->size()/fValDiff);
    }
    Fatal("TEmulatedMapProxy","Size> Logic error - no proxy object set.");
    return 0;
@@ -69,6 +69,19 @@ Begin_Macro
 ../../../tutorials/io/file.C
 End_Macro
 The structure of a directory is shown in TDirectoryFile::TDirectoryFile
+
+### Concurrent reads
+ReadBuffer(char*, Long64_t, Int_t) and ReadBuffers use positional reads
+(SysReadAt, i.e. pread) and atomic statistics: they neither use nor move
+the file cursor and can be called from several threads at once.  As a
+consequence, once a file is open in read-only mode and its keys are read
+(i.e. after the constructor returns), TKey::ReadObj, TKey::ReadObjectAny
+and TKey::ReadObjWithBuffer on *distinct* keys of that one TFile may run
+concurrently, provided thread safety was enabled (EnableThreadSafety()).
+This includes keys of subdirectories: the directory read is added to its
+mother directory under gCoreMutex, and its own keys are read under gROOTMutex.
+Reading the same key, or any operation that modifies the file or its
+directory structure, still requires external synchronization.
 */
 
 #include <ROOT/RConfig.hxx>
@@ -105,6 +118,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TFree.h"
 #include "TInterpreter.h"
 #include "TKey.h"
+#include "TMakeProject.h"
 #include "TProcessUUID.h"
 #include "TRegexp.h"
 #include "TROOT.h"
@@ -1344,18 +1358,16 @@ void TFile::Map(Option_t *opt)
 ///
 /// Returns kTRUE in case of failure.
 /// Compared to ReadBuffer(char*, Int_t), this routine does _not_
-/// change the cursor on the physical file representation (fD)
-/// if the data is in this TFile's cache.
+/// use nor change the cursor on the physical file representation (fD):
+/// it can be called concurrently from several threads.
 
 Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
    if (IsOpen()) {
 
-      SetOffset(pos);
-      Seek(pos);
       ssize_t siz;
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+      while ((siz = SysReadAt(fD, buf, len, pos + fArchiveOffset)) < 0 && GetErrno() == EINTR)
          ResetErrno();
 
       if (siz < 0) {
@@ -1414,6 +1426,8 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 /// The value pos[i] is the seek position of block i of length len[i].
 /// Note that for nbuf=1, this call is equivalent to TFile::ReafBuffer.
 /// This function is overloaded by TNetFile, TWebFile, etc.
+/// Like ReadBuffer(char*, Long64_t, Int_t), it does not use the file cursor
+/// and can be called concurrently.
 /// Returns kTRUE in case of failure.
 
 Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
@@ -1432,18 +1446,16 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
          if (n == 0) {
             //if the block to read is about the same size as the read-ahead buffer
             //we read the block directly
-            Seek(pos[i]);
-            result = ReadBuffer(&buf[k], len[i]);
+            result = ReadBuffer(&buf[k], pos[i], len[i]);
             if (result) break;
             k += len[i];
             i++;
          } else {
             //otherwise we read all blocks that fit in the read-ahead buffer
-            Seek(curbegin);
             if (!buf2) buf2 = new char[fgReadaheadSize];
             //we read ahead
             Long64_t nahead = pos[i-1]+len[i-1]-curbegin;
-            result = ReadBuffer(buf2, nahead);
+            result = ReadBuffer(buf2, curbegin, nahead);
             if (result) break;
             //now copy from the read-ahead buffer to the cache
             Int_t kold = k;
@@ -1500,6 +1512,9 @@ void TFile::ReadFree()
 
 TProcessID  *TFile::ReadProcessID(UShort_t pidf)
 {
+   // Objects read concurrently (see TKey::ReadObj) may share a TProcessID.
+   R__LOCKGUARD(gROOTMutex);
+
    TProcessID *pid = nullptr;
    TObjArray *pids = GetListOfProcessIDs();
    if (pidf < pids->GetSize()) pid = (TProcessID *)pids->UncheckedAt(pidf);
@@ -1724,8 +1739,10 @@ Int_t TFile::ReOpen(Option_t *mode)
       if (IsOpen() && IsWritable()) {
          WriteStreamerInfo();
 
-         // save directory key list and header
+         // save directory key list and header, as a single full keys record
+         SkipKeysDelta();
          Save();
+         CompactKeys();
 
          TFree *f1 = (TFree*)fFree->First();
          if (f1) {
@@ -2114,9 +2131,124 @@ void TFile::WriteHeader()
    delete [] psave;
 }
 
-void TFile::MakeProject(const char * /* dirname */, const char * /*classes*/,
-                        Option_t * /* option */)
+////////////////////////////////////////////////////////////////////////////////
+/// Generate C++ declarations for the classes of this file that are only
+/// known through their StreamerInfo, i.e. that are handled by emulation.
+///
+/// classes is a comma separated list of class names (wildcards allowed);
+/// "*" selects all the emulated classes. Class templates and classes nested
+/// in another class are not generated (see TMakeProject).
+///
+/// If option contains "memory", dirname is ignored and the declarations are
+/// handed to the interpreter. The emulated TClass objects are then replaced
+/// by interpreted ones, so that these classes get a real layout and the
+/// optimized streamer actions instead of the emulated New/Destructor and
+/// element by element streaming. This must be done before objects of these
+/// classes (or collections thereof) are read: classes whose StreamerInfo is
+/// already in use are skipped.
+///
+/// Otherwise the declarations are written to dirname/dirnameProjectHeaders.h.
+/// With option "new" (the default) dirname must not exist yet.
+
+void TFile::MakeProject(const char *dirname, const char *classes, Option_t *option)
 {
+   TString opt = option;
+   opt.ToLower();
+   Bool_t inmemory = opt.Contains("memory");
+
+   if (!inmemory && (!dirname || !dirname[0])) {
+      Error("MakeProject", "Invalid directory name");
+      return;
+   }
+
+   TList *list = GetStreamerInfoList();
+   if (!list) {
+      Error("MakeProject", "Cannot read the list of StreamerInfo of %s", GetName());
+      return;
+   }
+
+   R__LOCKGUARD(gInterpreterMutex);
+
+   std::vector<TMakeProject::TClassDecl> decls = TMakeProject::GenerateDeclarations(list, classes);
+
+   if (inmemory) {
+      std::string forward;
+      for (auto &decl : decls)
+         forward += decl.fForward;
+      if (!forward.empty())
+         gInterpreter->Declare(forward.c_str(), true);
+
+      Int_t ndeclared = 0;
+      for (auto &decl : decls) {
+         TClass *oldcl = TClass::GetClass(decl.fName.c_str(), kFALSE, kTRUE);
+         Bool_t inuse = kFALSE;
+         if (oldcl) {
+            TIter nextinfo(oldcl->GetStreamerInfos());
+            TVirtualStreamerInfo *info;
+            while ((info = (TVirtualStreamerInfo*)nextinfo()) && !inuse)
+               inuse = info->IsCompiled();
+         }
+         if (inuse) {
+            Warning("MakeProject", "Class %s is already in use as an emulated class, skipped", decl.fName.c_str());
+            continue;
+         }
+         if (!gInterpreter->Declare(decl.fDefinition.c_str(), true)) {
+            Warning("MakeProject", "Cannot declare class %s:\n%s", decl.fName.c_str(), decl.fDefinition.c_str());
+            continue;
+         }
+         // Replaces the emulated TClass, adopting (and rebuilding) its StreamerInfos.
+         TClass *cl = gInterpreter->GenerateTClass(decl.fName.c_str(), kFALSE, kTRUE);
+         if (cl && cl->GetState() >= TClass::kInterpreted) ++ndeclared;
+      }
+      if (gDebug > 0)
+         Info("MakeProject", "Declared %d of %d emulated classes of %s", ndeclared, (Int_t)decls.size(), GetName());
+
+   } else {
+      if (!gSystem->AccessPathName(dirname)) {
+         if (opt.Contains("new")) {
+            Error("MakeProject", "Cannot create directory %s, already existing", dirname);
+            list->Delete();
+            delete list;
+            return;
+         }
+      } else if (gSystem->mkdir(dirname, kTRUE) < 0) {
+         Error("MakeProject", "Cannot create directory %s", dirname);
+         list->Delete();
+         delete list;
+         return;
+      }
+
+      TString base = gSystem->BaseName(dirname);
+      TString path = TString::Format("%s/%sProjectHeaders.h", dirname, base.Data());
+      std::ofstream out(path.Data());
+      if (!out) {
+         Error("MakeProject", "Cannot open %s", path.Data());
+      } else {
+         out << "// Generated by TFile::MakeProject from " << GetName() << "\n"
+             << "#ifndef " << base << "ProjectHeaders_h\n"
+             << "#define " << base << "ProjectHeaders_h\n\n"
+             << "#include \"Rtypes.h\"\n"
+             << "#include \"TObject.h\"\n";
+         std::set<std::string> headers;
+         for (auto &decl : decls)
+            headers.insert(decl.fHeaders.begin(), decl.fHeaders.end());
+         headers.erase("Rtypes.h");
+         headers.erase("TObject.h");
+         for (auto &header : headers)
+            out << "#include \"" << header << "\"\n";
+         out << "\n#include <bitset>\n#include <deque>\n#include <list>\n#include <map>\n"
+             << "#include <set>\n#include <string>\n#include <utility>\n#include <vector>\n\n";
+         for (auto &decl : decls)
+            out << decl.fForward;
+         for (auto &decl : decls)
+            out << "\n" << decl.fDefinition;
+         out << "\n#endif\n";
+         Info("MakeProject", "%d classes written to %s", (Int_t)decls.size(), path.Data());
+      }
+   }
+
+   list->Delete();
+   delete list;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2265,6 +2397,9 @@ void TFile::ShowStreamerInfo()
 
 UShort_t TFile::WriteProcessID(TProcessID *pidd)
 {
+   // Objects may be streamed concurrently by TDirectoryFile::WriteMany.
+   std::lock_guard<std::recursive_mutex> lock(fWriteMutex);
+
    TProcessID *pid = pidd;
    if (!pid) pid = TProcessID::GetPID();
    TObjArray *pids = GetListOfProcessIDs();
@@ -2675,6 +2810,27 @@ Int_t TFile::SysRead(Int_t fd, void *buf, Int_t len)
    return ::read(fd, buf, len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Interface to system positional read. All arguments like in POSIX pread(),
+/// except that the offset is able to handle 64 bit file systems.
+/// It does not move the file cursor; classes overriding SysRead and SysSeek
+/// must override it as well.
+
+Int_t TFile::SysReadAt(Int_t fd, void *buf, Int_t len, Long64_t offset)
+{
+#if defined(R__SEEK64)
+   return ::pread64(fd, buf, len, offset);
+#elif defined(WIN32)
+   // No positional read: serialize the seek and the read.
+   R__LOCKGUARD(gROOTMutex);
+   if (SysSeek(fd, offset, SEEK_SET) < 0)
+      return -1;
+   return SysRead(fd, buf, len);
+#else
+   return ::pread(fd, buf, len, offset);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to system write. All arguments like in POSIX write().
 
@@ -23,6 +23,7 @@
 #include "THashTable.h"
 #include "THashList.h"
 #include <stdlib.h>
+#include <mutex>
 
 #include "TInterpreter.h" // For gInterpreterMutex
 
@@ -43,6 +44,8 @@ namespace CppyyLegacy {
 
 class TGenVectorProxy : public TGenCollectionProxy {
 public:
+   using TGenCollectionProxy::At;
+
    // Standard Destructor
    TGenVectorProxy(const TGenCollectionProxy& c) : TGenCollectionProxy(c)
    {
@@ -52,16 +55,16 @@ public:
 {
    }
    // Return the address of the value at index 'idx'
-   virtual void* At(UInt_t idx)
-{
-      if ( fEnv && fEnv->fObject ) {
-         fEnv->fIdx = idx;
+   virtual void* At(EnvironBase_t &env, UInt_t idx) const
+   {
+      if ( env.fObject ) {
+         env.fIdx = idx;
          switch( idx ) {
          case 0:
-            return fEnv->fStart = fFirst.invoke(fEnv);
+            return env.fStart = fFirst.invoke(&env);
          default:
-            if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-            return ((char*)fEnv->fStart) + fValDiff*idx;
+            if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+            return ((char*)env.fStart) + fValDiff*idx;
          }
       }
       Fatal("TGenVectorProxy","At> Logic error - no proxy object set.");
@@ -72,9 +75,8 @@ public:
    {
       if ( force && ptr ) {
          if ( fVal->fProperties&kNeedDelete) {
-            TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
-            TPushPop helper(proxy,ptr);
-            proxy->Clear("force");
+            TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),ptr);
+            env.Clear("force");
          }
          fVal->DeleteItem(ptr);
       }
@@ -91,10 +93,11 @@ proxy to the concrete STL type. The concrete types are optimized
 for element access.
 */
 class TGenVectorBoolProxy : public TGenCollectionProxy {
-   Bool_t fLastValue;
 
 public:
-   TGenVectorBoolProxy(const TGenCollectionProxy& c) : TGenCollectionProxy(c), fLastValue(false)
+   using TGenCollectionProxy::At;
+
+   TGenVectorBoolProxy(const TGenCollectionProxy& c) : TGenCollectionProxy(c)
    {
       // Standard Constructor.
    }
@@ -102,16 +105,17 @@ public:
    {
       // Standard Destructor.
    }
-   virtual void* At(UInt_t idx)
+   virtual void* At(EnvironBase_t &env, UInt_t idx) const
    {
       // Return the address of the value at index 'idx'
 
-      // However we can 'take' the address of the content of std::vector<bool>.
-      if ( fEnv && fEnv->fObject ) {
-         auto vec = (std::vector<bool> *)(fEnv->fObject);
-         fLastValue = (*vec)[idx];
-         fEnv->fIdx = idx;
-         return &fLastValue;
+      // We can not take the address of the content of std::vector<bool>,
+      // so return the address of a copy kept in the environment.
+      if ( env.fObject ) {
+         auto vec = (std::vector<bool> *)(env.fObject);
+         env.fLastValueVecBool = (*vec)[idx];
+         env.fIdx = idx;
+         return &(env.fLastValueVecBool);
       }
       Fatal("TGenVectorProxy","At> Logic error - no proxy object set.");
       return 0;
@@ -140,6 +144,8 @@ public:
 class TGenBitsetProxy : public TGenCollectionProxy {
 
 public:
+   using TGenCollectionProxy::At;
+
    TGenBitsetProxy(const TGenCollectionProxy& c) : TGenCollectionProxy(c)
    {
       // Standard Constructor.
@@ -148,26 +154,26 @@ public:
    {
       // Standard Destructor.
    }
-   virtual void* At(UInt_t idx)
+   virtual void* At(EnvironBase_t &env, UInt_t idx) const
    {
       // Return the address of the value at index 'idx'
 
       // However we can 'take' the address of the content of std::vector<bool>.
-      if ( fEnv && fEnv->fObject ) {
+      if ( env.fObject ) {
          switch( idx ) {
             case 0:
-               fEnv->fStart = fFirst.invoke(fEnv);
-               fEnv->fIdx = idx;
+               env.fStart = fFirst.invoke(&env);
+               env.fIdx = idx;
                break;
             default:
-               fEnv->fIdx = idx - fEnv->fIdx;
-               if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-               fNext.invoke(fEnv);
-               fEnv->fIdx = idx;
+               env.fIdx = idx - env.fIdx;
+               if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+               fNext.invoke(&env);
+               env.fIdx = idx;
                break;
          }
          typedef CppyyLegacy::TCollectionProxyInfo::Environ<std::pair<size_t,Bool_t> > EnvType_t;
-         EnvType_t *e = (EnvType_t*)fEnv;
+         EnvType_t *e = (EnvType_t*)&env;
          return &(e->fIterator.second);
       }
       Fatal("TGenVectorProxy","At> Logic error - no proxy object set.");
@@ -195,6 +201,8 @@ for element access.
 
 class TGenListProxy : public TGenVectorProxy {
 public:
+   using TGenVectorProxy::At;
+
    // Standard Destructor
    TGenListProxy(const TGenCollectionProxy& c) : TGenVectorProxy(c)
 {
@@ -204,18 +212,18 @@ public:
 {
    }
    // Return the address of the value at index 'idx'
-   void* At(UInt_t idx)
-{
-      if ( fEnv && fEnv->fObject ) {
+   void* At(EnvironBase_t &env, UInt_t idx) const
+   {
+      if ( env.fObject ) {
          switch( idx ) {
          case 0:
-            fEnv->fIdx = idx;
-            return fEnv->fStart = fFirst.invoke(fEnv);
+            env.fIdx = idx;
+            return env.fStart = fFirst.invoke(&env);
          default:  {
-            fEnv->fIdx = idx - fEnv->fIdx;
-            if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-            void* result = fNext.invoke(fEnv);
-            fEnv->fIdx = idx;
+            env.fIdx = idx - env.fIdx;
+            if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+            void* result = fNext.invoke(&env);
+            env.fIdx = idx;
             return result;
          }
          }
@@ -237,6 +245,8 @@ for element access.
 
 class TGenSetProxy : public TGenVectorProxy {
 public:
+   using TGenVectorProxy::At;
+
    // Standard Destructor
    TGenSetProxy(const TGenCollectionProxy& c) : TGenVectorProxy(c)
 {
@@ -246,21 +256,21 @@ public:
 {
    }
    // Return the address of the value at index 'idx'
-   void* At(UInt_t idx)
-{
-      if ( fEnv && fEnv->fObject ) {
-         if ( fEnv->fUseTemp ) {
-            return (((char*)fEnv->fTemp)+idx*fValDiff);
+   void* At(EnvironBase_t &env, UInt_t idx) const
+   {
+      if ( env.fObject ) {
+         if ( env.fUseTemp ) {
+            return (((char*)env.fTemp)+idx*fValDiff);
          }
          switch( idx ) {
          case 0:
-            fEnv->fIdx = idx;
-            return fEnv->fStart = fFirst.invoke(fEnv);
+            env.fIdx = idx;
+            return env.fStart = fFirst.invoke(&env);
          default:  {
-            fEnv->fIdx = idx - fEnv->fIdx;
-            if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-            void* result = fNext.invoke(fEnv);
-            fEnv->fIdx = idx;
+            env.fIdx = idx - env.fIdx;
+            if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+            void* result = fNext.invoke(&env);
+            env.fIdx = idx;
             return result;
          }
          }
@@ -295,15 +305,13 @@ public:
    {
       if (force) {
          if ( fKey->fProperties&kNeedDelete) {
-            TVirtualCollectionProxy *proxy = fKey->fType->GetCollectionProxy();
-            TPushPop helper(proxy,fKey->fCase&kIsPointer ? *(void**)ptr : ptr);
-            proxy->Clear("force");
+            TCollectionProxyEnv env(fKey->fType->GetCollectionProxy(),fKey->fCase&kIsPointer ? *(void**)ptr : ptr);
+            env.Clear("force");
          }
          if ( fVal->fProperties&kNeedDelete) {
-            TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
             char *addr = ((char*)ptr)+fValOffset;
-            TPushPop helper(proxy,fVal->fCase&kIsPointer ? *(void**)addr : addr);
-            proxy->Clear("force");
+            TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),fVal->fCase&kIsPointer ? *(void**)addr : addr);
+            env.Clear("force");
          }
       }
       if ( fKey->fCase&kIsPointer ) {
@@ -639,6 +647,7 @@ TGenCollectionProxy::TGenCollectionProxy(Info_t info, size_t iter_size)
    fFunctionNextIterator       = 0;
    fFunctionDeleteIterator     = 0;
    fFunctionDeleteTwoIterators = 0;
+   fProperties |= kIsReentrant;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -690,6 +699,7 @@ TGenCollectionProxy::TGenCollectionProxy(const CppyyLegacy::TCollectionProxyInfo
    fFunctionNextIterator       = info.fNext;
    fFunctionDeleteIterator     = info.fDeleteSingleIterator;
    fFunctionDeleteTwoIterators = info.fDeleteTwoIterators;
+   fProperties |= kIsReentrant;
 }
 
 namespace {
@@ -1026,37 +1036,50 @@ EDataType TGenCollectionProxy::GetType() const
 void* TGenCollectionProxy::At(UInt_t idx)
 {
    if ( fEnv && fEnv->fObject ) {
+      return At(*fEnv, idx);
+   }
+   Fatal("TGenCollectionProxy","At> Logic error - no proxy object set.");
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the address of the value at index 'idx' of the collection
+/// proxied by the caller-owned environment 'env'.
+
+void* TGenCollectionProxy::At(EnvironBase_t &env, UInt_t idx) const
+{
+   if ( env.fObject ) {
       switch (fSTL_type) {
       case CppyyLegacy::kSTLvector:
          if ((*fValue).fKind == kBool_t) {
-            auto vec = (std::vector<bool> *)(fEnv->fObject);
-            fEnv->fLastValueVecBool = (*vec)[idx];
-            fEnv->fIdx = idx;
-            return &(fEnv->fLastValueVecBool);
+            auto vec = (std::vector<bool> *)(env.fObject);
+            env.fLastValueVecBool = (*vec)[idx];
+            env.fIdx = idx;
+            return &(env.fLastValueVecBool);
          }
-         fEnv->fIdx = idx;
+         env.fIdx = idx;
          switch( idx ) {
          case 0:
-            return fEnv->fStart = fFirst.invoke(fEnv);
+            return env.fStart = fFirst.invoke(&env);
          default:
-            if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-            return ((char*)fEnv->fStart) + fValDiff*idx;
+            if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+            return ((char*)env.fStart) + fValDiff*idx;
          }
       case CppyyLegacy::kSTLbitset: {
          switch (idx) {
          case 0:
-            fEnv->fStart = fFirst.invoke(fEnv);
-            fEnv->fIdx = idx;
+            env.fStart = fFirst.invoke(&env);
+            env.fIdx = idx;
             break;
          default:
-            fEnv->fIdx = idx - fEnv->fIdx;
-            if (!fEnv->fStart) fEnv->fStart = fFirst.invoke(fEnv);
-            fNext.invoke(fEnv);
-            fEnv->fIdx = idx;
+            env.fIdx = idx - env.fIdx;
+            if (!env.fStart) env.fStart = fFirst.invoke(&env);
+            fNext.invoke(&env);
+            env.fIdx = idx;
             break;
          }
          typedef CppyyLegacy::TCollectionProxyInfo::Environ <std::pair<size_t, Bool_t>> EnvType_t;
-         EnvType_t *e = (EnvType_t *) fEnv;
+         EnvType_t *e = (EnvType_t *) &env;
          return &(e->fIterator.second);
       }
       case CppyyLegacy::kSTLset:
@@ -1067,20 +1090,20 @@ void* TGenCollectionProxy::At(UInt_t idx)
       case CppyyLegacy::kSTLunorderedmap:
       case CppyyLegacy::kSTLmultimap:
       case CppyyLegacy::kSTLunorderedmultimap:
-         if ( fEnv->fUseTemp ) {
-            return (((char*)fEnv->fTemp)+idx*fValDiff);
+         if ( env.fUseTemp ) {
+            return (((char*)env.fTemp)+idx*fValDiff);
          }
          // Intentional fall through.
       default:
          switch( idx ) {
          case 0:
-            fEnv->fIdx = idx;
-            return fEnv->fStart = fFirst.invoke(fEnv);
+            env.fIdx = idx;
+            return env.fStart = fFirst.invoke(&env);
          default:  {
-            fEnv->fIdx = idx - fEnv->fIdx;
-            if (! fEnv->fStart ) fEnv->fStart = fFirst.invoke(fEnv);
-            void* result = fNext.invoke(fEnv);
-            fEnv->fIdx = idx;
+            env.fIdx = idx - env.fIdx;
+            if (! env.fStart ) env.fStart = fFirst.invoke(&env);
+            void* result = fNext.invoke(&env);
+            env.fIdx = idx;
             return result;
          }
          }
@@ -1096,14 +1119,24 @@ void* TGenCollectionProxy::At(UInt_t idx)
 void TGenCollectionProxy::Clear(const char* opt)
 {
    if ( fEnv && fEnv->fObject ) {
+      Clear(*fEnv, opt);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the collection proxied by the caller-owned environment 'env'.
+
+void TGenCollectionProxy::Clear(EnvironBase_t &env, const char* opt) const
+{
+   if ( env.fObject ) {
       if ( (fProperties & kNeedDelete) && opt && *opt=='f' ) {
-         size_t i, n = *(size_t*)fSize.invoke(fEnv);
+         size_t i, n = *(size_t*)fSize.invoke(&env);
          if ( n > 0 ) {
             for (i=0; i<n; ++i)
-               DeleteItem(true, TGenCollectionProxy::At(i));
+               DeleteItem(true, TGenCollectionProxy::At(env, i));
          }
       }
-      fClear.invoke(fEnv);
+      fClear.invoke(&env);
    }
 }
 
@@ -1113,10 +1146,23 @@ void TGenCollectionProxy::Clear(const char* opt)
 UInt_t TGenCollectionProxy::Size() const
 {
    if ( fEnv && fEnv->fObject ) {
-      if (fEnv->fUseTemp) {
-         return fEnv->fSize;
+      return Size(*fEnv);
+   }
+   Fatal("TGenCollectionProxy","Size> Logic error - no proxy object set.");
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current size of the collection proxied by the caller-owned
+/// environment 'env'.
+
+UInt_t TGenCollectionProxy::Size(EnvironBase_t &env) const
+{
+   if ( env.fObject ) {
+      if (env.fUseTemp) {
+         return env.fSize;
       } else {
-         return *(size_t*)fSize.invoke(fEnv);
+         return *(size_t*)fSize.invoke(&env);
       }
    }
    Fatal("TGenCollectionProxy","Size> Logic error - no proxy object set.");
@@ -1129,29 +1175,90 @@ UInt_t TGenCollectionProxy::Size() const
 void TGenCollectionProxy::Resize(UInt_t n, Bool_t force)
 {
    if ( fEnv && fEnv->fObject ) {
+      Resize(*fEnv, n, force);
+      return;
+   }
+   Fatal("TGenCollectionProxy","Resize> Logic error - no proxy object set.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Resize the collection proxied by the caller-owned environment 'env'.
+
+void TGenCollectionProxy::Resize(EnvironBase_t &env, UInt_t n, Bool_t force) const
+{
+   if ( env.fObject ) {
       if ( force && fPointers ) {
-         size_t i, nold = *(size_t*)fSize.invoke(fEnv);
+         size_t i, nold = *(size_t*)fSize.invoke(&env);
          if ( n != nold ) {
             for (i=n; i<nold; ++i)
-               DeleteItem(true, *(void**)TGenCollectionProxy::At(i));
+               DeleteItem(true, *(void**)TGenCollectionProxy::At(env, i));
          }
       }
       MESSAGE(3, "Resize(n)" );
-      fEnv->fSize = n;
-      fResize(fEnv->fObject,fEnv->fSize);
+      env.fSize = n;
+      fResize(env.fObject,env.fSize);
       return;
    }
    Fatal("TGenCollectionProxy","Resize> Logic error - no proxy object set.");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a staging area able to hold 'n' elements.  Staging areas are
+/// shared by all the environments of this proxy, hence the lock.
+
+TGenCollectionProxy::TStaging *TGenCollectionProxy::AcquireStaging(UInt_t n) const
+{
+   TStaging *s = 0;
+   {
+      std::lock_guard<TSpinMutex> lock(fStagedLock);
+      if (!fStaged.empty()) {
+         s = fStaged.back();
+         fStaged.pop_back();
+      }
+   }
+   if (s) {
+      s->Resize(n);
+   } else {
+      s = new TStaging(n,fValDiff);
+   }
+   return s;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Feed the content of the staging area into its target and keep the
+/// staging area for later reuse.
+
+void TGenCollectionProxy::CommitStaging(TStaging *s) const
+{
+   if ( s->GetTarget() ) {
+      fFeed(s->GetContent(),s->GetTarget(),s->GetSize());
+   }
+   fDestruct(s->GetContent(),s->GetSize());
+   s->SetTarget(0);
+   std::lock_guard<TSpinMutex> lock(fStagedLock);
+   fStaged.push_back(s);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Allocate the needed space.
 /// For associative collection, this returns a TStaging object that
 /// need to be deleted manually __or__ returned by calling Commit(TStaging*)
 
-void* TGenCollectionProxy::Allocate(UInt_t n, Bool_t /* forceDelete */ )
+void* TGenCollectionProxy::Allocate(UInt_t n, Bool_t forceDelete)
 {
    if ( fEnv && fEnv->fObject ) {
+      return Allocate(*fEnv, n, forceDelete);
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the needed space in the collection proxied by the caller-owned
+/// environment 'env'.  See Allocate(UInt_t, Bool_t).
+
+void* TGenCollectionProxy::Allocate(EnvironBase_t &env, UInt_t n, Bool_t /* forceDelete */ ) const
+{
+   if ( env.fObject ) {
       switch ( fSTL_type ) {
          case CppyyLegacy::kSTLset:
          case CppyyLegacy::kSTLunorderedset:
@@ -1162,29 +1269,22 @@ void* TGenCollectionProxy::Allocate(UInt_t n, Bool_t /* forceDelete */ )
          case CppyyLegacy::kSTLmultimap:
          case CppyyLegacy::kSTLunorderedmultimap:{
             if ( (fProperties & kNeedDelete) )
-               Clear("force");
+               Clear(env, "force");
             else
-               fClear.invoke(fEnv);
+               fClear.invoke(&env);
             // Commit no longer use the environment and thus no longer decrease
             // the count.  Consequently we no longer should increase it here.
-            // ++fEnv->fRefCount;
-            fEnv->fSize  = n;
+            // ++env.fRefCount;
+            env.fSize  = n;
 
-            TStaging *s;
-            if (fStaged.empty()) {
-               s = new TStaging(n,fValDiff);
-            } else {
-               s = fStaged.back();
-               fStaged.pop_back();
-               s->Resize(n);
-            }
+            TStaging *s = AcquireStaging(n);
             fConstruct(s->GetContent(),s->GetSize());
 
-            s->SetTarget(fEnv->fObject);
+            s->SetTarget(env.fObject);
 
-            fEnv->fTemp = s->GetContent();
-            fEnv->fUseTemp = kTRUE;
-            fEnv->fStart = fEnv->fTemp;
+            env.fTemp = s->GetContent();
+            env.fUseTemp = kTRUE;
+            env.fStart = env.fTemp;
 
             return s;
          }
@@ -1193,26 +1293,19 @@ void* TGenCollectionProxy::Allocate(UInt_t n, Bool_t /* forceDelete */ )
          case CppyyLegacy::kSTLforwardlist:
          case CppyyLegacy::kSTLdeque:
             if( (fProperties & kNeedDelete) ) {
-               Clear("force");
+               Clear(env, "force");
             }
-            fEnv->fSize = n;
-            fResize(fEnv->fObject,n);
-            return fEnv->fObject;
+            env.fSize = n;
+            fResize(env.fObject,n);
+            return env.fObject;
 
         case CppyyLegacy::kSTLbitset: {
-            TStaging *s;
-            if (fStaged.empty()) {
-               s = new TStaging(n,fValDiff);
-            } else {
-               s = fStaged.back();
-               fStaged.pop_back();
-               s->Resize(n);
-            }
-            s->SetTarget(fEnv->fObject);
+            TStaging *s = AcquireStaging(n);
+            s->SetTarget(env.fObject);
 
-            fEnv->fTemp = s->GetContent();
-            fEnv->fUseTemp = kTRUE;
-            fEnv->fStart = fEnv->fTemp;
+            env.fTemp = s->GetContent();
+            env.fUseTemp = kTRUE;
+            env.fStart = env.fTemp;
 
             return s;
         }
@@ -1241,17 +1334,41 @@ void TGenCollectionProxy::Commit(void* from)
 //      case CppyyLegacy::kSTLset:
 //      case CppyyLegacy::kSTLmultiset:
       if ( from ) {
-         TStaging *s = (TStaging*) from;
-         if ( s->GetTarget() ) {
-            fFeed(s->GetContent(),s->GetTarget(),s->GetSize());
-         }
-         fDestruct(s->GetContent(),s->GetSize());
-         s->SetTarget(0);
-         fStaged.push_back(s);
+         CommitStaging((TStaging*) from);
       }
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Commit the change done through the caller-owned environment 'env'.
+/// Once committed the staging area is no longer used by 'env'.
+
+void TGenCollectionProxy::Commit(EnvironBase_t &env, void* from) const
+{
+   if ((fProperties & kIsAssociative) && from) {
+      CommitStaging((TStaging*) from);
+      env.fTemp = 0;
+      env.fUseTemp = kFALSE;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the caller-owned environment 'env' to proxy the collection
+/// located at 'objstart'.  Contrary to PushProxy, the proxy itself is not
+/// modified, so nested uses of the proxy do not disturb each other.
+
+void TGenCollectionProxy::InitEnv(EnvironBase_t &env, void *objstart) const
+{
+   if ( !fValue.load() ) Initialize(kFALSE);
+   env.fSize     = 0;
+   env.fRefCount = 1;
+   env.fObject   = objstart;
+   env.fStart    = 0;
+   env.fIdx      = 0;
+   env.fTemp     = 0;
+   env.fUseTemp  = kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add an object.
 
@@ -1316,31 +1433,27 @@ void TGenCollectionProxy::DeleteItem(Bool_t force, void* ptr) const
          case CppyyLegacy::kSTLunorderedmultimap:{
             if ( fKey->fCase&kIsPointer ) {
                if (fKey->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fKey->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,*(void**)ptr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fKey->fType->GetCollectionProxy(),*(void**)ptr);
+                  env.Clear("force");
                }
                fKey->DeleteItem(*(void**)ptr);
              } else {
                if (fKey->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fKey->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,ptr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fKey->fType->GetCollectionProxy(),ptr);
+                  env.Clear("force");
                }
             }
             char *addr = ((char*)ptr)+fValOffset;
             if ( fVal->fCase&kIsPointer ) {
                if ( fVal->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,*(void**)addr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),*(void**)addr);
+                  env.Clear("force");
                }
                fVal->DeleteItem(*(void**)addr);
            } else {
                if ( fVal->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,addr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),addr);
+                  env.Clear("force");
                }
             }
             break;
@@ -1348,16 +1461,14 @@ void TGenCollectionProxy::DeleteItem(Bool_t force, void* ptr) const
          default: {
             if ( fVal->fCase&kIsPointer ) {
                if (fVal->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,*(void**)ptr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),*(void**)ptr);
+                  env.Clear("force");
                }
                fVal->DeleteItem(*(void**)ptr);
             } else {
                if (fVal->fProperties&kNeedDelete) {
-                  TVirtualCollectionProxy *proxy = fVal->fType->GetCollectionProxy();
-                  TPushPop helper(proxy,ptr);
-                  proxy->Clear("force");
+                  TCollectionProxyEnv env(fVal->fType->GetCollectionProxy(),ptr);
+                  env.Clear("force");
                }
             }
             break;
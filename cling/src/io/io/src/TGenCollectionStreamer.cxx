@@ -212,7 +212,7 @@ void DispatchConvertArray(int writeType, TGenCollectionProxy::StreamHelper *read
    }
 }
 
-void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TClass *onFileClass)
+void TGenCollectionStreamer::ReadPrimitives(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onFileClass)
 {
    // Primitive input streamer.
    size_t len = fValDiff * nElements;
@@ -221,17 +221,17 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
    void*  memory = 0;
    StreamHelper* itmstore = 0;
    StreamHelper* itmconv = 0;
-   fEnv->fSize = nElements;
+   env.fSize = nElements;
    switch (fSTL_type)  {
       case CppyyLegacy::kSTLvector:
          if (fVal->fKind != kBool_t)  {
-            fResize(fEnv->fObject,fEnv->fSize);
-            fEnv->fIdx = 0;
+            fResize(env.fObject,env.fSize);
+            env.fIdx = 0;
 
             TVirtualVectorIterators iterators(fFunctionCreateIterators);
-            iterators.CreateIterators(fEnv->fObject);
+            iterators.CreateIterators(env.fObject);
             itmstore = (StreamHelper*)iterators.fBegin;
-            fEnv->fStart = itmstore;
+            env.fStart = itmstore;
             break;
          }
       default:
@@ -239,7 +239,7 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
          itmstore = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
          break;
    }
-   fEnv->fStart = itmstore;
+   env.fStart = itmstore;
 
    StreamHelper *itmread;
    int readkind;
@@ -357,14 +357,14 @@ void TGenCollectionStreamer::ReadPrimitives(int nElements, TBuffer &b, const TCl
       ::operator delete((void*)itmconv);
    }
    if (feed)  {      // need to feed in data...
-      fEnv->fStart = fFeed(itmstore,fEnv->fObject,fEnv->fSize);
+      env.fStart = fFeed(itmstore,env.fObject,env.fSize);
       if (memory)  {
          ::operator delete(memory);
       }
    }
 }
 
-void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass *onFileClass)
+void TGenCollectionStreamer::ReadObjects(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onFileClass)
 {
    // Object input streamer.
    Bool_t vsn3 = b.GetInfo() && b.GetInfo()->GetOldVersion() <= 3;
@@ -375,25 +375,26 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
 
    TClass* onFileValClass = (onFileClass ? onFileClass->GetCollectionProxy()->GetValueClass() : 0);
 
-   fEnv->fSize = nElements;
+   env.fSize = nElements;
    switch (fSTL_type)  {
          // Simple case: contiguous memory. get address of first, then jump.
       case CppyyLegacy::kSTLvector:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;} break;}
-         fResize(fEnv->fObject,fEnv->fSize);
-         fEnv->fIdx = 0;
+         fResize(env.fObject,env.fSize);
+         env.fIdx = 0;
 
          {
             TVirtualVectorIterators iterators(fFunctionCreateIterators);
-            iterators.CreateIterators(fEnv->fObject);
+            iterators.CreateIterators(env.fObject);
             itm = (StreamHelper*)iterators.fBegin;
          }
-         fEnv->fStart = itm;
+         env.fStart = itm;
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType, onFileValClass ));
             case EProperty(kBIT_ISSTRING):
-               DOLOOP(i->read_std_string(b));
+               b.ReadStdStrings((std::string*)itm, nElements, fValDiff);
+               break;
             case EProperty(kIsPointer | kIsClass):
                DOLOOP(i->set(b.ReadObjectAny(fVal->fType)));
             case EProperty(kIsPointer | kBIT_ISSTRING):
@@ -409,10 +410,10 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
       case CppyyLegacy::kSTLlist:
       case CppyyLegacy::kSTLforwardlist:
       case CppyyLegacy::kSTLdeque:
-#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(idx); { x ;} ++idx;} break;}
-         fResize(fEnv->fObject,fEnv->fSize);
-         fEnv->fIdx = 0;
-         fEnv->fStart = 0;
+#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(env, idx); { x ;} ++idx;} break;}
+         fResize(env.fObject,env.fSize);
+         env.fIdx = 0;
+         env.fStart = 0;
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType, onFileValClass));
@@ -435,30 +436,30 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
       case CppyyLegacy::kSTLunorderedset:
       case CppyyLegacy::kSTLunorderedmultiset:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;}}
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         env.fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
          fConstruct(itm,nElements);
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType, onFileValClass));
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
-               fDestruct(fEnv->fStart,fEnv->fSize);
+               fFeed(env.fStart,env.fObject,env.fSize);
+               fDestruct(env.fStart,env.fSize);
                break;
             case EProperty(kBIT_ISSTRING):
-               DOLOOP(i->read_std_string(b))
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
-               fDestruct(fEnv->fStart,fEnv->fSize);
+               b.ReadStdStrings((std::string*)itm, nElements, fValDiff);
+               fFeed(env.fStart,env.fObject,env.fSize);
+               fDestruct(env.fStart,env.fSize);
                break;
             case EProperty(kIsPointer | kIsClass):
                DOLOOP(i->set(b.ReadObjectAny(fVal->fType)));
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
+               fFeed(env.fStart,env.fObject,env.fSize);
                break;
             case EProperty(kIsPointer | kBIT_ISSTRING):
                DOLOOP(i->read_std_string_pointer(b))
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
+               fFeed(env.fStart,env.fObject,env.fSize);
                break;
             case EProperty(kIsPointer | kBIT_ISTSTRING | kIsClass):
                DOLOOP(i->read_tstring_pointer(vsn3, b));
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
+               fFeed(env.fStart,env.fObject,env.fSize);
                break;
          }
 #undef DOLOOP
@@ -471,7 +472,7 @@ void TGenCollectionStreamer::ReadObjects(int nElements, TBuffer &b, const TClass
    }
 }
 
-void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
+void TGenCollectionStreamer::ReadPairFromMap(EnvironBase_t &env, int nElements, TBuffer &b)
 {
    // Input streamer to convert a map into another collection
 
@@ -490,27 +491,27 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
    TClassEdit::GetSplit(pinfo->GetName(), inside, nested);
    Value first(inside[1],kFALSE);
    Value second(inside[2],kFALSE);
-   fValOffset = ((TStreamerElement*)pinfo->GetElements()->At(1))->GetOffset();
+   const Int_t valOffset = ((TStreamerElement*)pinfo->GetElements()->At(1))->GetOffset();
 
-   fEnv->fSize = nElements;
+   env.fSize = nElements;
    switch (fSTL_type)  {
          // Simple case: contiguous memory. get address of first, then jump.
       case CppyyLegacy::kSTLvector:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;} break;}
-         fResize(fEnv->fObject,fEnv->fSize);
-         fEnv->fIdx = 0;
+         fResize(env.fObject,env.fSize);
+         env.fIdx = 0;
 
          {
             TVirtualVectorIterators iterators(fFunctionCreateIterators);
-            iterators.CreateIterators(fEnv->fObject);
+            iterators.CreateIterators(env.fObject);
             itm = (StreamHelper*)iterators.fBegin;
          }
-         fEnv->fStart = itm;
+         env.fStart = itm;
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(
                   ReadMapHelper(i, &first, vsn3, b);
-                  ReadMapHelper((StreamHelper*)(((char*)i) + fValOffset), &second, vsn3, b)
+                  ReadMapHelper((StreamHelper*)(((char*)i) + valOffset), &second, vsn3, b)
                );
          }
 #undef DOLOOP
@@ -521,13 +522,13 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
       case CppyyLegacy::kSTLlist:
       case CppyyLegacy::kSTLforwardlist:
       case CppyyLegacy::kSTLdeque:
-#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(idx); { x ;} ++idx;} break;}
-         fResize(fEnv->fObject,fEnv->fSize);
-         fEnv->fIdx = 0;
+#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(env, idx); { x ;} ++idx;} break;}
+         fResize(env.fObject,env.fSize);
+         env.fIdx = 0;
          {
             TVirtualVectorIterators iterators(fFunctionCreateIterators);
-            iterators.CreateIterators(fEnv->fObject);
-            fEnv->fStart = iterators.fBegin;
+            iterators.CreateIterators(env.fObject);
+            env.fStart = iterators.fBegin;
          }
          switch (fVal->fCase) {
             case kIsClass:
@@ -548,7 +549,7 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
       case CppyyLegacy::kSTLunorderedset:
       case CppyyLegacy::kSTLunorderedmultiset:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;}}
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         env.fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
          fConstruct(itm,nElements);
          switch (fVal->fCase) {
             case kIsClass:
@@ -558,8 +559,8 @@ void TGenCollectionStreamer::ReadPairFromMap(int nElements, TBuffer &b)
                      b.ApplySequence(*(pinfo->GetReadObjectWiseActions()), where);
                   );
                }
-               fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
-               fDestruct(fEnv->fStart,fEnv->fSize);
+               fFeed(env.fStart,env.fObject,env.fSize);
+               fDestruct(env.fStart,env.fSize);
                break;
          }
 #undef DOLOOP
@@ -731,7 +732,7 @@ To readOneValue(TBuffer &b, int readtype) {
 }
 
 
-void TGenCollectionStreamer::ReadMap(int nElements, TBuffer &b, const TClass *onFileClass)
+void TGenCollectionStreamer::ReadMap(EnvironBase_t &env, int nElements, TBuffer &b, const TClass *onFileClass)
 {
    // Map input streamer.
    Bool_t vsn3 = b.GetInfo() && b.GetInfo()->GetOldVersion() <= 3;
@@ -741,9 +742,9 @@ void TGenCollectionStreamer::ReadMap(int nElements, TBuffer &b, const TClass *on
    void* memory = 0;
    StreamHelper* i;
    float f;
-   fEnv->fSize  = nElements;
-   fEnv->fStart = (len < sizeof(buffer) ? buffer : memory =::operator new(len));
-   addr = temp = (char*)fEnv->fStart;
+   env.fSize  = nElements;
+   env.fStart = (len < sizeof(buffer) ? buffer : memory =::operator new(len));
+   addr = temp = (char*)env.fStart;
    fConstruct(addr,nElements);
 
    int onFileValueKind[2];
@@ -890,14 +891,14 @@ void TGenCollectionStreamer::ReadMap(int nElements, TBuffer &b, const TClass *on
          addr += fValOffset;
       }
    }
-   fFeed(fEnv->fStart,fEnv->fObject,fEnv->fSize);
-   fDestruct(fEnv->fStart,fEnv->fSize);
+   fFeed(env.fStart,env.fObject,env.fSize);
+   fDestruct(env.fStart,env.fSize);
    if (memory) {
       ::operator delete(memory);
    }
 }
 
-void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
+void TGenCollectionStreamer::WritePrimitives(EnvironBase_t &env, int nElements, TBuffer &b)
 {
    // Primitive output streamer.
    size_t len = fValDiff * nElements;
@@ -907,12 +908,12 @@ void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
    switch (fSTL_type)  {
       case CppyyLegacy::kSTLvector:
          if (fVal->fKind != kBool_t)  {
-            itm = (StreamHelper*)(fEnv->fStart = fFirst.invoke(fEnv));
+            itm = (StreamHelper*)(env.fStart = fFirst.invoke(&env));
             break;
          }
       default:
-         fEnv->fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
-         fCollect(fEnv->fObject,itm);
+         env.fStart = itm = (StreamHelper*)(len < sizeof(buffer) ? buffer : memory =::operator new(len));
+         fCollect(env.fObject,itm);
          break;
    }
    switch (int(fVal->fKind))   {
@@ -971,7 +972,7 @@ void TGenCollectionStreamer::WritePrimitives(int nElements, TBuffer &b)
    }
 }
 
-void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
+void TGenCollectionStreamer::WriteObjects(EnvironBase_t &env, int nElements, TBuffer &b)
 {
    // Object output streamer.
    StreamHelper* itm = 0;
@@ -979,13 +980,13 @@ void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
          // Simple case: contiguous memory. get address of first, then jump.
       case CppyyLegacy::kSTLvector:
 #define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)(((char*)itm) + fValDiff*idx); { x ;} ++idx;} break;}
-         itm = (StreamHelper*)fFirst.invoke(fEnv);
+         itm = (StreamHelper*)fFirst.invoke(&env);
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType));
                break;
             case kBIT_ISSTRING:
-               DOLOOP(TString(i->c_str()).Streamer(b));
+               b.WriteStdStrings((std::string*)itm, nElements, fValDiff);
                break;
             case kIsPointer | kIsClass:
                DOLOOP(b.WriteObjectAny(i->ptr(), fVal->fType));
@@ -1009,7 +1010,7 @@ void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
       case CppyyLegacy::kSTLset:
       case CppyyLegacy::kSTLunorderedset:
       case CppyyLegacy::kSTLunorderedmultiset:
-#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(idx); { x ;} ++idx;} break;}
+#define DOLOOP(x) {int idx=0; while(idx<nElements) {StreamHelper* i=(StreamHelper*)TGenCollectionProxy::At(env, idx); { x ;} ++idx;} break;}
          switch (fVal->fCase) {
             case kIsClass:
                DOLOOP(b.StreamObject(i, fVal->fType));
@@ -1029,14 +1030,14 @@ void TGenCollectionStreamer::WriteObjects(int nElements, TBuffer &b)
    }
 }
 
-void TGenCollectionStreamer::WriteMap(int nElements, TBuffer &b)
+void TGenCollectionStreamer::WriteMap(EnvironBase_t &env, int nElements, TBuffer &b)
 {
    // Map output streamer
    StreamHelper* i;
    Value  *v;
 
    for (int loop, idx = 0; idx < nElements; ++idx)  {
-      char* addr = (char*)TGenCollectionProxy::At(idx);
+      char* addr = (char*)TGenCollectionProxy::At(env, idx);
       v = fKey;
       for (loop = 0; loop < 2; ++loop)  {
          i = (StreamHelper*)addr;
@@ -1311,43 +1312,46 @@ void TGenCollectionStreamer::ReadBufferDefault(TBuffer &b, void *obj, const TCla
 
 void TGenCollectionStreamer::ReadBufferGeneric(TBuffer &b, void *obj, const TClass *onFileClass)
 {
-   TVirtualCollectionProxy::TPushPop env(this, obj);
+   // Keep the iteration state on the stack rather than in the proxy, so that
+   // the proxy can be shared between threads and reused for nested collections.
+   Env_t env;
+   InitEnv(env, obj);
 
    int nElements = 0;
    b >> nElements;
 
    if (nElements == 0) {
       if (obj) {
-         TGenCollectionProxy::Clear("force");
+         TGenCollectionProxy::Clear(env, "force");
       }
    } else if (nElements > 0)  {
       switch (fSTL_type)  {
          case CppyyLegacy::kSTLbitset:
             if (obj) {
                if (fProperties & kNeedDelete)   {
-                  TGenCollectionProxy::Clear("force");
+                  TGenCollectionProxy::Clear(env, "force");
                }  else {
-                  fClear.invoke(fEnv);
+                  fClear.invoke(&env);
                }
             }
-            ReadPrimitives(nElements, b, onFileClass);
+            ReadPrimitives(env, nElements, b, onFileClass);
             return;
          case CppyyLegacy::kSTLvector:
             if (obj) {
                if (fProperties & kNeedDelete)   {
-                  TGenCollectionProxy::Clear("force");
+                  TGenCollectionProxy::Clear(env, "force");
                } // a resize will be called in ReadPrimitives/ReadObjects.
                else if (fVal->fKind == kBool_t) {
-                  fClear.invoke(fEnv);
+                  fClear.invoke(&env);
                }
             }
             switch (fVal->fCase) {
                case kIsFundamental:  // Only handle primitives this way
                case kIsEnum:
-                  ReadPrimitives(nElements, b, onFileClass);
+                  ReadPrimitives(env, nElements, b, onFileClass);
                   return;
                default:
-                  ReadObjects(nElements, b, onFileClass);
+                  ReadObjects(env, nElements, b, onFileClass);
                   return;
             }
             break;
@@ -1360,18 +1364,18 @@ void TGenCollectionStreamer::ReadBufferGeneric(TBuffer &b, void *obj, const TCla
          case CppyyLegacy::kSTLunorderedmultiset:
             if (obj) {
                if (fProperties & kNeedDelete)   {
-                  TGenCollectionProxy::Clear("force");
+                  TGenCollectionProxy::Clear(env, "force");
                }  else {
-                  fClear.invoke(fEnv);
+                  fClear.invoke(&env);
                }
             }
             switch (fVal->fCase) {
                case kIsFundamental:  // Only handle primitives this way
                case kIsEnum:
-                  ReadPrimitives(nElements, b, onFileClass);
+                  ReadPrimitives(env, nElements, b, onFileClass);
                   return;
                default:
-                  ReadObjects(nElements, b, onFileClass);
+                  ReadObjects(env, nElements, b, onFileClass);
                   return;
             }
             break;
@@ -1381,12 +1385,12 @@ void TGenCollectionStreamer::ReadBufferGeneric(TBuffer &b, void *obj, const TCla
          case CppyyLegacy::kSTLunorderedmultimap:
             if (obj) {
                if (fProperties & kNeedDelete)   {
-                  TGenCollectionProxy::Clear("force");
+                  TGenCollectionProxy::Clear(env, "force");
                }  else {
-                  fClear.invoke(fEnv);
+                  fClear.invoke(&env);
                }
             }
-            ReadMap(nElements, b, onFileClass);
+            ReadMap(env, nElements, b, onFileClass);
             break;
       }
    }
@@ -1404,7 +1408,7 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
       if (nElements > 0)  {
          switch (fSTL_type)  {
             case CppyyLegacy::kSTLbitset:
-               ReadPrimitives(nElements, b, fOnFileClass);
+               ReadPrimitives(*fEnv, nElements, b, fOnFileClass);
                return;
             case CppyyLegacy::kSTLvector:
             case CppyyLegacy::kSTLlist:
@@ -1416,10 +1420,10 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
                switch (fVal->fCase) {
                   case kIsFundamental:  // Only handle primitives this way
                   case kIsEnum:
-                     ReadPrimitives(nElements, b, fOnFileClass);
+                     ReadPrimitives(*fEnv, nElements, b, fOnFileClass);
                      return;
                   default:
-                     ReadObjects(nElements, b, fOnFileClass);
+                     ReadObjects(*fEnv, nElements, b, fOnFileClass);
                      return;
                }
                break;
@@ -1427,7 +1431,7 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
             case CppyyLegacy::kSTLmultimap:
             case CppyyLegacy::kSTLunorderedmap:
             case CppyyLegacy::kSTLunorderedmultimap:
-               ReadMap(nElements, b, fOnFileClass);
+               ReadMap(*fEnv, nElements, b, fOnFileClass);
                break;
          }
       }
@@ -1437,7 +1441,7 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
       if (nElements > 0)  {
          switch (fSTL_type)  {
             case CppyyLegacy::kSTLbitset:
-               WritePrimitives(nElements, b);
+               WritePrimitives(*fEnv, nElements, b);
                return;
             case CppyyLegacy::kSTLvector:
             case CppyyLegacy::kSTLlist:
@@ -1450,10 +1454,10 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
                switch (fVal->fCase) {
                   case kIsFundamental:  // Only handle primitives this way
                   case kIsEnum:
-                     WritePrimitives(nElements, b);
+                     WritePrimitives(*fEnv, nElements, b);
                      return;
                   default:
-                     WriteObjects(nElements, b);
+                     WriteObjects(*fEnv, nElements, b);
                      return;
                }
                break;
@@ -1461,7 +1465,7 @@ void TGenCollectionStreamer::Streamer(TBuffer &b)
             case CppyyLegacy::kSTLmultimap:
             case CppyyLegacy::kSTLunorderedmap:
             case CppyyLegacy::kSTLunorderedmultimap:
-               WriteMap(nElements, b);
+               WriteMap(*fEnv, nElements, b);
                break;
          }
       }
@@ -1483,7 +1487,7 @@ void TGenCollectionStreamer::StreamerAsMap(TBuffer &b)
             case CppyyLegacy::kSTLmultimap:
             case CppyyLegacy::kSTLunorderedmap:
             case CppyyLegacy::kSTLunorderedmultimap:
-               ReadMap(nElements, b, fOnFileClass);
+               ReadMap(*fEnv, nElements, b, fOnFileClass);
                break;
             case CppyyLegacy::kSTLvector:
             case CppyyLegacy::kSTLlist:
@@ -1493,7 +1497,7 @@ void TGenCollectionStreamer::StreamerAsMap(TBuffer &b)
             case CppyyLegacy::kSTLset:
             case CppyyLegacy::kSTLunorderedset:
             case CppyyLegacy::kSTLunorderedmultiset:{
-                  ReadPairFromMap(nElements, b);
+                  ReadPairFromMap(*fEnv, nElements, b);
                   break;
                }
             default:
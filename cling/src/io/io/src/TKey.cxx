@@ -236,7 +236,6 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
 
    Build(motherDir, obj->ClassName(), -1);
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
    fCycle     = fMotherDir->AppendKey(this);
@@ -245,46 +244,46 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
    fKeylen    = fBufferRef->Length();
    fBufferRef->MapObject(obj);    //register obj in map in case of self reference
    ((TObject*)obj)->Streamer(*fBufferRef);    //write object
-   lbuf       = fBufferRef->Length();
-   fObjlen    = lbuf - fKeylen;
+   fObjlen    = fBufferRef->Length() - fKeylen;
 
-   Int_t cxlevel = GetFile() ? GetFile()->GetCompressionLevel() : 0;
-   CppyyLegacy::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<CppyyLegacy::RCompressionSetting::EAlgorithm::EValues>(GetFile() ? GetFile()->GetCompressionAlgorithm() : 0);
-   if (cxlevel > 0 && fObjlen > 256) {
-      Int_t nbuffers = 1 + (fObjlen - 1)/kMAXZIPBUF;
-      Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
-      fBuffer = new char[buflen];
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
-      }
-      Create(noutot);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-      delete fBufferRef; fBufferRef = 0;
-   } else {
-      fBuffer = fBufferRef->Buffer();
-      Create(fObjlen);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
+   FinishBuffer(CompressBuffer());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a TKey object for a TObject, without registering it in motherDir
+/// and without allocating its space in the file.
+///
+/// The object is streamed and compressed only; this may be done concurrently
+/// for different objects (see TDirectoryFile::WriteMany). filepos is the end
+/// of the file when the keys were prepared and is used, as in Build, to pick
+/// the key version. Commit must then be called, in the order the keys should
+/// appear in the file, before the key is written with WriteFile.
+
+TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* motherDir, Long64_t filepos)
+     : TNamed(name, obj->GetTitle())
+{
+   R__ASSERT(obj);
+
+   if (!obj->IsA()->HasDefaultConstructor()) {
+      Warning("TKey", "since %s has no public constructor\n"
+              "\twhich can be called without argument, objects of this class\n"
+              "\tcan not be read with the current library. You will need to\n"
+              "\tadd a default constructor before attempting to read it.",
+              obj->ClassName());
    }
+
+   Build(motherDir, obj->ClassName(), filepos);
+
+   fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
+   fBufferRef->SetParent(GetFile());
+
+   Streamer(*fBufferRef);         //write key itself
+   fKeylen    = fBufferRef->Length();
+   fBufferRef->MapObject(obj);    //register obj in map in case of self reference
+   ((TObject*)obj)->Streamer(*fBufferRef);    //write object
+   fObjlen    = fBufferRef->Length() - fKeylen;
+
+   fNbytes    = CompressBuffer();  // until Commit, the size of the (compressed) object
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -332,50 +331,11 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
-
    fBufferRef->MapObject(actualStart,clActual);         //register obj in map in case of self reference
    clActual->Streamer((void*)actualStart, *fBufferRef); //write object
-   lbuf       = fBufferRef->Length();
-   fObjlen    = lbuf - fKeylen;
+   fObjlen    = fBufferRef->Length() - fKeylen;
 
-   Int_t cxlevel = GetFile() ? GetFile()->GetCompressionLevel() : 0;
-   CppyyLegacy::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<CppyyLegacy::RCompressionSetting::EAlgorithm::EValues>(GetFile() ? GetFile()->GetCompressionAlgorithm() : 0);
-   if (cxlevel > 0 && fObjlen > 256) {
-      Int_t nbuffers = 1 + (fObjlen - 1)/kMAXZIPBUF;
-      Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
-      fBuffer = new char[buflen];
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
-      }
-      Create(noutot);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-      delete fBufferRef; fBufferRef = 0;
-   } else {
-      fBuffer = fBufferRef->Buffer();
-      Create(fObjlen);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-   }
+   FinishBuffer(CompressBuffer());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -414,6 +374,89 @@ void TKey::Build(TDirectory* motherDir, const char* classname, Long64_t filepos)
       SetBit(TKey::kReproducible);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the object streamed in fBufferRef into fBuffer, if the file
+/// requests compression and the object is large enough to benefit.
+///
+/// Returns the number of bytes of the object as it will be written. When the
+/// object is not compressed, fBuffer is the buffer of fBufferRef. Does not
+/// touch the file, so it can run concurrently for different keys.
+
+Int_t TKey::CompressBuffer()
+{
+   Int_t nout, noutot, bufmax, nzip;
+
+   Int_t cxlevel = GetFile() ? GetFile()->GetCompressionLevel() : 0;
+   CppyyLegacy::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<CppyyLegacy::RCompressionSetting::EAlgorithm::EValues>(GetFile() ? GetFile()->GetCompressionAlgorithm() : 0);
+   if (cxlevel > 0 && fObjlen > 256) {
+      Int_t nbuffers = 1 + (fObjlen - 1)/kMAXZIPBUF;
+      Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
+      fBuffer = new char[buflen];
+      char *objbuf = fBufferRef->Buffer() + fKeylen;
+      char *bufcur = &fBuffer[fKeylen];
+      noutot = 0;
+      nzip   = 0;
+      for (Int_t i = 0; i < nbuffers; ++i) {
+         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
+         else               bufmax = kMAXZIPBUF;
+         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
+            delete [] fBuffer;
+            fBuffer = fBufferRef->Buffer();
+            return fObjlen;
+         }
+         bufcur += nout;
+         noutot += nout;
+         objbuf += kMAXZIPBUF;
+         nzip   += kMAXZIPBUF;
+      }
+      return noutot;
+   }
+   fBuffer = fBufferRef->Buffer();
+   return fObjlen;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the space for nbytes of (compressed) object in the file and
+/// write the final key header in front of the object in fBuffer.
+
+void TKey::FinishBuffer(Int_t nbytes)
+{
+   Create(nbytes);
+   fBufferRef->SetBufferOffset(0);
+   Streamer(*fBufferRef);         //write key itself again
+   if (fBuffer != fBufferRef->Buffer()) {
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+      delete fBufferRef; fBufferRef = 0;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register a key created with the deferred TKey(obj, name, bufsize,
+/// motherDir, filepos) constructor in its directory and allocate its space
+/// in the file. Must be called from one thread at a time, in file order.
+///
+/// Returns kFALSE, leaving the key unregistered, if the file grew past
+/// TFile::kStartBigFile since the key was prepared: the key version and
+/// hence its header length would no longer match the streamed object, and
+/// the object must be written again through the regular constructor and
+/// this key deleted.
+
+Bool_t TKey::Commit()
+{
+   Int_t version = TKey::Class_Version();
+   if (GetFile()->GetEND() > TFile::kStartBigFile) version += 1000;
+   if (version != fVersion) {
+      if (fBuffer != fBufferRef->Buffer()) delete [] fBuffer;
+      fBuffer = 0;
+      return kFALSE;
+   }
+
+   fCycle = fMotherDir->AppendKey(this);
+   FinishBuffer(fNbytes);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a TKey object of specified size.
 ///
@@ -665,6 +708,8 @@ void TKey::Keep()
 ///     class MyClass : public AnotherClass, public TObject
 ///
 /// Of course, dynamic_cast<> can also be used in the example 1.
+///
+/// Distinct keys of a read-only file can be read concurrently, see TFile.
 
 TObject *TKey::ReadObj()
 {
@@ -769,6 +814,7 @@ TObject *TKey::ReadObj()
       dir->SetName(GetName());
       dir->SetTitle(GetTitle());
       dir->SetMother(fMotherDir);
+      R__WRITE_LOCKGUARD(gCoreMutex); // keys of fMotherDir may be read concurrently
       fMotherDir->Append(dir);
    }
 
@@ -888,6 +934,7 @@ TObject *TKey::ReadObjWithBuffer(char *bufferRead)
       dir->SetName(GetName());
       dir->SetTitle(GetTitle());
       dir->SetMother(fMotherDir);
+      R__WRITE_LOCKGUARD(gCoreMutex); // keys of fMotherDir may be read concurrently
       fMotherDir->Append(dir);
    }
 
@@ -1021,6 +1068,7 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
          dir->SetName(GetName());
          dir->SetTitle(GetTitle());
          dir->SetMother(fMotherDir);
+         R__WRITE_LOCKGUARD(gCoreMutex); // keys of fMotherDir may be read concurrently
          fMotherDir->Append(dir);
       }
    }
@@ -1149,9 +1197,9 @@ Bool_t TKey::ReadFile()
    if (f==0) return kFALSE;
 
    Int_t nsize = fNbytes;
-   f->Seek(fSeekKey);
 
-   if( f->ReadBuffer(fBuffer,nsize) )
+   // Positional read, does not use the file cursor (see TFile, "Concurrent reads").
+   if( f->ReadBuffer(fBuffer,fSeekKey,nsize) )
    {
       Error("ReadFile", "Failed to read data.");
       return kFALSE;
@@ -0,0 +1,296 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\class TMakeProject
+\ingroup IO
+
+Generate C++ class declarations from the TStreamerInfo of a file.
+
+The declarations only describe the persistent data members (and bases) of
+each class, in the order and with the comments (array counters, Double32_t
+ranges, ...) that were recorded in the file, so that the StreamerInfo built
+from the declared class matches the one on file.
+*/
+
+#include "TMakeProject.h"
+#include "TClass.h"
+#include "TClassEdit.h"
+#include "TDataType.h"
+#include "TList.h"
+#include "TObjArray.h"
+#include "TRegexp.h"
+#include "TStreamerElement.h"
+#include "TStreamerInfo.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <cstring>
+#include <functional>
+#include <map>
+#include <set>
+
+
+namespace CppyyLegacy {
+
+namespace {
+
+// Names that are spelled without their std:: prefix in on-file type names.
+const char *gStdNames[] = { "allocator", "array", "bitset", "deque", "equal_to", "forward_list", "hash",
+                            "less", "list", "map", "multimap", "multiset", "pair", "set", "string",
+                            "unordered_map", "unordered_multimap", "unordered_multiset",
+                            "unordered_set", "vector", nullptr };
+
+// Basic typedefs that live in the CppyyLegacy namespace.
+const char *gLegacyTypedefs[] = { "Bool_t", "Char_t", "Double32_t", "Double_t", "Float16_t", "Float_t",
+                                  "Int_t", "Long64_t", "Long_t", "Short_t", "UChar_t", "UInt_t",
+                                  "ULong64_t", "ULong_t", "UShort_t", nullptr };
+
+bool IsIdentStart(char c) { return isalpha((unsigned char)c) || c == '_'; }
+bool IsIdentChar(char c)  { return isalnum((unsigned char)c) || c == '_'; }
+
+bool InNameList(const char **list, const std::string &name)
+{
+   for (const char **n = list; *n; ++n)
+      if (name == *n) return true;
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the class CppyyLegacy::name if it is known to the interpreter, i.e.
+/// if name is one of our classes spelled without its scope (as in files
+/// written by ROOT), or nullptr.
+
+TClass *LegacyClass(const std::string &name)
+{
+   TClass *cl = TClass::GetClass(("CppyyLegacy::" + name).c_str(), kFALSE, kTRUE);
+   return cl && cl->IsLoaded() ? cl : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if name matches one of the comma separated wildcards of classes.
+
+bool MatchesSelection(const char *name, const char *classes)
+{
+   if (!classes || !classes[0] || !strcmp(classes, "*")) return true;
+
+   TString sel(classes), token, sname(name);
+   Ssiz_t from = 0;
+   while (sel.Tokenize(token, from, ",")) {
+      token = token.Strip(TString::kBoth);
+      if (token.IsNull()) continue;
+      TRegexp re(token, kTRUE);
+      Ssiz_t len = 0;
+      if (re.Index(sname, &len) == 0 && len == sname.Length()) return true;
+   }
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add to deps the selected classes that must be complete before the type
+/// spelled typeName can be used as a data member or base.
+
+void CollectDependencies(const char *typeName, const std::map<std::string, TStreamerInfo*> &selected,
+                         std::set<std::string> &deps)
+{
+   const char *c = typeName;
+   while (*c) {
+      if (!IsIdentStart(*c)) { ++c; continue; }
+      const char *start = c;
+      while (IsIdentChar(*c) || (c[0] == ':' && c[1] == ':' && IsIdentStart(c[2]))) c += (*c == ':') ? 2 : 1;
+      std::string name(start, c - start);
+      // 'Foo*' only needs the forward declaration.
+      const char *after = c;
+      while (*after == ' ') ++after;
+      if (*after != '*' && selected.count(name)) deps.insert(name);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the declaration of the data member described by element.
+
+std::string MemberDeclaration(TStreamerElement *element, std::set<std::string> &headers)
+{
+   Int_t type = element->GetType();
+   std::string tname;
+   if (element->IsA() == TStreamerBasicType::Class()) {
+      tname = TDataType::GetTypeName((EDataType)(type % TVirtualStreamerInfo::kOffsetL));
+      if (tname.empty()) tname = TMakeProject::QualifyTypeName(element->GetTypeName(), &headers);
+   } else if (element->IsA() == TStreamerBasicPointer::Class()) {
+      tname = TDataType::GetTypeName((EDataType)(type % TVirtualStreamerInfo::kOffsetL));
+      if (tname.empty()) tname = TMakeProject::QualifyTypeName(element->GetTypeName(), &headers);
+      else               tname += "*";
+   } else {
+      tname = TMakeProject::QualifyTypeName(element->GetTypeName(), &headers);
+   }
+
+   std::string decl = "   " + tname + " " + element->GetName();
+   for (Int_t i = 0; i < element->GetArrayDim(); ++i)
+      decl += "[" + std::to_string(element->GetMaxIndex(i)) + "]";
+   decl += ";";
+   if (element->GetTitle() && element->GetTitle()[0]) {
+      decl += " //";
+      decl += element->GetTitle();
+   }
+   return decl + "\n";
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return typeName with std:: added to the standard library names and
+/// CppyyLegacy:: added to the basic typedefs and to our classes (TObject,
+/// TNamed, TString, ...) spelled without their scope, so that the name can
+/// be used at global scope in the interpreter. If headers is not null, the
+/// declaration files of these classes are added to it.
+
+std::string TMakeProject::QualifyTypeName(const char *typeName, std::set<std::string> *headers)
+{
+   std::string result;
+   const char *c = typeName;
+   while (*c) {
+      if (!IsIdentStart(*c)) { result += *c++; continue; }
+      const char *start = c;
+      while (IsIdentChar(*c)) ++c;
+      std::string ident(start, c - start);
+      bool scoped = start - typeName >= 2 && start[-1] == ':' && start[-2] == ':';
+      bool scope  = c[0] == ':' && c[1] == ':';
+      if (!scoped && InNameList(gStdNames, ident)) {
+         result += "std::";
+      } else if (!scoped && InNameList(gLegacyTypedefs, ident)) {
+         result += "CppyyLegacy::";
+      } else if (!scoped && !scope && IsIdentStart(ident[0])) {
+         if (TClass *cl = LegacyClass(ident)) {
+            result += "CppyyLegacy::";
+            if (headers && cl->GetDeclFileName() && cl->GetDeclFileName()[0])
+               headers->insert(gSystem->BaseName(cl->GetDeclFileName()));
+         }
+      }
+      result += ident;
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the declarations of the classes described in the list of
+/// TStreamerInfo infos (as returned by TFile::GetStreamerInfoList) that
+/// match classes (a comma separated list of wildcards, "*" for all) and
+/// that are only known through emulation.
+///
+/// Class templates, STL collections and classes nested in another class
+/// are skipped. For each class the StreamerInfo of the version in use (or
+/// the highest one) is used. The result is ordered such that bases and
+/// data members held by value are defined before their use.
+
+std::vector<TMakeProject::TClassDecl> TMakeProject::GenerateDeclarations(const TList *infos, const char *classes)
+{
+   std::vector<TClassDecl> result;
+   if (!infos) return result;
+
+   std::set<std::string> allNames;
+   std::map<std::string, TStreamerInfo*> selected;
+   TIter next(infos);
+   TObject *obj;
+   while ((obj = next())) {
+      if (!obj->InheritsFrom(TStreamerInfo::Class())) continue;
+      TStreamerInfo *info = (TStreamerInfo*)obj;
+      std::string name = info->GetName();
+      allNames.insert(name);
+      if (name.find('<') != std::string::npos || TClassEdit::IsSTLCont(name.c_str())) continue;
+      if (!MatchesSelection(name.c_str(), classes)) continue;
+      TClass *cl = TClass::GetClass(name.c_str(), kFALSE, kTRUE);
+      if (cl && (cl->GetState() >= TClass::kInterpreted || cl->GetCollectionProxy())) continue;
+
+      TStreamerInfo *&slot = selected[name];
+      Int_t inuse = cl ? cl->GetClassVersion() : -1;
+      if (!slot || info->GetClassVersion() == inuse
+          || (slot->GetClassVersion() != inuse && info->GetClassVersion() > slot->GetClassVersion()))
+         slot = info;
+   }
+
+   // Drop the nested classes: their enclosing class would have to be generated as a whole.
+   for (auto iter = selected.begin(); iter != selected.end(); ) {
+      const std::string &name = iter->first;
+      bool nested = false;
+      for (size_t pos = name.find("::"); pos != std::string::npos && !nested; pos = name.find("::", pos + 2)) {
+         std::string outer = name.substr(0, pos);
+         TClass *outercl = TClass::GetClass(outer.c_str(), kFALSE, kTRUE);
+         nested = allNames.count(outer)
+                  || (outercl && outercl->GetClassInfo() && !(outercl->Property() & kIsNamespace));
+      }
+      if (nested) iter = selected.erase(iter);
+      else        ++iter;
+   }
+
+   std::set<std::string> visited;
+   std::function<void(const std::string&)> generate = [&](const std::string &name) {
+      if (!visited.insert(name).second) return;
+      TStreamerInfo *info = selected[name];
+
+      std::set<std::string> deps;
+      TIter nextel(info->GetElements());
+      TStreamerElement *element;
+      while ((element = (TStreamerElement*)nextel())) {
+         if (element->IsaPointer()) continue;
+         CollectDependencies(element->IsBase() ? element->GetName() : element->GetTypeName(), selected, deps);
+      }
+      for (const std::string &dep : deps)
+         if (dep != name) generate(dep);
+
+      std::string open, close, uname = name;
+      for (size_t pos = uname.find("::"); pos != std::string::npos; pos = uname.find("::")) {
+         open  += "namespace " + uname.substr(0, pos) + " {\n";
+         close += "}\n";
+         uname  = uname.substr(pos + 2);
+      }
+
+      std::string bases, members;
+      std::set<std::string> headers;
+      nextel.Reset();
+      while ((element = (TStreamerElement*)nextel())) {
+         if (element->IsBase()) {
+            bases += bases.empty() ? " : public " : ", public ";
+            bases += QualifyTypeName(element->IsA() == TStreamerBase::Class() ? element->GetName()
+                                                                               : element->GetTypeName(), &headers);
+         } else {
+            members += MemberDeclaration(element, headers);
+         }
+      }
+
+      TClass *cl = TClass::GetClass(name.c_str(), kFALSE, kTRUE);
+      Bool_t isTObject = cl && cl->InheritsFrom(TObject::Class());
+      // The inline forms define Class(), Streamer(), ... in place, as there is no
+      // dictionary to provide them. The macros use the basic typedefs unqualified.
+      std::string classdef;
+      if (info->GetClassVersion() > 0) {
+         classdef = "private:\n"
+                    "   typedef ::CppyyLegacy::Bool_t    Bool_t;\n"
+                    "   typedef ::CppyyLegacy::UChar_t   UChar_t;\n"
+                    "   typedef ::CppyyLegacy::Version_t Version_t;\n";
+         classdef += std::string("   ") + (isTObject ? "ClassDefInline(" : "ClassDefInlineNV(") + uname + ","
+                    + std::to_string(info->GetClassVersion()) + ") // Generated by TFile::MakeProject\n";
+      }
+
+      TClassDecl decl;
+      decl.fName       = name;
+      decl.fForward    = open + "class " + uname + ";\n" + close;
+      decl.fDefinition = open + "class " + uname + bases + " {\npublic:\n" + members + classdef + "};\n" + close;
+      decl.fInfo       = info;
+      decl.fHeaders.assign(headers.begin(), headers.end());
+      result.push_back(decl);
+   };
+
+   for (auto &sel : selected)
+      generate(sel.first);
+
+   return result;
+}
+
+} // namespace CppyyLegacy
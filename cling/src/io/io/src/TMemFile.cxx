@@ -26,6 +26,7 @@ only from memory.
 #include "TKey.h"
 #include "TClass.h"
 #include "TVirtualMutex.h"
+#include <algorithm>
 #include <errno.h>
 #include <stdio.h>
 #include <sys/stat.h>
@@ -106,6 +107,51 @@ TMemFile::EMode TMemFile::ParseOption(Option_t *option)
    return mode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the blocks created since the last call to the index of block starts.
+/// Blocks are only ever appended, and the size of a block no longer changes
+/// once it has a successor, so the existing entries remain valid.  Called
+/// whenever a block is added, so that FindBlock() only reads the index and
+/// positional reads (SysReadAt()) can run concurrently.
+
+void TMemFile::UpdateBlockIndex()
+{
+   if (fBlockIndex.empty())
+      fBlockIndex.push_back({0, &fBlockList});
+   while (TMemBlock *next = fBlockIndex.back().fBlock->fNext) {
+      const TBlockStart &last = fBlockIndex.back();
+      fBlockIndex.push_back({last.fStart + last.fBlock->fSize, next});
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the block holding the byte at offset and set blockStart to the
+/// offset of that block in the file.  An offset past the end of the file
+/// yields the last block.  Without an index, the file has a single block.
+
+TMemFile::TMemBlock *TMemFile::FindBlock(Long64_t offset, Long64_t &blockStart) const
+{
+   if (fBlockIndex.empty()) {
+      blockStart = 0;
+      return const_cast<TMemBlock*>(&fBlockList);
+   }
+   auto iter = std::upper_bound(fBlockIndex.begin(), fBlockIndex.end(), offset,
+                                [](Long64_t off, const TBlockStart &block) { return off < block.fStart; });
+   --iter; // The first block starts at 0.
+   blockStart = iter->fStart;
+   return iter->fBlock;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Size of the block to add when the file grows: the blocks double the
+/// capacity of the file, in steps of at least fDefaultBlockSize and at most
+/// fgMaxBlockSize, so that a large file is made of few blocks.
+
+Long64_t TMemFile::NextBlockSize() const
+{
+   return std::max(fDefaultBlockSize, std::min(fSize, fgMaxBlockSize));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor to create a TMemFile re-using external C-Style storage.
 
@@ -155,9 +201,10 @@ TMemFile::TMemFile(const char *name, std::unique_ptr<TBufferFile> buffer)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Usual Constructor.
-/// The defBlockSize parameter defines the size of the blocks of memory allocated
-/// when expanding the underlying TMemFileBuffer. If the value 0 is passed, the
-/// default block size, fgDefaultBlockSize, is adopted.
+/// The defBlockSize parameter defines the size of the first block of memory and
+/// the minimum size of the blocks allocated when expanding the underlying
+/// TMemFileBuffer; later blocks grow with the file (see NextBlockSize). If the
+/// value 0 is passed, the default block size, fgDefaultBlockSize, is adopted.
 /// See the TFile constructor for details.
 
 TMemFile::TMemFile(const char *path, Option_t *option, const char *ftitle, Int_t compress, Long64_t defBlockSize)
@@ -285,6 +332,48 @@ void TMemFile::CopyTo(TBuffer &tobuf) const
    }
 }
 
+#ifndef R__WIN32
+////////////////////////////////////////////////////////////////////////////////
+/// Fill blocks with the memory ranges holding the content of the file, that is
+/// its first GetEND() bytes, in order and without copying them (e.g. for
+/// writev or vmsplice).  Returns the number of bytes covered.
+/// The ranges remain valid as long as the file is neither written to nor deleted.
+
+Long64_t TMemFile::GetBlocks(std::vector<iovec> &blocks) const
+{
+   blocks.clear();
+   Long64_t left = std::min(GetEND(), fSize);
+   const Long64_t total = left;
+   for (const TMemBlock *current = &fBlockList; current && left > 0; current = current->fNext) {
+      Long64_t len = std::min(left, current->fSize);
+      blocks.push_back({current->fBuffer, (size_t)len});
+      left -= len;
+   }
+   return total - left;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append buffer, of size bytes, to the storage of the file: the next writes
+/// past the current end of the storage go into it instead of into a newly
+/// allocated block.  The TMemFile takes ownership of buffer, which must have
+/// been allocated with new[].  Returns kFALSE (and leaves buffer to the caller)
+/// if the file is not writable.
+
+Bool_t TMemFile::AdoptBlock(char *buffer, Long64_t size)
+{
+   if (!buffer || size <= 0 || IsExternalData() || !fWritable || !fBlockList.fBuffer)
+      return kFALSE;
+
+   UpdateBlockIndex();
+   TMemBlock *last = fBlockIndex.back().fBlock;
+   last->fNext = new TMemBlock(reinterpret_cast<UChar_t*>(buffer), size);
+   last->fNext->fPrevious = last;
+   fSize += size;
+   UpdateBlockIndex();
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the current size of the memory file
 
@@ -322,12 +411,12 @@ Int_t TMemFile::SysReadImpl(Int_t, void *buf, Long64_t len)
          // block.
 
          // First copy the end of the first block.
-         Int_t sublen = fBlockSeek->fSize - fBlockOffset;
+         Long64_t sublen = fBlockSeek->fSize - fBlockOffset;
          memcpy(buf,fBlockSeek->fBuffer+fBlockOffset,sublen);
 
          // Move to the next.
          buf = (char*)buf + sublen;
-         Int_t len_left = len - sublen;
+         Long64_t len_left = len - sublen;
          fBlockSeek = fBlockSeek->fNext;
 
          // Copy all the full blocks that are covered by the request.
@@ -361,6 +450,39 @@ Int_t TMemFile::SysRead(Int_t fd, void *buf, Int_t len)
    return SysReadImpl(fd, buf, len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read specified number of bytes from the given offset into the buffer,
+/// without changing the seek position.  See documentation for TFile::SysReadAt().
+
+Int_t TMemFile::SysReadAt(Int_t, void *buf, Int_t len, Long64_t offset)
+{
+   TRACE("READAT")
+
+   if (fBlockList.fBuffer == nullptr) {
+      errno = EBADF;
+      gSystem->SetErrorStr("The memory file is not open.");
+      return 0;
+   }
+   // Don't read past the end.
+   if (offset >= fSize)
+      return 0;
+   if (offset + len > fSize)
+      len = fSize - offset;
+
+   Long64_t blockStart = 0;
+   const TMemBlock *block = FindBlock(offset, blockStart);
+   Int_t done = 0;
+   while (block && done < len) {
+      Long64_t inBlock = offset + done - blockStart;
+      Long64_t sublen = std::min<Long64_t>(block->fSize - inBlock, len - done);
+      memcpy((char*)buf + done, block->fBuffer + inBlock, sublen);
+      done += sublen;
+      blockStart += block->fSize;
+      block = block->fNext;
+   }
+   return done;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Seek to a specified position in the file.  See TFile::SysSeek().
 /// Note that TMemFile does not support seeks when the file is open for write.
@@ -368,58 +490,29 @@ Int_t TMemFile::SysRead(Int_t fd, void *buf, Int_t len)
 Long64_t TMemFile::SysSeek(Int_t, Long64_t offset, Int_t whence)
 {
    TRACE("SEEK")
+   Long64_t blockStart = 0;
    if (whence == SEEK_SET) {
       fSysOffset = offset;
-      fBlockSeek = &fBlockList;
-      Long64_t counter = 0;
-      while(fBlockSeek->fNext && (counter+fBlockSeek->fSize) < fSysOffset)
-      {
-         counter += fBlockSeek->fSize;
-         fBlockSeek = fBlockSeek->fNext;
-      }
-      fBlockOffset = fSysOffset - counter;  // If we seek past the 'end' of the file, we now have fBlockOffset > fBlockSeek->fSize
+      fBlockSeek = FindBlock(fSysOffset, blockStart);
+      fBlockOffset = fSysOffset - blockStart;  // If we seek past the 'end' of the file, we now have fBlockOffset > fBlockSeek->fSize
    } else if (whence == SEEK_CUR) {
 
       if (offset == 0) {
          // nothing to do, really
-      } else if (offset > 0) {
-         // Move forward.
-         if ( (fBlockOffset+offset) < fBlockSeek->fSize) {
-            fSysOffset += offset;
-            fBlockOffset += offset;
-         } else {
-            Long64_t counter = fSysOffset;
-            fSysOffset += offset;
-            while(fBlockSeek->fNext && counter < fSysOffset)
-            {
-               counter += fBlockSeek->fSize;
-               fBlockSeek = fBlockSeek->fNext;
-            }
-            fBlockOffset = fSysOffset - counter; // If we seek past the 'end' of the file, we now have fBlockOffset > fBlockSeek->fSize
-         }
+      } else if (fBlockOffset+offset >= 0 && fBlockOffset+offset < fBlockSeek->fSize) {
+         // We are just moving in the current block.
+         fSysOffset += offset;
+         fBlockOffset += offset;
+      } else if (fSysOffset+offset < 0) {
+         SysError("TMemFile", "Unable to seek past the beginning of file");
+         fSysOffset   = 0;
+         fBlockSeek   = &fBlockList;
+         fBlockOffset = 0;
+         return -1;
       } else {
-         // Move backward in the file (offset < 0).
-         Long64_t counter = fSysOffset;
          fSysOffset += offset;
-         if (fSysOffset < 0) {
-            SysError("TMemFile", "Unable to seek past the beginning of file");
-            fSysOffset   = 0;
-            fBlockSeek   = &fBlockList;
-            fBlockOffset = 0;
-            return -1;
-         } else {
-            if (offset+fBlockOffset >= 0) {
-               // We are just moving in the current block.
-               fBlockOffset += offset;
-            } else {
-               while(fBlockSeek->fPrevious && counter > fSysOffset)
-               {
-                  counter -= fBlockSeek->fSize;
-                  fBlockSeek = fBlockSeek->fPrevious;
-               }
-               fBlockOffset = fSysOffset - counter;
-            }
-         }
+         fBlockSeek = FindBlock(fSysOffset, blockStart);
+         fBlockOffset = fSysOffset - blockStart; // If we seek past the 'end' of the file, we now have fBlockOffset > fBlockSeek->fSize
       }
    } else if (whence == SEEK_END) {
       if (offset > 0) {
@@ -431,6 +524,8 @@ Long64_t TMemFile::SysSeek(Int_t, Long64_t offset, Int_t whence)
          return -1;
       }
       fSysOffset = fSize;
+      fBlockSeek = FindBlock(fSysOffset, blockStart);
+      fBlockOffset = fSysOffset - blockStart;
    } else {
       SysError("TMemFile", "Unknown whence!");
       return -1;
@@ -490,15 +585,17 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
          // block.
 
          // First copy to the end of the first block.
-         Int_t sublen = fBlockSeek->fSize - fBlockOffset;
+         Long64_t sublen = fBlockSeek->fSize - fBlockOffset;
          memcpy(fBlockSeek->fBuffer+fBlockOffset,buf,sublen);
 
          // Move to the next.
          buf = (char*)buf + sublen;
-         Int_t len_left = len - sublen;
+         Long64_t len_left = len - sublen;
          if (!fBlockSeek->fNext) {
-            fBlockSeek->CreateNext(fDefaultBlockSize);
-            fSize += fDefaultBlockSize;
+            Long64_t size = NextBlockSize();
+            fBlockSeek->CreateNext(size);
+            fSize += size;
+            UpdateBlockIndex();
          }
          fBlockSeek = fBlockSeek->fNext;
 
@@ -510,8 +607,10 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
             buf = (char*)buf + fBlockSeek->fSize;
             len_left -= fBlockSeek->fSize;
             if (!fBlockSeek->fNext) {
-               fBlockSeek->CreateNext(fDefaultBlockSize);
-               fSize += fDefaultBlockSize;
+               Long64_t size = NextBlockSize();
+               fBlockSeek->CreateNext(size);
+               fSize += size;
+               UpdateBlockIndex();
             }
             fBlockSeek = fBlockSeek->fNext;
          }
@@ -22,6 +22,7 @@
 #include "TError.h"
 #include "TClassEdit.h"
 #include "TVirtualCollectionIterators.h"
+#include "TGenCollectionProxy.h"
 #include "TProcessID.h"
 #include "TFile.h"
 
@@ -31,7 +32,8 @@ namespace CppyyLegacy {
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
-// Avoid call the virtual version of TBuffer::ReadInt and co.
+// Avoid call the virtual version of TBuffer::ReadInt and co. (done for the basic types when
+// streaming through a TBufferFile, see BufferIO).
 // Merge the Reading of the version and the looking up or the StreamerInfo
 // Avoid if (bytecnt) inside the CheckByteCount routines and avoid multiple (mostly useless nested calls)
 // Try to avoid if statement on onfile class being set (TBufferFile::ReadClassBuffer).
@@ -71,6 +73,54 @@ namespace TStreamerInfoActions
       typedef UInt_t Value_t;
    };
 
+   // Streaming of a single basic type through a buffer of type Buffer_t.
+   // The generic version goes through the virtual interface of TBuffer.
+   template <typename Buffer_t>
+   struct BufferIO {
+      template <typename T>
+      static inline void Read(TBuffer &buf, T &x) { buf >> x; }
+      template <typename T>
+      static inline void Write(TBuffer &buf, const T &x) { buf << x; }
+   };
+
+   // The TBufferFile version names the implementation explicitly, so that the
+   // (inline) TBufferFile routines are called without going through the vtable
+   // and the compiler can keep the buffer cursor in a register across the loops.
+   // It must only be used when the buffer is exactly a TBufferFile (see
+   // TBufferFile::ApplySequence).
+   template <>
+   struct BufferIO<TBufferFile> {
+      static inline TBufferFile &File(TBuffer &buf) { return static_cast<TBufferFile&>(buf); }
+
+      static inline void Read(TBuffer &buf, Bool_t &x)    { File(buf).TBufferFile::ReadBool(x); }
+      static inline void Read(TBuffer &buf, Char_t &x)    { File(buf).TBufferFile::ReadChar(x); }
+      static inline void Read(TBuffer &buf, UChar_t &x)   { File(buf).TBufferFile::ReadUChar(x); }
+      static inline void Read(TBuffer &buf, Short_t &x)   { File(buf).TBufferFile::ReadShort(x); }
+      static inline void Read(TBuffer &buf, UShort_t &x)  { File(buf).TBufferFile::ReadUShort(x); }
+      static inline void Read(TBuffer &buf, Int_t &x)     { File(buf).TBufferFile::ReadInt(x); }
+      static inline void Read(TBuffer &buf, UInt_t &x)    { File(buf).TBufferFile::ReadUInt(x); }
+      static inline void Read(TBuffer &buf, Long_t &x)    { File(buf).TBufferFile::ReadLong(x); }
+      static inline void Read(TBuffer &buf, ULong_t &x)   { File(buf).TBufferFile::ReadULong(x); }
+      static inline void Read(TBuffer &buf, Long64_t &x)  { File(buf).TBufferFile::ReadLong64(x); }
+      static inline void Read(TBuffer &buf, ULong64_t &x) { File(buf).TBufferFile::ReadULong64(x); }
+      static inline void Read(TBuffer &buf, Float_t &x)   { File(buf).TBufferFile::ReadFloat(x); }
+      static inline void Read(TBuffer &buf, Double_t &x)  { File(buf).TBufferFile::ReadDouble(x); }
+
+      static inline void Write(TBuffer &buf, Bool_t x)    { File(buf).TBufferFile::WriteBool(x); }
+      static inline void Write(TBuffer &buf, Char_t x)    { File(buf).TBufferFile::WriteChar(x); }
+      static inline void Write(TBuffer &buf, UChar_t x)   { File(buf).TBufferFile::WriteUChar(x); }
+      static inline void Write(TBuffer &buf, Short_t x)   { File(buf).TBufferFile::WriteShort(x); }
+      static inline void Write(TBuffer &buf, UShort_t x)  { File(buf).TBufferFile::WriteUShort(x); }
+      static inline void Write(TBuffer &buf, Int_t x)     { File(buf).TBufferFile::WriteInt(x); }
+      static inline void Write(TBuffer &buf, UInt_t x)    { File(buf).TBufferFile::WriteUInt(x); }
+      static inline void Write(TBuffer &buf, Long_t x)    { File(buf).TBufferFile::WriteLong(x); }
+      static inline void Write(TBuffer &buf, ULong_t x)   { File(buf).TBufferFile::WriteULong(x); }
+      static inline void Write(TBuffer &buf, Long64_t x)  { File(buf).TBufferFile::WriteLong64(x); }
+      static inline void Write(TBuffer &buf, ULong64_t x) { File(buf).TBufferFile::WriteULong64(x); }
+      static inline void Write(TBuffer &buf, Float_t x)   { File(buf).TBufferFile::WriteFloat(x); }
+      static inline void Write(TBuffer &buf, Double_t x)  { File(buf).TBufferFile::WriteDouble(x); }
+   };
+
    void TConfiguration::AddToOffset(Int_t delta)
    {
       // Add the (potentially negative) delta to all the configuration's offset.  This is used by
@@ -139,12 +189,12 @@ namespace TStreamerInfoActions
       return ((TStreamerInfo*)conf->fInfo)->WriteBufferAux(buf, &obj, &(conf->fCompInfo), /*first*/ 0, /*last*/ 1, /*narr*/ 1, config->fOffset, 2);
    }
 
-   template <typename T>
+   template <typename T, typename Buffer_t = TBuffer>
    INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       T *x = (T*)( ((char*)addr) + config->fOffset );
       // Idea: Implement buf.ReadBasic/Primitive to avoid the return value
-      buf >> *x;
+      BufferIO<Buffer_t>::Read(buf, *x);
       return 0;
    }
 
@@ -182,12 +232,12 @@ namespace TStreamerInfoActions
       return 0;
    }
 
-   template <typename T>
+   template <typename T, typename Buffer_t = TBuffer>
    INLINE_TEMPLATE_ARGS Int_t WriteBasicType(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       T *x = (T *)(((char *)addr) + config->fOffset);
       // Idea: Implement buf.ReadBasic/Primitive to avoid the return value
-      buf << *x;
+      BufferIO<Buffer_t>::Write(buf, *x);
       return 0;
    }
 
@@ -288,8 +338,8 @@ namespace TStreamerInfoActions
             char **contp = (char **)((char *)addr + ioffset);
             for(int j=0;j<config->fCompInfo->fLength;++j) {
                char *cont = contp[j];
-               TVirtualCollectionProxy::TPushPop helper( proxy, cont );
-               Int_t nobjects = cont ? proxy->Size() : 0;
+               TCollectionProxyEnv helper( proxy, cont );
+               Int_t nobjects = cont ? helper.Size() : 0;
                buf << nobjects;
 
                // TODO: method is private, should be made accesible from here
@@ -1039,10 +1089,10 @@ namespace TStreamerInfoActions
          TClass *valueClass = oldProxy->GetValueClass();
          Version_t vClVersion = buf.ReadVersionForMemberWise( valueClass );
 
-         TVirtualCollectionProxy::TPushPop helper( oldProxy, (char*)addr );
+         TCollectionProxyEnv helper( oldProxy, (char*)addr );
          Int_t nobjects;
          buf.ReadInt(nobjects);
-         void* alternative = oldProxy->Allocate(nobjects,true);
+         void* alternative = helper.Allocate(nobjects,true);
          if (nobjects) {
             TActionSequence *actions = oldProxy->GetReadMemberWiseActions( vClVersion );
 
@@ -1059,7 +1109,7 @@ namespace TStreamerInfoActions
                config->fDeleteTwoIterators(begin,end);
             }
          }
-         oldProxy->Commit(alternative);
+         helper.Commit(alternative);
 
       } else {
 
@@ -1114,8 +1164,8 @@ namespace TStreamerInfoActions
          for(; obj<endobj; obj+=objectSize) {
             Int_t nobjects;
             buf.ReadInt(nobjects);
-            TVirtualCollectionProxy::TPushPop helper( oldProxy, (char*)obj );
-            void* alternative = oldProxy->Allocate(nobjects,true);
+            TCollectionProxyEnv helper( oldProxy, (char*)obj );
+            void* alternative = helper.Allocate(nobjects,true);
             if (nobjects) {
                char startbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
                char endbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
@@ -1130,7 +1180,7 @@ namespace TStreamerInfoActions
                   config->fDeleteTwoIterators(begin,end);
                }
             }
-            oldProxy->Commit(alternative);
+            helper.Commit(alternative);
          }
 
       } else {
@@ -1185,10 +1235,10 @@ namespace TStreamerInfoActions
          TVirtualCollectionProxy *newProxy = newClass->GetCollectionProxy();
          TVirtualCollectionProxy *oldProxy = oldClass->GetCollectionProxy();
 
-         TVirtualCollectionProxy::TPushPop helper( newProxy, (char*)addr );
+         TCollectionProxyEnv helper( newProxy, (char*)addr );
          Int_t nobjects;
          buf.ReadInt(nobjects);
-         void* alternative = newProxy->Allocate(nobjects,true);
+         void* alternative = helper.Allocate(nobjects,true);
          if (nobjects) {
             TActionSequence *actions = newProxy->GetConversionReadMemberWiseActions( oldProxy->GetValueClass(), vClVersion );
             char startbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
@@ -1204,7 +1254,7 @@ namespace TStreamerInfoActions
                config->fDeleteTwoIterators(begin,end);
             }
          }
-         newProxy->Commit(alternative);
+         helper.Commit(alternative);
       }
    }
 
@@ -1234,10 +1284,10 @@ namespace TStreamerInfoActions
          char *endobj = obj + conf->fLength*objectSize;
 
          for(; obj<endobj; obj+=objectSize) {
-            TVirtualCollectionProxy::TPushPop helper( newProxy, (char*)obj );
+            TCollectionProxyEnv helper( newProxy, (char*)obj );
             Int_t nobjects;
             buf.ReadInt(nobjects);
-            void* alternative = newProxy->Allocate(nobjects,true);
+            void* alternative = helper.Allocate(nobjects,true);
             if (nobjects) {
                TActionSequence *actions = newProxy->GetConversionReadMemberWiseActions( oldProxy->GetValueClass(), vClVersion );
                char startbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
@@ -1253,7 +1303,7 @@ namespace TStreamerInfoActions
                   config->fDeleteTwoIterators(begin,end);
                }
             }
-            newProxy->Commit(alternative);
+            helper.Commit(alternative);
          }
       }
    }
@@ -1567,7 +1617,7 @@ namespace TStreamerInfoActions
 
    struct VectorLooper {
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
       {
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
@@ -1575,7 +1625,7 @@ namespace TStreamerInfoActions
          end = (char*)end + config->fOffset;
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
-            buf >> *x;
+            BufferIO<Buffer_t>::Read(buf, *x);
          }
          return 0;
       }
@@ -1655,7 +1705,7 @@ namespace TStreamerInfoActions
          }
       };
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t WriteBasicType(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
       {
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
@@ -1663,7 +1713,7 @@ namespace TStreamerInfoActions
          end = (char*)end + config->fOffset;
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
-            buf << *x;
+            BufferIO<Buffer_t>::Write(buf, *x);
          }
          return 0;
       }
@@ -1936,14 +1986,14 @@ namespace TStreamerInfoActions
 
    struct VectorPtrLooper {
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TConfiguration *config)
       {
          const Int_t offset = config->fOffset;
 
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
-            buf >> *x;
+            BufferIO<Buffer_t>::Read(buf, *x);
          }
          return 0;
       }
@@ -2019,14 +2069,14 @@ namespace TStreamerInfoActions
          }
       };
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t WriteBasicType(TBuffer &buf, void *iter, const void *end, const TConfiguration *config)
       {
          const Int_t offset = config->fOffset;
 
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
-            buf << *x;
+            BufferIO<Buffer_t>::Write(buf, *x);
          }
          return 0;
       }
@@ -2093,11 +2143,11 @@ namespace TStreamerInfoActions
 
          TClass *newClass = config->fNewClass;
          TVirtualCollectionProxy *newProxy = newClass->GetCollectionProxy();
-         TVirtualCollectionProxy::TPushPop helper( newProxy, ((char*)addr)+config->fOffset );
+         TCollectionProxyEnv helper( newProxy, ((char*)addr)+config->fOffset );
 
          Int_t nvalues;
          buf.ReadInt(nvalues);
-         void* alternative = newProxy->Allocate(nvalues,true);
+         void* alternative = helper.Allocate(nvalues,true);
          if (nvalues) {
             char startbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
             char endbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
@@ -2114,7 +2164,7 @@ namespace TStreamerInfoActions
                config->fDeleteTwoIterators(begin,end);
             }
          }
-         newProxy->Commit(alternative);
+         helper.Commit(alternative);
 
          buf.CheckByteCount(start,count,config->fTypeName);
          return 0;
@@ -2196,7 +2246,7 @@ namespace TStreamerInfoActions
 
    struct GenericLooper {
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconf, const TConfiguration *config)
       {
          TGenericLoopConfig *loopconfig = (TGenericLoopConfig*)loopconf;
@@ -2209,7 +2259,7 @@ namespace TStreamerInfoActions
          void *addr;
          while( (addr = next(iter,end)) ) {
             T *x =  (T*)( ((char*)addr) + offset );
-            buf >> *x;
+            BufferIO<Buffer_t>::Read(buf, *x);
          }
          if (iter != &iterator[0]) {
             loopconfig->fDeleteIterator(iter);
@@ -2217,7 +2267,7 @@ namespace TStreamerInfoActions
          return 0;
       }
 
-      template <typename T>
+      template <typename T, typename Buffer_t = TBuffer>
       static INLINE_TEMPLATE_ARGS Int_t WriteBasicType(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconf, const TConfiguration *config)
       {
          TGenericLoopConfig *loopconfig = (TGenericLoopConfig*)loopconf;
@@ -2230,7 +2280,7 @@ namespace TStreamerInfoActions
          void *addr;
          while( (addr = next(iter,end)) ) {
             T *x =  (T*)( ((char*)addr) + offset );
-            buf << *x;
+            BufferIO<Buffer_t>::Write(buf, *x);
          }
          if (iter != &iterator[0]) {
             loopconfig->fDeleteIterator(iter);
@@ -2448,11 +2498,11 @@ namespace TStreamerInfoActions
 
          TClass *newClass = config->fNewClass;
          TVirtualCollectionProxy *newProxy = newClass->GetCollectionProxy();
-         TVirtualCollectionProxy::TPushPop helper( newProxy, ((char*)addr)+config->fOffset );
+         TCollectionProxyEnv helper( newProxy, ((char*)addr)+config->fOffset );
 
          Int_t nvalues;
          buf.ReadInt(nvalues);
-         void* alternative = newProxy->Allocate(nvalues,true);
+         void* alternative = helper.Allocate(nvalues,true);
          if (nvalues) {
             char startbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
             char endbuf[TVirtualCollectionProxy::fgIteratorArenaSize];
@@ -2470,7 +2520,7 @@ namespace TStreamerInfoActions
                config->fDeleteTwoIterators(begin,end);
             }
          }
-         newProxy->Commit(alternative);
+         helper.Commit(alternative);
 
          buf.CheckByteCount(start,count,config->fTypeName);
          return 0;
@@ -2686,19 +2736,19 @@ static TConfiguredAction GetCollectionReadAction(TVirtualStreamerInfo *info, TSt
 {
    switch (type) {
       // Read basic types.
-      case TStreamerInfo::kBool:    return TConfiguredAction( Looper::template ReadBasicType<Bool_t>, new TConfiguration(info,i,compinfo,offset) );    break;
-      case TStreamerInfo::kChar:    return TConfiguredAction( Looper::template ReadBasicType<Char_t>, new TConfiguration(info,i,compinfo,offset) );    break;
-      case TStreamerInfo::kShort:   return TConfiguredAction( Looper::template ReadBasicType<Short_t>,new TConfiguration(info,i,compinfo,offset) );   break;
-      case TStreamerInfo::kInt:     return TConfiguredAction( Looper::template ReadBasicType<Int_t>,  new TConfiguration(info,i,compinfo,offset) );     break;
-      case TStreamerInfo::kLong:    return TConfiguredAction( Looper::template ReadBasicType<Long_t>, new TConfiguration(info,i,compinfo,offset) );    break;
-      case TStreamerInfo::kLong64:  return TConfiguredAction( Looper::template ReadBasicType<Long64_t>, new TConfiguration(info,i,compinfo,offset) );  break;
-      case TStreamerInfo::kFloat:   return TConfiguredAction( Looper::template ReadBasicType<Float_t>,  new TConfiguration(info,i,compinfo,offset) );   break;
-      case TStreamerInfo::kDouble:  return TConfiguredAction( Looper::template ReadBasicType<Double_t>, new TConfiguration(info,i,compinfo,offset) );  break;
-      case TStreamerInfo::kUChar:   return TConfiguredAction( Looper::template ReadBasicType<UChar_t>,  new TConfiguration(info,i,compinfo,offset) );   break;
-      case TStreamerInfo::kUShort:  return TConfiguredAction( Looper::template ReadBasicType<UShort_t>, new TConfiguration(info,i,compinfo,offset) );  break;
-      case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template ReadBasicType<UInt_t>,   new TConfiguration(info,i,compinfo,offset) );    break;
-      case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template ReadBasicType<ULong_t>,  new TConfiguration(info,i,compinfo,offset) );   break;
-      case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template ReadBasicType<ULong64_t>, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kBool:    return TConfiguredAction( Looper::template ReadBasicType<Bool_t>, Looper::template ReadBasicType<Bool_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );    break;
+      case TStreamerInfo::kChar:    return TConfiguredAction( Looper::template ReadBasicType<Char_t>, Looper::template ReadBasicType<Char_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );    break;
+      case TStreamerInfo::kShort:   return TConfiguredAction( Looper::template ReadBasicType<Short_t>, Looper::template ReadBasicType<Short_t,TBufferFile>,new TConfiguration(info,i,compinfo,offset) );   break;
+      case TStreamerInfo::kInt:     return TConfiguredAction( Looper::template ReadBasicType<Int_t>, Looper::template ReadBasicType<Int_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) );     break;
+      case TStreamerInfo::kLong:    return TConfiguredAction( Looper::template ReadBasicType<Long_t>, Looper::template ReadBasicType<Long_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );    break;
+      case TStreamerInfo::kLong64:  return TConfiguredAction( Looper::template ReadBasicType<Long64_t>, Looper::template ReadBasicType<Long64_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );  break;
+      case TStreamerInfo::kFloat:   return TConfiguredAction( Looper::template ReadBasicType<Float_t>, Looper::template ReadBasicType<Float_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) );   break;
+      case TStreamerInfo::kDouble:  return TConfiguredAction( Looper::template ReadBasicType<Double_t>, Looper::template ReadBasicType<Double_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );  break;
+      case TStreamerInfo::kUChar:   return TConfiguredAction( Looper::template ReadBasicType<UChar_t>, Looper::template ReadBasicType<UChar_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) );   break;
+      case TStreamerInfo::kUShort:  return TConfiguredAction( Looper::template ReadBasicType<UShort_t>, Looper::template ReadBasicType<UShort_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) );  break;
+      case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template ReadBasicType<UInt_t>, Looper::template ReadBasicType<UInt_t,TBufferFile>,   new TConfiguration(info,i,compinfo,offset) );    break;
+      case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template ReadBasicType<ULong_t>, Looper::template ReadBasicType<ULong_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) );   break;
+      case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template ReadBasicType<ULong64_t>, Looper::template ReadBasicType<ULong64_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kBits: return TConfiguredAction( Looper::template ReadAction<TStreamerInfoActions::ReadBasicType<BitsMarker> > , new TBitsConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -2812,19 +2862,19 @@ template <class Looper>
 static TConfiguredAction GetCollectionWriteAction(TVirtualStreamerInfo *info, TStreamerElement * /*element*/, Int_t type, UInt_t i, TStreamerInfo::TCompInfo_t *compinfo, Int_t offset) {
    switch (type) {
       // read basic types
-      case TStreamerInfo::kBool:    return TConfiguredAction( Looper::template WriteBasicType<Bool_t>,   new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kChar:    return TConfiguredAction( Looper::template WriteBasicType<Char_t>,   new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kShort:   return TConfiguredAction( Looper::template WriteBasicType<Short_t>,  new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kInt:     return TConfiguredAction( Looper::template WriteBasicType<Int_t>,    new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kLong:    return TConfiguredAction( Looper::template WriteBasicType<Long_t>,   new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kLong64:  return TConfiguredAction( Looper::template WriteBasicType<Long64_t>, new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kFloat:   return TConfiguredAction( Looper::template WriteBasicType<Float_t>,  new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kDouble:  return TConfiguredAction( Looper::template WriteBasicType<Double_t>, new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kUChar:   return TConfiguredAction( Looper::template WriteBasicType<UChar_t>,  new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kUShort:  return TConfiguredAction( Looper::template WriteBasicType<UShort_t>, new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template WriteBasicType<UInt_t>,   new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template WriteBasicType<ULong_t>,  new TConfiguration(info,i,compinfo,offset) ); break;
-      case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template WriteBasicType<ULong64_t>,new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kBool:    return TConfiguredAction( Looper::template WriteBasicType<Bool_t>, Looper::template WriteBasicType<Bool_t,TBufferFile>,   new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kChar:    return TConfiguredAction( Looper::template WriteBasicType<Char_t>, Looper::template WriteBasicType<Char_t,TBufferFile>,   new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kShort:   return TConfiguredAction( Looper::template WriteBasicType<Short_t>, Looper::template WriteBasicType<Short_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kInt:     return TConfiguredAction( Looper::template WriteBasicType<Int_t>, Looper::template WriteBasicType<Int_t,TBufferFile>,    new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kLong:    return TConfiguredAction( Looper::template WriteBasicType<Long_t>, Looper::template WriteBasicType<Long_t,TBufferFile>,   new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kLong64:  return TConfiguredAction( Looper::template WriteBasicType<Long64_t>, Looper::template WriteBasicType<Long64_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kFloat:   return TConfiguredAction( Looper::template WriteBasicType<Float_t>, Looper::template WriteBasicType<Float_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kDouble:  return TConfiguredAction( Looper::template WriteBasicType<Double_t>, Looper::template WriteBasicType<Double_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kUChar:   return TConfiguredAction( Looper::template WriteBasicType<UChar_t>, Looper::template WriteBasicType<UChar_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kUShort:  return TConfiguredAction( Looper::template WriteBasicType<UShort_t>, Looper::template WriteBasicType<UShort_t,TBufferFile>, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template WriteBasicType<UInt_t>, Looper::template WriteBasicType<UInt_t,TBufferFile>,   new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template WriteBasicType<ULong_t>, Looper::template WriteBasicType<ULong_t,TBufferFile>,  new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template WriteBasicType<ULong64_t>, Looper::template WriteBasicType<ULong64_t,TBufferFile>,new TConfiguration(info,i,compinfo,offset) ); break;
       // the simple type missing are kBits and kCounter.
       default:
          return TConfiguredAction( Looper::GenericWrite, new TConfiguration(info,i,compinfo,0 /* 0 because we call the legacy code */) );
@@ -3110,19 +3160,19 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
 
    switch (compinfo->fType) {
       // read basic types
-      case TStreamerInfo::kBool:    readSequence->AddAction( ReadBasicType<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kChar:    readSequence->AddAction( ReadBasicType<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kShort:   readSequence->AddAction( ReadBasicType<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kInt:     readSequence->AddAction( ReadBasicType<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
-      case TStreamerInfo::kLong:    readSequence->AddAction( ReadBasicType<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kLong64:  readSequence->AddAction( ReadBasicType<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kFloat:   readSequence->AddAction( ReadBasicType<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kDouble:  readSequence->AddAction( ReadBasicType<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kUChar:   readSequence->AddAction( ReadBasicType<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kUShort:  readSequence->AddAction( ReadBasicType<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kUInt:    readSequence->AddAction( ReadBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kBool:    readSequence->AddAction( ReadBasicType<Bool_t>, ReadBasicType<Bool_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kChar:    readSequence->AddAction( ReadBasicType<Char_t>, ReadBasicType<Char_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kShort:   readSequence->AddAction( ReadBasicType<Short_t>, ReadBasicType<Short_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kInt:     readSequence->AddAction( ReadBasicType<Int_t>, ReadBasicType<Int_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
+      case TStreamerInfo::kLong:    readSequence->AddAction( ReadBasicType<Long_t>, ReadBasicType<Long_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kLong64:  readSequence->AddAction( ReadBasicType<Long64_t>, ReadBasicType<Long64_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kFloat:   readSequence->AddAction( ReadBasicType<Float_t>, ReadBasicType<Float_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kDouble:  readSequence->AddAction( ReadBasicType<Double_t>, ReadBasicType<Double_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kUChar:   readSequence->AddAction( ReadBasicType<UChar_t>, ReadBasicType<UChar_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kUShort:  readSequence->AddAction( ReadBasicType<UShort_t>, ReadBasicType<UShort_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kUInt:    readSequence->AddAction( ReadBasicType<UInt_t>, ReadBasicType<UInt_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicType<ULong_t>, ReadBasicType<ULong_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicType<ULong64_t>, ReadBasicType<ULong64_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
       case TStreamerInfo::kBits:    readSequence->AddAction( ReadBasicType<BitsMarker>, new TBitsConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -3425,19 +3475,19 @@ void TStreamerInfo::AddWriteAction(TStreamerInfoActions::TActionSequence *writeS
    }
    switch (compinfo->fType) {
       // write basic types
-      case TStreamerInfo::kBool:    writeSequence->AddAction( WriteBasicType<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kChar:    writeSequence->AddAction( WriteBasicType<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kShort:   writeSequence->AddAction( WriteBasicType<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kInt:     writeSequence->AddAction( WriteBasicType<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
-      case TStreamerInfo::kLong:    writeSequence->AddAction( WriteBasicType<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kLong64:  writeSequence->AddAction( WriteBasicType<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kFloat:   writeSequence->AddAction( WriteBasicType<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kDouble:  writeSequence->AddAction( WriteBasicType<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kUChar:   writeSequence->AddAction( WriteBasicType<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kUShort:  writeSequence->AddAction( WriteBasicType<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
-      case TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
-      case TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
-      case TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kBool:    writeSequence->AddAction( WriteBasicType<Bool_t>, WriteBasicType<Bool_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kChar:    writeSequence->AddAction( WriteBasicType<Char_t>, WriteBasicType<Char_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kShort:   writeSequence->AddAction( WriteBasicType<Short_t>, WriteBasicType<Short_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kInt:     writeSequence->AddAction( WriteBasicType<Int_t>, WriteBasicType<Int_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
+      case TStreamerInfo::kLong:    writeSequence->AddAction( WriteBasicType<Long_t>, WriteBasicType<Long_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kLong64:  writeSequence->AddAction( WriteBasicType<Long64_t>, WriteBasicType<Long64_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kFloat:   writeSequence->AddAction( WriteBasicType<Float_t>, WriteBasicType<Float_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kDouble:  writeSequence->AddAction( WriteBasicType<Double_t>, WriteBasicType<Double_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kUChar:   writeSequence->AddAction( WriteBasicType<UChar_t>, WriteBasicType<UChar_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kUShort:  writeSequence->AddAction( WriteBasicType<UShort_t>, WriteBasicType<UShort_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicType<UInt_t>, WriteBasicType<UInt_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicType<ULong_t>, WriteBasicType<ULong_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicType<ULong64_t>, WriteBasicType<ULong64_t,TBufferFile>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
        // case TStreamerInfo::kBits:    writeSequence->AddAction( WriteBasicType<BitsMarker>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
      /*case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -3535,43 +3585,43 @@ void TStreamerInfo::AddWriteTextAction(TStreamerInfoActions::TActionSequence *wr
    switch (compinfo->fType) {
    // write basic types
    case TStreamerInfo::kBool:
-      writeSequence->AddAction(WriteBasicType<Bool_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Bool_t>, WriteBasicType<Bool_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kChar:
-      writeSequence->AddAction(WriteBasicType<Char_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Char_t>, WriteBasicType<Char_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kShort:
-      writeSequence->AddAction(WriteBasicType<Short_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Short_t>, WriteBasicType<Short_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kInt:
-      writeSequence->AddAction(WriteBasicType<Int_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Int_t>, WriteBasicType<Int_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kLong:
-      writeSequence->AddAction(WriteBasicType<Long_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Long_t>, WriteBasicType<Long_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kLong64:
-      writeSequence->AddAction(WriteBasicType<Long64_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Long64_t>, WriteBasicType<Long64_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kFloat:
-      writeSequence->AddAction(WriteBasicType<Float_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Float_t>, WriteBasicType<Float_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kDouble:
-      writeSequence->AddAction(WriteBasicType<Double_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<Double_t>, WriteBasicType<Double_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kUChar:
-      writeSequence->AddAction(WriteBasicType<UChar_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<UChar_t>, WriteBasicType<UChar_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kUShort:
-      writeSequence->AddAction(WriteBasicType<UShort_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<UShort_t>, WriteBasicType<UShort_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kUInt:
-      writeSequence->AddAction(WriteBasicType<UInt_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<UInt_t>, WriteBasicType<UInt_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kULong:
-      writeSequence->AddAction(WriteBasicType<ULong_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<ULong_t>, WriteBasicType<ULong_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
    case TStreamerInfo::kULong64:
-      writeSequence->AddAction(WriteBasicType<ULong64_t>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
+      writeSequence->AddAction(WriteBasicType<ULong64_t>, WriteBasicType<ULong64_t,TBufferFile>, new TConfiguration(this, i, compinfo, compinfo->fOffset));
       break;
 
    case TStreamerInfo::kTObject:
@@ -4065,7 +4115,7 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
        ++iter)
    {
       TConfiguration *conf = iter->fConfiguration->Copy();
-      sequence->AddAction( iter->fAction, conf );
+      sequence->AddAction( iter->fAction, iter->fFileAction, conf );
    }
    return sequence;
 }
@@ -4103,7 +4153,7 @@ void TStreamerInfoActions::TActionSequence::AddToSubSequence(TStreamerInfoAction
                TConfiguration *conf = iter->fConfiguration->Copy();
                if (!iter->fConfiguration->fInfo->GetElements()->At(iter->fConfiguration->fElemId)->TestBit(TStreamerElement::kCache))
                   conf->AddToOffset(offset);
-               sequence->AddAction( iter->fAction, conf );
+               sequence->AddAction( iter->fAction, iter->fFileAction, conf );
             }
          }
       } else {
@@ -4125,7 +4175,7 @@ void TStreamerInfoActions::TActionSequence::AddToSubSequence(TStreamerInfoAction
                TConfiguration *conf = iter->fConfiguration->Copy();
                if (!iter->fConfiguration->fInfo->GetElements()->At(iter->fConfiguration->fElemId)->TestBit(TStreamerElement::kCache))
                   conf->AddToOffset(offset);
-               sequence->AddAction( iter->fAction, conf );
+               sequence->AddAction( iter->fAction, iter->fFileAction, conf );
             }
          }
       }
@@ -4166,7 +4216,7 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
             TConfiguration *conf = iter->fConfiguration->Copy();
             if (!iter->fConfiguration->fInfo->GetElements()->At(iter->fConfiguration->fElemId)->TestBit(TStreamerElement::kCache))
                conf->AddToOffset(offset);
-            sequence->AddAction( iter->fAction, conf );
+            sequence->AddAction( iter->fAction, iter->fFileAction, conf );
          }
       } else {
          TStreamerInfoActions::ActionContainer_t::iterator end = fActions.end();
@@ -4177,7 +4227,7 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
                TConfiguration *conf = iter->fConfiguration->Copy();
                if (!iter->fConfiguration->fInfo->GetElements()->At(iter->fConfiguration->fElemId)->TestBit(TStreamerElement::kCache))
                   conf->AddToOffset(offset);
-               sequence->AddAction( iter->fAction, conf );
+               sequence->AddAction( iter->fAction, iter->fFileAction, conf );
             }
          }
       }
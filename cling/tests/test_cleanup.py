@@ -0,0 +1,54 @@
+"""
+Pytest tests of the removal of deleted objects from the directories and
+collections that reference them, run through cppyy.
+"""
+import pytest
+
+cppyy = pytest.importorskip("cppyy")
+
+
+class TestRecursiveRemove(object):
+    """
+    Test that deleted objects do not stay behind in directories and in the
+    collections held by directories.
+    """
+    @classmethod
+    def setup_class(klass):
+        cppyy.cppdef("""
+        #include "TDirectory.h"
+        #include "TList.h"
+        #include "TNamed.h"
+        #include "TROOT.h"
+        #include "TRef.h"
+
+        namespace cleanup_test {
+        using namespace CppyyLegacy;
+
+        // Delete an object that is appended to a directory (if direct) and
+        // also held by a list appended to that directory, and referenced
+        // through a TRef (so that a process id holds it as well).
+        bool delete_nested(const char *dirname, bool direct) {
+            TDirectory *dir = gROOT->mkdir(dirname);
+            if (!dir) return false;
+            TNamed *obj = new TNamed("obj", "");
+            TList *nested = new TList;
+            nested->SetName("nested");
+            dir->Append(nested);
+            nested->Add(obj);
+            if (direct) dir->Append(obj);
+            TRef ref(obj);
+
+            delete obj;
+            bool ok = nested->GetSize() == 0 && !dir->GetList()->FindObject("obj")
+                   && ref.GetObject() == nullptr;
+            gROOT->rmdir(dirname);
+            return ok;
+        }
+        }
+        """)
+
+    def test_delete_nested_only(self):
+        assert cppyy.gbl.cleanup_test.delete_nested("cleanup_nested", False)
+
+    def test_delete_direct_and_nested(self):
+        assert cppyy.gbl.cleanup_test.delete_nested("cleanup_both", True)
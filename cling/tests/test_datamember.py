@@ -0,0 +1,66 @@
+"""
+Pytest tests of the bulk data member access of the C API, run through cppyy.
+"""
+import pytest
+
+cppyy = pytest.importorskip("cppyy")
+
+
+class TestBulkDatamember(object):
+    """
+    Test that data members are gathered and scattered as raw bytes, except
+    for those that have no byte offset.
+    """
+    @classmethod
+    def setup_class(klass):
+        cppyy.cppdef("""
+        #include <stddef.h>
+
+        extern "C" {
+            size_t cppyy_get_scope(const char* scope_name);
+            int cppyy_datamember_index(size_t scope, const char* name);
+            int cppyy_gather_datamember(size_t scope, size_t idata,
+                void** objs, size_t nobjs, void* out, size_t out_stride);
+            int cppyy_scatter_datamember(size_t scope, size_t idata,
+                void** objs, size_t nobjs, const void* in, size_t in_stride);
+        }
+
+        namespace datamember_test {
+        struct Bits {
+            int      fValue;
+            unsigned fLow  : 3;
+            unsigned fHigh : 5;
+        };
+
+        // Gather, then scatter back incremented, member 'name' of two objects;
+        // returns false if either call refuses the member.
+        bool gather_scatter(const char *name, Bits &a, Bits &b) {
+            size_t scope = cppyy_get_scope("datamember_test::Bits");
+            int idata = cppyy_datamember_index(scope, name);
+            if (idata < 0) return false;
+            void *objs[] = {&a, &b};
+            int values[2] = {0, 0};
+            if (!cppyy_gather_datamember(scope, idata, objs, 2, values, 0))
+                return false;
+            values[0] += 1; values[1] += 1;
+            return cppyy_scatter_datamember(scope, idata, objs, 2, values, 0);
+        }
+
+        bool check_plain() {
+            Bits a{1, 2, 3}, b{10, 4, 5};
+            return gather_scatter("fValue", a, b) && a.fValue == 2 && b.fValue == 11;
+        }
+
+        bool check_bitfield() {
+            Bits a{1, 2, 3}, b{10, 4, 5};
+            return !gather_scatter("fLow", a, b) && !gather_scatter("fHigh", a, b)
+                && a.fLow == 2 && a.fHigh == 3 && b.fLow == 4 && b.fHigh == 5;
+        }
+        }
+        """)
+
+    def test_plain(self):
+        assert cppyy.gbl.datamember_test.check_plain()
+
+    def test_bitfield(self):
+        assert cppyy.gbl.datamember_test.check_bitfield()
@@ -0,0 +1,70 @@
+"""
+Pytest tests of TDirectoryFile incremental keys records, run through cppyy.
+"""
+import os
+import pytest
+
+cppyy = pytest.importorskip("cppyy")
+
+
+class TestTDirectoryFileIncrementalKeys(object):
+    """
+    Test that keys flushed as delta records read back correctly.
+    """
+    @classmethod
+    def setup_class(klass):
+        cppyy.cppdef("""
+        #include "TFile.h"
+        #include "TKey.h"
+        #include "TNamed.h"
+
+        namespace tdirectoryfile_test {
+        using namespace CppyyLegacy;
+
+        // Return the title of the object 'name' in dir, or "" if absent.
+        std::string title_of(TDirectory *dir, const char *name) {
+            TNamed *obj = dynamic_cast<TNamed*>(dir->Get(name));
+            std::string title = obj ? obj->GetTitle() : "";
+            delete obj;
+            return title;
+        }
+
+        // Check that fname has exactly the keys a and b, with the given titles.
+        bool check_file(const char *fname, const char *title_a, const char *title_b) {
+            TFile *f = TFile::Open(fname, "READ");
+            if (!f) return false;
+            bool ok = f->GetListOfKeys()->GetSize() == 2
+                   && title_of(f, "a") == title_a && title_of(f, "b") == title_b;
+            delete f;
+            return ok;
+        }
+
+        // Write two objects, flush, overwrite one with an object of the same
+        // size (so that it reuses the freed slot), flush again and check the
+        // file while it is still open and after it is closed.
+        bool write_overwrite_reopen(const char *fname) {
+            TFile *f = TFile::Open(fname, "RECREATE");
+            if (!f) return false;
+            f->SetIncrementalKeys();
+            TNamed("a", "first").Write();
+            TNamed("b", "other").Write();
+            f->SaveSelf();
+            f->Flush();
+            bool ok = check_file(fname, "first", "other");
+
+            TNamed("a", "again").Write(nullptr, TObject::kOverwrite);
+            f->SaveSelf();
+            f->Flush();
+            ok = ok && check_file(fname, "again", "other");
+
+            TNamed("b", "final").Write(nullptr, TObject::kOverwrite);
+            f->Close();
+            delete f;
+            return ok && check_file(fname, "again", "final");
+        }
+        }
+        """)
+
+    def test_write_overwrite_reopen(self, tmpdir):
+        fname = os.path.join(str(tmpdir), "incremental_keys.root")
+        assert cppyy.gbl.tdirectoryfile_test.write_overwrite_reopen(fname)
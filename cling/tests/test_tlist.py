@@ -0,0 +1,51 @@
+"""
+Pytest tests of TList, run through cppyy.
+"""
+import pytest
+
+cppyy = pytest.importorskip("cppyy")
+
+
+class TestTList(object):
+    """
+    Test TList link handling.
+    """
+    @classmethod
+    def setup_class(klass):
+        cppyy.cppdef("""
+        #include "TList.h"
+        #include "TNamed.h"
+
+        namespace tlist_test {
+        // Delete the list while an iterator is parked on its link 'parked',
+        // then move and destroy the iterator.
+        bool delete_with_parked_iterator(int parked, const char *option) {
+            using namespace CppyyLegacy;
+            TList *list = new TList;
+            for (int i = 0; i < 3; ++i)
+                list->Add(new TNamed(Form("obj%d", i), ""));
+            bool ok = true;
+            {
+                TIter next(list);
+                for (int i = 0; i <= parked; ++i)
+                    ok = ok && next() != nullptr;
+                list->Delete(option);
+                ok = ok && list->GetSize() == 0 && next() == nullptr;
+            }
+            delete list;
+            return ok;
+        }
+        }
+        """)
+
+    def test_delete_fast_parked_first(self):
+        assert cppyy.gbl.tlist_test.delete_with_parked_iterator(0, "")
+
+    def test_delete_fast_parked_middle(self):
+        assert cppyy.gbl.tlist_test.delete_with_parked_iterator(1, "")
+
+    def test_delete_fast_parked_last(self):
+        assert cppyy.gbl.tlist_test.delete_with_parked_iterator(2, "")
+
+    def test_delete_slow_parked_middle(self):
+        assert cppyy.gbl.tlist_test.delete_with_parked_iterator(1, "slow")
@@ -184,6 +184,11 @@ extern "C" {
     char* cppyy_method_arg_type(cppyy_method_t, int arg_index);
     RPY_EXPORTED
     char* cppyy_method_arg_default(cppyy_method_t, int arg_index);
+    /* returns the kind of default (see Cppyy::EDefaultKind); the value is stored in
+       ival (integers, with unsigned ones as their bit pattern), dval or sval (to be
+       freed by the caller), with the length of sval, which may hold NULs, in slen */
+    RPY_EXPORTED
+    int cppyy_method_arg_default_value(cppyy_method_t, int arg_index, long long* ival, double* dval, char** sval, size_t* slen);
     RPY_EXPORTED
     char* cppyy_method_signature(cppyy_method_t, int show_formalargs);
     RPY_EXPORTED
@@ -254,6 +259,14 @@ extern "C" {
     RPY_EXPORTED
     int cppyy_get_dimension_size(cppyy_scope_t scope, cppyy_index_t idata, int dimension);
 
+    /* bulk data member access ------------------------------------------------ */
+    RPY_EXPORTED
+    int cppyy_gather_datamember(cppyy_scope_t scope, cppyy_index_t idata,
+        cppyy_object_t* objs, size_t nobjs, void* out, size_t out_stride);
+    RPY_EXPORTED
+    int cppyy_scatter_datamember(cppyy_scope_t scope, cppyy_index_t idata,
+        cppyy_object_t* objs, size_t nobjs, const void* in, size_t in_stride);
+
     /* enum properties -------------------------------------------------------- */
     RPY_EXPORTED
     cppyy_enum_t  cppyy_get_enum(cppyy_scope_t scope, const char* enum_name);
@@ -263,6 +276,10 @@ extern "C" {
     const char*   cppyy_get_enum_data_name(cppyy_enum_t, cppyy_index_t idata);
     RPY_EXPORTED
     long long     cppyy_get_enum_data_value(cppyy_enum_t, cppyy_index_t idata);
+    RPY_EXPORTED
+    cppyy_index_t cppyy_get_enum_data(cppyy_enum_t, const char** names, long long* values);
+    RPY_EXPORTED
+    char*         cppyy_get_enum_data_name_from_value(cppyy_enum_t, long long value);
 
     /* misc helpers ----------------------------------------------------------- */
     RPY_EXPORTED
@@ -289,6 +306,31 @@ extern "C" {
     RPY_EXPORTED
     void        cppyy_vectorbool_setitem(cppyy_object_t ptr, int idx, int value);
 
+    /* bulk conversions: "bits" are packed LSB first, "bytes" hold one 0/1 per
+       element; strings are a concatenated buffer plus n+1 offsets into it ---- */
+    RPY_EXPORTED
+    void        cppyy_vectorbool_tobits(cppyy_object_t ptr, unsigned char* bits);
+    RPY_EXPORTED
+    void        cppyy_vectorbool_frombits(cppyy_object_t ptr, const unsigned char* bits, size_t nbits);
+    RPY_EXPORTED
+    void        cppyy_vectorbool_tobytes(cppyy_object_t ptr, unsigned char* bytes);
+    RPY_EXPORTED
+    void        cppyy_vectorbool_frombytes(cppyy_object_t ptr, const unsigned char* bytes, size_t n);
+    RPY_EXPORTED
+    void        cppyy_bitset_tobits(cppyy_object_t ptr, size_t nbits, unsigned char* bits);
+    RPY_EXPORTED
+    void        cppyy_bitset_frombits(cppyy_object_t ptr, size_t nbits, const unsigned char* bits);
+    RPY_EXPORTED
+    void        cppyy_bitset_tobytes(cppyy_object_t ptr, size_t nbits, unsigned char* bytes);
+    RPY_EXPORTED
+    void        cppyy_bitset_frombytes(cppyy_object_t ptr, size_t nbits, const unsigned char* bytes);
+    RPY_EXPORTED
+    size_t      cppyy_vectorstring_nbytes(cppyy_object_t ptr);
+    RPY_EXPORTED
+    void        cppyy_vectorstring_tobuffer(cppyy_object_t ptr, char* data, size_t* offsets);
+    RPY_EXPORTED
+    void        cppyy_vectorstring_frombuffer(cppyy_object_t ptr, const char* data, const size_t* offsets, size_t n);
+
 #ifdef __cplusplus
 }
 #endif // ifdef __cplusplus
@@ -41,16 +41,22 @@
 // Standard
 #include <assert.h>
 #include <algorithm>     // for std::count, std::remove
+#include <atomic>
+#include <condition_variable>
 #include <stdexcept>
+#include <fstream>
 #include <map>
+#include <mutex>
 #include <new>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <signal.h>
+#include <stdio.h>       // for snprintf, rename, remove
 #include <stdlib.h>      // for getenv
 #include <string.h>
 #include <typeinfo>
+#include <unordered_map>
 
 #if defined(__arm64__)
 #include <exception>
@@ -132,6 +138,11 @@ class CallWrapper {
 public:
     typedef const void* DeclId_t;
 
+// state of the interface pointer of each calling mode (generic and direct); it
+// is compiled once on first use, by one thread, while the others wait for it
+    enum EState { kNotCompiled, kCompiling, kReady, kFailed };
+    enum EMode  { kGeneric = 0, kDirect = 1 };
+
 public:
     CallWrapper(TFunction* f) : fDecl(f->GetDeclId()), fName(f->GetName()), fTF(new TFunction(*f)) {}
     CallWrapper(DeclId_t fid, const std::string& n) : fDecl(fid), fName(n), fTF(nullptr) {}
@@ -140,7 +151,9 @@ public:
     }
 
 public:
-    TInterpreter::CallFuncIFacePtr_t fFaceptr;
+    TInterpreter::CallFuncIFacePtr_t fFaceptr[2];      // valid once fState is kReady
+    std::atomic<int>       fState[2]    = {{kNotCompiled}, {kNotCompiled}};
+    std::atomic<ULong64_t> fFailedAt[2] = {{0}, {0}};  // interpreter state of the last failure
     DeclId_t      fDecl;
     std::string   fName;
     TFunction*    fTF;
@@ -383,23 +396,270 @@ char* cppstring_to_cstring(const std::string& cppstr)
     return cstr;
 }
 
+// per-scope name lookup tables -----------------------------------------------
+// Built lazily from the scope's list of methods (data members) and rebuilt once
+// declarations were added to the scope, as judged by the same interpreter state
+// marker that makes TListOfFunctions (TListOfDataMembers) reload.
+namespace {
+
+template<typename T>
+struct ScopeNameTable {
+    ULong64_t fMarker = 0;         // GetDeclStateMarker() before the build
+    int       fSize   = -1;        // size of the list at the time of the build
+    std::unordered_map<std::string, T> fNames;
+
+    bool is_current(ClassInfo_t* ci, TCollection* coll) const {
+        return fSize == coll->GetSize() && gInterpreter->GetScopeStateMarker(ci) <= fMarker;
+    }
+
+    void reset(ULong64_t marker, TCollection* coll) {
+        fMarker = marker;
+        fSize   = coll->GetSize();
+        fNames.clear();
+    }
+};
+
+typedef ScopeNameTable<std::vector<Cppyy::TCppIndex_t>> MethodTable_t;
+typedef ScopeNameTable<std::vector<TFunction*>>         GlobalFunctionTable_t;
+typedef ScopeNameTable<Cppyy::TCppIndex_t>              DatamemberTable_t;
+
+static std::unordered_map<Cppyy::TCppScope_t, MethodTable_t>     g_method_tables;
+static GlobalFunctionTable_t                                      g_global_function_table;
+static std::unordered_map<Cppyy::TCppScope_t, DatamemberTable_t> g_datamember_tables;
+
+// call f for each name under which function fname is found: either match exactly,
+// or match the name as template (i.e. each prefix that is followed by a '<')
+template<typename F>
 static inline
-bool match_name(const std::string& tname, const std::string fname)
+void for_each_match_name(const std::string& fname, F f)
+{
+    f(fname);
+    for (std::string::size_type pos = fname.find('<', 1); pos != std::string::npos; pos = fname.find('<', pos+1))
+        f(fname.substr(0, pos));
+}
+
+static const MethodTable_t& get_method_table(Cppyy::TCppScope_t scope, TClassRef& cr)
 {
-// either match exactly, or match the name as template
-    if (fname.rfind(tname, 0) == 0) {
-        if ((tname.size() == fname.size()) ||
-              (tname.size() < fname.size() && fname[tname.size()] == '<'))
-           return true;
+    MethodTable_t& table = g_method_tables[scope];
+    ULong64_t marker = gInterpreter->GetDeclStateMarker();
+    TCollection* methods = cr->GetListOfMethods();
+    if (table.is_current(cr->GetClassInfo(), methods))
+        return table;
+
+    table.reset(marker, methods);
+    Cppyy::TCppIndex_t imeth = 0;
+    TFunction* func = nullptr;
+    TIter next(methods);
+    while ((func = (TFunction*)next())) {
+    // C++ functions should be public to allow access; C functions have no access
+    // specifier and should always be accepted
+        auto prop = func->Property();
+        if ((prop & kIsPublic) || !(prop & (kIsPrivate | kIsProtected | kIsPublic)))
+            for_each_match_name(func->GetName(),
+                [&](const std::string& n) { table.fNames[n].push_back(imeth); });
+        ++imeth;
     }
-    return false;
+    return table;
+}
+
+static const GlobalFunctionTable_t& get_global_function_table(TCollection* funcs)
+{
+    GlobalFunctionTable_t& table = g_global_function_table;
+    if (table.is_current(nullptr, funcs))
+        return table;
+
+    table.reset(gInterpreter->GetDeclStateMarker(), funcs);
+    TFunction* func = nullptr;
+    TIter ifunc(funcs);
+    while ((func = (TFunction*)ifunc.Next()))
+        for_each_match_name(func->GetName(),
+            [&](const std::string& n) { table.fNames[n].push_back(func); });
+    return table;
 }
 
+static const DatamemberTable_t& get_datamember_table(Cppyy::TCppScope_t scope, TClassRef& cr)
+{
+    DatamemberTable_t& table = g_datamember_tables[scope];
+    ULong64_t marker = gInterpreter->GetDeclStateMarker();
+    TCollection* members = cr->GetListOfDataMembers();
+    if (table.is_current(cr->GetClassInfo(), members))
+        return table;
+
+    table.reset(marker, members);
+    Cppyy::TCppIndex_t idata = 0;
+    TObject* dm = nullptr;
+    TIter next(members);
+    while ((dm = next()))   // first one wins, as with FindObject()
+        table.fNames.emplace(dm->GetName(), idata++);
+    return table;
+}
+
+} // unnamed namespace
+
+
+// persistent cache of compiled code -----------------------------------------
+// Opt-in with CPPYY_COMPILE_CACHE=<directory>: the code of each successful
+// Compile() is stored there (up to CPPYY_COMPILE_CACHE_SIZE MB, default 4), in a
+// sub-directory "scope.<scope>" per application, as chosen by the loader through
+// CPPYY_COMPILE_CACHE_SCOPE (see cppyy_backend/loader.py). On exit, the keys of the
+// snippets this run asked for are written, in order, to the file "last" of the
+// scope, after a first line "app <stamp>" that identifies the version of the
+// application (CPPYY_COMPILE_CACHE_STAMP). On the next start of the same version,
+// the loader builds a precompiled header that includes those snippets only,
+// listing their keys in "<pch>.snippets", after a first line "pch <size> <mtime>"
+// that identifies the PCH it describes. Compiling such a snippet again is then a
+// no-op, as its declarations were loaded with the PCH. Code of other applications,
+// of other versions of the application, and code that the last run did not ask for
+// is thus never visible. The loader creates "disabled" in the directory if the
+// header can not be built, which turns the cache off.
+namespace {
+
+class CompileCache {
+    std::string              fDir;          // empty if the cache is off
+    std::string              fStamp;        // version of the application
+    std::string              fPid;          // for temporary file names, also on exit
+    size_t                   fMaxSize;      // cap on the total size of stored code
+    size_t                   fSize;         // total size of stored code
+    std::set<std::string>    fKnown;        // keys already stored
+    std::set<std::string>    fPreloaded;    // keys of the snippets in the current PCH, not yet asked for
+    std::vector<std::string> fRequested;    // keys asked for by this run, in order
+    std::set<std::string>    fRequestedSet;
+    std::mutex               fMutex;
+
+    void Request(const std::string& key) {
+        if (fRequestedSet.insert(key).second) fRequested.push_back(key);
+    }
+
+public:
+    CompileCache() : fMaxSize(4*1024*1024), fSize(0) {
+        const char* dir = getenv("CPPYY_COMPILE_CACHE");
+        const char* scope = getenv("CPPYY_COMPILE_CACHE_SCOPE");
+        if (!dir || !dir[0] || !scope || !scope[0] ||
+                std::ifstream(std::string(dir)+"/disabled").good())
+            return;
+        fDir = std::string(dir)+"/scope."+scope;
+        if (gSystem->AccessPathName(fDir.c_str()) && gSystem->mkdir(fDir.c_str(), kTRUE) != 0) {
+            fDir.clear();
+            return;
+        }
+        const char* stamp = getenv("CPPYY_COMPILE_CACHE_STAMP");
+        fStamp = stamp && stamp[0] ? stamp : "-";
+        fPid = std::to_string(gSystem->GetPid());
+        if (const char* maxsize = getenv("CPPYY_COMPILE_CACHE_SIZE"))
+            fMaxSize = (size_t)atol(maxsize)*1024*1024;
+
+    // manifest: one "<key> <size>" line per stored snippet, in order of first use
+        std::ifstream manifest(fDir+"/manifest");
+        std::string key; size_t sz = 0;
+        while (manifest >> key >> sz) {
+            if (fKnown.insert(key).second) fSize += sz;
+        }
+
+    // only trust the list if it was written for this very PCH: a PCH rebuilt since
+    // (e.g. by a child process that inherited the setting) holds no snippets
+        if (const char* pch = getenv("CLING_STANDARD_PCH")) {
+            std::ifstream snippets(std::string(pch)+".snippets");
+            std::string tag; Long64_t size = -1; Long_t mtime = -1;
+            FileStat_t st;
+            if (snippets >> tag >> size >> mtime && tag == "pch" &&
+                    gSystem->GetPathInfo(pch, st) == 0 && st.fSize == size && st.fMtime == mtime) {
+                while (snippets >> key) fPreloaded.insert(key);
+            }
+        }
+    }
+
+    ~CompileCache() {
+    // record what this run asked for, to be preloaded by the next run; an empty list
+    // is written as well, so that nothing stale is preloaded
+        if (fDir.empty())
+            return;
+        const std::string last = fDir+"/last";
+        const std::string tmpname = last+".tmp"+fPid;
+        {
+            std::ofstream out(tmpname);
+            out << "app " << fStamp << '\n';
+            for (const auto& key : fRequested) out << key << '\n';
+            if (!out) { out.close(); std::remove(tmpname.c_str()); return; }
+        }
+        if (std::rename(tmpname.c_str(), last.c_str()) != 0)
+            std::remove(tmpname.c_str());
+    }
+
+    static std::string Key(const std::string& code) {
+    // FNV-1a: the key has to be stable between processes and builds
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : code) { h ^= c; h *= 1099511628211ull; }
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+        return buf;
+    }
+
+    bool Preloaded(const std::string& key) {
+        std::lock_guard<std::mutex> lock(fMutex);
+    // only the first Compile() is satisfied by the PCH, a repeat is passed on as before
+        if (fPreloaded.erase(key) == 0)
+            return false;
+        Request(key);
+        return true;
+    }
+
+    void Store(const std::string& key, const std::string& code) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (fDir.empty())
+            return;
+        if (fKnown.count(key)) {
+            Request(key);
+            return;
+        }
+        if (fMaxSize < fSize + code.size())
+            return;
+
+    // write under a temporary name first, so the loader never sees a partial file
+        const std::string fname = fDir+"/"+key+".h";
+        const std::string tmpname = fname+".tmp"+fPid;
+        {
+            std::ofstream out(tmpname, std::ios::binary);
+            out << code << '\n';
+            if (!out) { out.close(); std::remove(tmpname.c_str()); return; }
+        }
+        if (std::rename(tmpname.c_str(), fname.c_str()) != 0) {
+            std::remove(tmpname.c_str());
+            return;
+        }
+        std::ofstream(fDir+"/manifest", std::ios::app) << key << ' ' << code.size() << '\n';
+        fKnown.insert(key);
+        fSize += code.size();
+        Request(key);
+    }
+
+    bool Enabled() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return !fDir.empty() || !fPreloaded.empty();
+    }
+};
+
+CompileCache& compile_cache() {
+    static CompileCache cache;
+    return cache;
+}
+
+} // unnamed namespace
+
 
 // direct interpreter access -------------------------------------------------
 bool Cppyy::Compile(const std::string& code, bool silent)
 {
-    return gInterpreter->Declare(code.c_str(), silent);
+    CompileCache& cache = compile_cache();
+    if (!cache.Enabled())
+        return gInterpreter->Declare(code.c_str(), silent);
+
+    const std::string key = CompileCache::Key(code);
+    if (cache.Preloaded(key))
+        return true;
+
+    bool result = gInterpreter->Declare(code.c_str(), silent);
+    if (result) cache.Store(key, code);
+    return result;
 }
 
 std::string Cppyy::ToString(TCppType_t klass, TCppObject_t obj)
@@ -793,11 +1053,9 @@ void Cppyy::Destruct(TCppType_t type, TCppObject_t instance)
 
 
 // method/function dispatching -----------------------------------------------
-static TInterpreter::CallFuncIFacePtr_t GetCallFunc(Cppyy::TCppMethod_t method, bool as_iface)
+static bool GetCallFunc(CallWrapper* wrap, bool as_iface, TInterpreter::CallFuncIFacePtr_t& faceptr)
 {
 // TODO: method should be a callfunc, so that no mapping would be needed.
-    CallWrapper* wrap = (CallWrapper*)method;
-
     CallFunc_t* callf = gInterpreter->CallFunc_Factory();
     MethodInfo_t* meth = gInterpreter->MethodInfo_Factory(wrap->fDecl);
     gInterpreter->CallFunc_SetFunc(callf, meth);
@@ -811,19 +1069,78 @@ static TInterpreter::CallFuncIFacePtr_t GetCallFunc(Cppyy::TCppMethod_t method,
             wrap.fName, callString.c_str()); */
         std::cerr << "TODO: report unresolved function error to Python\n";
         if (callf) gInterpreter->CallFunc_Delete(callf);
-        return TInterpreter::CallFuncIFacePtr_t{};
+        return false;
     }
 
 // generate the wrapper and JIT it; ignore wrapper generation errors (will simply
 // result in a nullptr that is reported upstream if necessary; often, however,
-// there is a different overload available that will do)
-    auto oldErrLvl = gErrorIgnoreLevel;
-    gErrorIgnoreLevel = kFatal;
-    wrap->fFaceptr = gInterpreter->CallFunc_IFacePtr(callf, as_iface);
-    gErrorIgnoreLevel = oldErrLvl;
+// there is a different overload available that will do); the messages are only
+// silenced for this thread
+    Int_t oldErrLvl = SetThreadErrorIgnoreLevel(kFatal);
+// free functions and static methods of a common signature share a wrapper, which
+// then takes the function pointer (fTarget) in place of self
+    faceptr = gInterpreter->CallFunc_IFacePtr(callf, as_iface, true /* allow_shared */);
+    SetThreadErrorIgnoreLevel(oldErrLvl);
 
     gInterpreter->CallFunc_Delete(callf);   // does not touch IFacePtr
-    return wrap->fFaceptr;
+    return as_iface ? (bool)faceptr.fGeneric : (bool)faceptr.fDirect;
+}
+
+// threads that find a wrapper being compiled wait on the slot it hashes to, but
+// only for the state of that wrapper to change
+namespace {
+    struct WrapperWaitSlot {
+        std::mutex              fMutex;
+        std::condition_variable fCond;
+    };
+    static WrapperWaitSlot gWrapperWaitSlots[64];
+
+    static inline WrapperWaitSlot& wait_slot(const CallWrapper* wrap) {
+        return gWrapperWaitSlots[((uintptr_t)wrap >> 4) % 64];
+    }
+}
+
+static const TInterpreter::CallFuncIFacePtr_t* GetFacePtr(CallWrapper* wrap, bool is_direct)
+{
+// return the interface pointer for the calling mode, compiling it on first use;
+// a failure is remembered (returning nullptr right away) until the interpreter
+// state changes, e.g. because more code was declared
+    const int mode = is_direct ? CallWrapper::kDirect : CallWrapper::kGeneric;
+    std::atomic<int>& state = wrap->fState[mode];
+
+    int current = state.load(std::memory_order_acquire);
+    while (true) {
+        if (current == CallWrapper::kReady)
+            return &wrap->fFaceptr[mode];
+
+        if (current == CallWrapper::kFailed &&
+                wrap->fFailedAt[mode].load(std::memory_order_relaxed) == gInterpreter->GetInterpreterStateMarker())
+            return nullptr;
+
+        if (current == CallWrapper::kCompiling) {
+            WrapperWaitSlot& slot = wait_slot(wrap);
+            std::unique_lock<std::mutex> lock(slot.fMutex);
+            slot.fCond.wait(lock, [&state] {
+                return state.load(std::memory_order_acquire) != CallWrapper::kCompiling; });
+            current = state.load(std::memory_order_acquire);
+            continue;
+        }
+
+    // not compiled, or failed for an earlier interpreter state: claim it
+        if (state.compare_exchange_weak(current, CallWrapper::kCompiling, std::memory_order_acquire))
+            break;
+    }
+
+    bool ok = GetCallFunc(wrap, !is_direct, wrap->fFaceptr[mode]);
+    if (!ok) wrap->fFailedAt[mode].store(gInterpreter->GetInterpreterStateMarker(), std::memory_order_relaxed);
+
+    WrapperWaitSlot& slot = wait_slot(wrap);
+    {
+        std::lock_guard<std::mutex> lock(slot.fMutex);
+        state.store(ok ? CallWrapper::kReady : CallWrapper::kFailed, std::memory_order_release);
+    }
+    slot.fCond.notify_all();
+    return ok ? &wrap->fFaceptr[mode] : nullptr;
 }
 
 static inline
@@ -856,11 +1173,6 @@ void release_args(Parameter* args, size_t nargs) {
     }
 }
 
-static inline
-bool is_ready(CallWrapper* wrap, bool is_direct) {
-    return (!is_direct && wrap->fFaceptr.fGeneric) || (is_direct && wrap->fFaceptr.fDirect);
-}
-
 static inline
 bool WrapperCall(Cppyy::TCppMethod_t method, size_t nargs, void* args_, void* self, void* result)
 {
@@ -868,16 +1180,16 @@ bool WrapperCall(Cppyy::TCppMethod_t method, size_t nargs, void* args_, void* se
     bool is_direct = nargs & DIRECT_CALL;
     nargs = CALL_NARGS(nargs);
 
-    CallWrapper* wrap = (CallWrapper*)method;
-    const TInterpreter::CallFuncIFacePtr_t& faceptr = \
-        is_ready(wrap, is_direct) ? wrap->fFaceptr : GetCallFunc(method, !is_direct);
-    if (!is_ready(wrap, is_direct))
+    const TInterpreter::CallFuncIFacePtr_t* pfaceptr = GetFacePtr((CallWrapper*)method, is_direct);
+    if (!pfaceptr)
         return false;        // happens with compilation error
+    const TInterpreter::CallFuncIFacePtr_t& faceptr = *pfaceptr;
 
     nargs = CALL_NARGS(nargs);
     if (faceptr.fKind == TInterpreter::CallFuncIFacePtr_t::kGeneric) {
         bool runRelease = false;
         const auto& fgen = is_direct ? faceptr.fDirect : faceptr.fGeneric;
+        if (faceptr.fTarget) self = faceptr.fTarget;
         if (nargs <= SMALL_ARGS_N) {
             void* smallbuf[SMALL_ARGS_N];
             if (nargs) runRelease = copy_args(args, nargs, smallbuf);
@@ -1527,19 +1839,10 @@ std::vector<Cppyy::TCppIndex_t> Cppyy::GetMethodIndicesFromName(
         if (!cr->GetMethodAny(name.c_str()))
             return indices;
 
-        int imeth = 0;
-        TFunction* func = nullptr;
-        TIter next(cr->GetListOfMethods());
-        while ((func = (TFunction*)next())) {
-            if (match_name(name, func->GetName())) {
-            // C++ functions should be public to allow access; C functions have no access
-            // specifier and should always be accepted
-                auto prop = func->Property();
-                if ((prop & kIsPublic) || !(prop & (kIsPrivate | kIsProtected | kIsPublic)))
-                    indices.push_back((TCppIndex_t)imeth);
-            }
-            ++imeth;
-        }
+        const MethodTable_t& table = get_method_table(scope, cr);
+        auto imeths = table.fNames.find(name);
+        if (imeths != table.fNames.end())
+            indices = imeths->second;
     } else if (scope == GLOBAL_HANDLE) {
         TCollection* funcs = gROOT->GetListOfGlobalFunctions(true);
 
@@ -1547,10 +1850,10 @@ std::vector<Cppyy::TCppIndex_t> Cppyy::GetMethodIndicesFromName(
         if (!funcs->FindObject(name.c_str()))
             return indices;
 
-        TFunction* func = nullptr;
-        TIter ifunc(funcs);
-        while ((func = (TFunction*)ifunc.Next())) {
-            if (match_name(name, func->GetName()))
+        const GlobalFunctionTable_t& table = get_global_function_table(funcs);
+        auto ifuncs = table.fNames.find(name);
+        if (ifuncs != table.fNames.end()) {
+            for (auto func : ifuncs->second)
                 indices.push_back((TCppIndex_t)new_CallWrapper(func));
         }
     }
@@ -1691,6 +1994,48 @@ std::string Cppyy::GetMethodArgDefault(TCppMethod_t method, TCppIndex_t iarg)
     return "";
 }
 
+Cppyy::TCppDefaultValue_t Cppyy::GetMethodArgDefaultValue(TCppMethod_t method, TCppIndex_t iarg)
+{
+    TCppDefaultValue_t value;
+    if (!method)
+        return value;
+
+    TFunction* f = m2f(method);
+    TMethodArg* arg = (TMethodArg*)f->GetListOfMethodArgs()->At((int)iarg);
+    if (!arg)
+        return value;
+
+    typedef TInterpreter::DefaultArgValue_t DefaultArgValue_t;
+    DefaultArgValue_t folded = arg->GetDefaultValue();
+    switch (folded.fKind) {
+    case DefaultArgValue_t::kNone:
+        break;
+    case DefaultArgValue_t::kInteger:
+        value.fKind = kIntDefault;
+        value.fInt  = (long long)folded.fInt;
+        break;
+    case DefaultArgValue_t::kUnsigned:
+        value.fKind = kUIntDefault;
+        value.fUInt = (unsigned long long)folded.fUInt;
+        break;
+    case DefaultArgValue_t::kFloat:
+        value.fKind  = kFloatDefault;
+        value.fFloat = folded.fFloat;
+        break;
+    case DefaultArgValue_t::kNullPointer:
+        value.fKind = kNullPtrDefault;
+        break;
+    case DefaultArgValue_t::kString:
+        value.fKind   = kStringDefault;
+        value.fString = std::move(folded.fString);
+        break;
+    default:
+        value.fKind = kRuntimeDefault;
+        break;
+    }
+    return value;
+}
+
 std::string Cppyy::GetMethodSignature(TCppMethod_t method, bool show_formalargs, TCppIndex_t maxargs)
 {
     TFunction* f = m2f(method);
@@ -2208,9 +2553,14 @@ Cppyy::TCppIndex_t Cppyy::GetDatamemberIndex(TCppScope_t scope, const std::strin
     } else {
         TClassRef& cr = type_from_handle(scope);
         if (cr.GetClass()) {
+            const DatamemberTable_t& table = get_datamember_table(scope, cr);
+            auto idata = table.fNames.find(name);
+            if (idata != table.fNames.end())
+                return idata->second;
+
+        // not (yet) loaded: the lookup may pull it in, after which the table is stale
             TDataMember* dm =
                 (TDataMember*)cr->GetListOfDataMembers()->FindObject(name.c_str());
-            // TODO: turning this into an index is silly ...
             if (dm) return (TCppIndex_t)cr->GetListOfDataMembers()->IndexOf(dm);
         }
     }
@@ -2336,6 +2686,112 @@ int Cppyy::GetDimensionSize(TCppScope_t scope, TCppIndex_t idata, int dimension)
 }
 
 
+// bulk data member access ---------------------------------------------------
+static bool get_member_layout(
+    Cppyy::TCppScope_t scope, Cppyy::TCppIndex_t idata, bool for_write, intptr_t& offset, size_t& size)
+{
+// only non-static members of builtin, enum, or pointer type (and fixed size arrays
+// thereof) are copied as raw bytes; anything else, including bitfields, which do
+// not start at a byte offset, needs a converter
+    if (scope == GLOBAL_HANDLE)
+        return false;
+
+    TClassRef& cr = type_from_handle(scope);
+    if (!cr.GetClass() || !cr->GetListOfDataMembers())
+        return false;
+
+    TDataMember* m = (TDataMember*)cr->GetListOfDataMembers()->At((int)idata);
+    if (!m) return false;
+
+    Long_t property = m->Property();
+    if ((property & (kIsStatic | kIsBitfield)) || (for_write && Cppyy::IsConstData(scope, idata)))
+        return false;
+
+    if (m->IsaPointer() || m->IsBasic())
+        size = (size_t)m->GetUnitSize();
+    else if (m->IsEnum())     // TDataMember assumes int for all enums
+        size = Cppyy::SizeOf(Cppyy::ResolveEnum(m->GetTrueTypeName()));
+    else
+        return false;
+
+    for (int dim = 0; dim < m->GetArrayDim(); ++dim) {
+        if (m->GetMaxIndex(dim) <= 0) return false;
+        size *= (size_t)m->GetMaxIndex(dim);
+    }
+
+    offset = (intptr_t)m->GetOffsetCint();    // CINT, see GetDatamemberOffset
+    return size && offset != (intptr_t)-1;
+}
+
+template<size_t N>
+static inline void gather_fixed(char** objs, size_t nobjs, intptr_t offset, char* out, size_t stride)
+{
+// fixed size copies compile down to a single load/store, keeping the loop tight
+    for (size_t i = 0; i < nobjs; ++i, out += stride) {
+        if (objs[i]) memcpy(out, objs[i]+offset, N);
+        else memset(out, 0, N);
+    }
+}
+
+template<size_t N>
+static inline void scatter_fixed(char** objs, size_t nobjs, intptr_t offset, const char* in, size_t stride)
+{
+    for (size_t i = 0; i < nobjs; ++i, in += stride) {
+        if (objs[i]) memcpy(objs[i]+offset, in, N);
+    }
+}
+
+bool Cppyy::GatherDatamember(TCppScope_t scope, TCppIndex_t idata,
+    TCppObject_t* objs, size_t nobjs, void* out, size_t out_stride)
+{
+// Copy data member idata of each of the objs (all of type scope; null entries
+// produce zeros) into out, at out_stride bytes apart (packed if 0).
+    intptr_t offset = 0; size_t size = 0;
+    if (!get_member_layout(scope, idata, false /* for_write */, offset, size))
+        return false;
+
+    if (!out_stride) out_stride = size;
+    char** cobjs = (char**)objs; char* cout = (char*)out;
+    switch (size) {
+    case 1: gather_fixed<1>(cobjs, nobjs, offset, cout, out_stride); break;
+    case 2: gather_fixed<2>(cobjs, nobjs, offset, cout, out_stride); break;
+    case 4: gather_fixed<4>(cobjs, nobjs, offset, cout, out_stride); break;
+    case 8: gather_fixed<8>(cobjs, nobjs, offset, cout, out_stride); break;
+    default:
+    // arrays and long double: one block copy per object
+        for (size_t i = 0; i < nobjs; ++i, cout += out_stride) {
+            if (cobjs[i]) memcpy(cout, cobjs[i]+offset, size);
+            else memset(cout, 0, size);
+        }
+    }
+    return true;
+}
+
+bool Cppyy::ScatterDatamember(TCppScope_t scope, TCppIndex_t idata,
+    TCppObject_t* objs, size_t nobjs, const void* in, size_t in_stride)
+{
+// Inverse of GatherDatamember: set data member idata of each of the objs from
+// in, read at in_stride bytes apart (packed if 0); null entries are skipped.
+    intptr_t offset = 0; size_t size = 0;
+    if (!get_member_layout(scope, idata, true /* for_write */, offset, size))
+        return false;
+
+    if (!in_stride) in_stride = size;
+    char** cobjs = (char**)objs; const char* cin = (const char*)in;
+    switch (size) {
+    case 1: scatter_fixed<1>(cobjs, nobjs, offset, cin, in_stride); break;
+    case 2: scatter_fixed<2>(cobjs, nobjs, offset, cin, in_stride); break;
+    case 4: scatter_fixed<4>(cobjs, nobjs, offset, cin, in_stride); break;
+    case 8: scatter_fixed<8>(cobjs, nobjs, offset, cin, in_stride); break;
+    default:
+        for (size_t i = 0; i < nobjs; ++i, cin += in_stride) {
+            if (cobjs[i]) memcpy(cobjs[i]+offset, cin, size);
+        }
+    }
+    return true;
+}
+
+
 // enum properties -----------------------------------------------------------
 Cppyy::TCppEnum_t Cppyy::GetEnum(TCppScope_t scope, const std::string& enum_name)
 {
@@ -2351,20 +2807,95 @@ Cppyy::TCppEnum_t Cppyy::GetEnum(TCppScope_t scope, const std::string& enum_name
 
 Cppyy::TCppIndex_t Cppyy::GetNumEnumData(TCppEnum_t etype)
 {
-    return (TCppIndex_t)((TEnum*)etype)->GetConstants()->GetSize();
+    return (TCppIndex_t)((TEnum*)etype)->GetConstantArray().size();
 }
 
 std::string Cppyy::GetEnumDataName(TCppEnum_t etype, TCppIndex_t idata)
 {
-    return ((TEnumConstant*)((TEnum*)etype)->GetConstants()->At((int)idata))->GetName();
+    return ((TEnum*)etype)->GetConstantAt((int)idata)->GetName();
 }
 
 long long Cppyy::GetEnumDataValue(TCppEnum_t etype, TCppIndex_t idata)
 {
-     TEnumConstant* ecst = (TEnumConstant*)((TEnum*)etype)->GetConstants()->At((int)idata);
-     return (long long)ecst->GetValue();
+     return (long long)((TEnum*)etype)->GetConstantAt((int)idata)->GetValue();
+}
+
+Cppyy::TCppIndex_t Cppyy::GetEnumData(TCppEnum_t etype, const char** names, long long* values)
+{
+    const auto& constants = ((TEnum*)etype)->GetConstantArray();
+    for (std::vector<const TEnumConstant*>::size_type i = 0; i < constants.size(); ++i) {
+        if (names)  names[i]  = constants[i]->GetName();
+        if (values) values[i] = (long long)constants[i]->GetValue();
+    }
+    return (TCppIndex_t)constants.size();
+}
+
+std::string Cppyy::GetEnumDataNameFromValue(TCppEnum_t etype, long long value)
+{
+    const TEnumConstant* ecst = ((TEnum*)etype)->GetConstantWithValue((Long64_t)value);
+    return ecst ? ecst->GetName() : "";
+}
+
+
+//- bulk conversion helpers --------------------------------------------------
+// Packed bits are LSB first, i.e. the layout of std::bitset (and of the words
+// of std::vector<bool>) on little-endian machines, which can then be copied
+// word-wise; elsewhere, the bits are moved one at a time.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CPPYY_BITS_ARE_BYTES 0
+#else
+#define CPPYY_BITS_ARE_BYTES 1
+#endif
+
+static inline void unpack_bits(const unsigned char* bits, size_t nbits, unsigned char* bytes)
+{
+    for (size_t i = 0; i < nbits; ++i)
+        bytes[i] = (bits[i >> 3] >> (i & 7)) & 1;
+}
+
+static inline void pack_bits(const unsigned char* bytes, size_t n, unsigned char* bits)
+{
+    const size_t nfull = n >> 3;
+    for (size_t ib = 0; ib < nfull; ++ib, bytes += 8) {
+        bits[ib] = (unsigned char)(
+            (bytes[0] != 0)        | ((bytes[1] != 0) << 1) | ((bytes[2] != 0) << 2) | ((bytes[3] != 0) << 3) |
+            ((bytes[4] != 0) << 4) | ((bytes[5] != 0) << 5) | ((bytes[6] != 0) << 6) | ((bytes[7] != 0) << 7));
+    }
+    if (n & 7) {
+        unsigned char last = 0;
+        for (size_t i = 0; i < (n & 7); ++i)
+            last |= (unsigned char)((bytes[i] != 0) << i);
+        bits[nfull] = last;
+    }
+}
+
+#if CPPYY_BITS_ARE_BYTES && defined(__GLIBCXX__)
+// libstdc++ exposes the word holding the first bit
+static inline unsigned char* vectorbool_storage(std::vector<bool>& v)
+{
+    return v.empty() ? nullptr : (unsigned char*)v.begin()._M_p;
+}
+#else
+static inline unsigned char* vectorbool_storage(std::vector<bool>&) { return nullptr; }
+#endif
+
+#if !CPPYY_BITS_ARE_BYTES
+// libstdc++ and libc++ both store a bitset in unsigned long words
+static inline bool bitset_test(const void* ptr, size_t i)
+{
+    const size_t wbits = 8*sizeof(unsigned long);
+    return (((const unsigned long*)ptr)[i / wbits] >> (i % wbits)) & 1;
 }
 
+static inline void bitset_assign(void* ptr, size_t i, bool value)
+{
+    const size_t wbits = 8*sizeof(unsigned long);
+    unsigned long& w = ((unsigned long*)ptr)[i / wbits];
+    const unsigned long mask = 1ul << (i % wbits);
+    w = value ? (w | mask) : (w & ~mask);
+}
+#endif
+
 
 //- C-linkage wrappers -------------------------------------------------------
 
@@ -2752,6 +3283,18 @@ char* cppyy_method_arg_default(cppyy_method_t method, int arg_index) {
     return cppstring_to_cstring(Cppyy::GetMethodArgDefault((Cppyy::TCppMethod_t)method, (Cppyy::TCppIndex_t)arg_index));
 }
 
+int cppyy_method_arg_default_value(
+        cppyy_method_t method, int arg_index, long long* ival, double* dval, char** sval, size_t* slen) {
+    Cppyy::TCppDefaultValue_t value =
+        Cppyy::GetMethodArgDefaultValue((Cppyy::TCppMethod_t)method, (Cppyy::TCppIndex_t)arg_index);
+    bool isstr = value.fKind == Cppyy::kStringDefault;
+    if (ival) *ival = value.fKind == Cppyy::kUIntDefault ? (long long)value.fUInt : value.fInt;
+    if (dval) *dval = value.fFloat;
+    if (sval) *sval = isstr ? cppstring_to_cstring(value.fString) : nullptr;
+    if (slen) *slen = isstr ? value.fString.size() : 0;
+    return (int)value.fKind;
+}
+
 char* cppyy_method_signature(cppyy_method_t method, int show_formalargs) {
     return cppstring_to_cstring(Cppyy::GetMethodSignature((Cppyy::TCppMethod_t)method, (bool)show_formalargs));
 }
@@ -2880,6 +3423,18 @@ int cppyy_get_dimension_size(cppyy_scope_t scope, cppyy_index_t idata, int dimen
 }
 
 
+/* bulk data member access ------------------------------------------------ */
+int cppyy_gather_datamember(cppyy_scope_t scope, cppyy_index_t idata,
+    cppyy_object_t* objs, size_t nobjs, void* out, size_t out_stride) {
+    return (int)Cppyy::GatherDatamember(scope, idata, objs, nobjs, out, out_stride);
+}
+
+int cppyy_scatter_datamember(cppyy_scope_t scope, cppyy_index_t idata,
+    cppyy_object_t* objs, size_t nobjs, const void* in, size_t in_stride) {
+    return (int)Cppyy::ScatterDatamember(scope, idata, objs, nobjs, in, in_stride);
+}
+
+
 /* enum properties -------------------------------------------------------- */
 cppyy_enum_t cppyy_get_enum(cppyy_scope_t scope, const char* enum_name) {
     return Cppyy::GetEnum(scope, enum_name);
@@ -2897,6 +3452,15 @@ long long cppyy_get_enum_data_value(cppyy_enum_t e, cppyy_index_t idata) {
     return Cppyy::GetEnumDataValue(e, idata);
 }
 
+cppyy_index_t cppyy_get_enum_data(cppyy_enum_t e, const char** names, long long* values) {
+    return Cppyy::GetEnumData(e, names, values);
+}
+
+char* cppyy_get_enum_data_name_from_value(cppyy_enum_t e, long long value) {
+    std::string name = Cppyy::GetEnumDataNameFromValue(e, value);
+    return name.empty() ? nullptr : cppstring_to_cstring(name);
+}
+
 
 /* misc helpers ----------------------------------------------------------- */
 RPY_EXTERN
@@ -2905,6 +3469,13 @@ void* cppyy_load_dictionary(const char* lib_name) {
     return (void*)(result == 0 /* success */ || result == 1 /* already loaded */);
 }
 
+RPY_EXTERN
+void* cppyy_load_dictionaries(const char* lib_names) {
+// blank separated list; dependencies are loaded first and files are prefetched in parallel
+    int result = gSystem->LoadMany(lib_names);
+    return (void*)(result == 0 /* success, or all already loaded */);
+}
+
 #if defined(_MSC_VER)
 long long cppyy_strtoll(const char* str) {
     return _strtoi64(str, NULL, 0);
@@ -2960,4 +3531,123 @@ void cppyy_vectorbool_setitem(cppyy_object_t ptr, int idx, int value) {
     (*(std::vector<bool>*)ptr)[idx] = (bool)value;
 }
 
+void cppyy_vectorbool_tobits(cppyy_object_t ptr, unsigned char* bits) {
+    std::vector<bool>& v = *(std::vector<bool>*)ptr;
+    const size_t n = v.size();
+    if (const unsigned char* storage = vectorbool_storage(v)) {
+        memcpy(bits, storage, (n+7)/8);
+        if (n & 7) bits[n >> 3] &= (unsigned char)((1u << (n & 7)) - 1);
+        return;
+    }
+    memset(bits, 0, (n+7)/8);
+    size_t i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i)
+        if (*it) bits[i >> 3] |= (unsigned char)(1u << (i & 7));
+}
+
+void cppyy_vectorbool_frombits(cppyy_object_t ptr, const unsigned char* bits, size_t nbits) {
+    std::vector<bool>& v = *(std::vector<bool>*)ptr;
+    v.assign(nbits, false);
+    if (unsigned char* storage = vectorbool_storage(v)) {
+        memcpy(storage, bits, nbits/8);
+        if (nbits & 7) {
+            const unsigned char mask = (unsigned char)((1u << (nbits & 7)) - 1);
+            storage[nbits >> 3] = (unsigned char)((storage[nbits >> 3] & ~mask) | (bits[nbits >> 3] & mask));
+        }
+        return;
+    }
+    size_t i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i)
+        *it = (bits[i >> 3] >> (i & 7)) & 1;
+}
+
+void cppyy_vectorbool_tobytes(cppyy_object_t ptr, unsigned char* bytes) {
+    std::vector<bool>& v = *(std::vector<bool>*)ptr;
+    if (const unsigned char* storage = vectorbool_storage(v)) {
+        unpack_bits(storage, v.size(), bytes);
+        return;
+    }
+    for (auto it = v.begin(); it != v.end(); ++it)
+        *bytes++ = (unsigned char)*it;
+}
+
+void cppyy_vectorbool_frombytes(cppyy_object_t ptr, const unsigned char* bytes, size_t n) {
+    std::vector<bool>& v = *(std::vector<bool>*)ptr;
+    v.assign(n, false);
+    if (unsigned char* storage = vectorbool_storage(v)) {
+    // the tail of the last word is zero after assign(), so it can be overwritten
+        pack_bits(bytes, n, storage);
+        return;
+    }
+    for (auto it = v.begin(); it != v.end(); ++it)
+        *it = *bytes++ != 0;
+}
+
+void cppyy_bitset_tobits(cppyy_object_t ptr, size_t nbits, unsigned char* bits) {
+#if CPPYY_BITS_ARE_BYTES
+    memcpy(bits, ptr, (nbits+7)/8);
+#else
+    memset(bits, 0, (nbits+7)/8);
+    for (size_t i = 0; i < nbits; ++i)
+        if (bitset_test(ptr, i)) bits[i >> 3] |= (unsigned char)(1u << (i & 7));
+#endif
+}
+
+void cppyy_bitset_frombits(cppyy_object_t ptr, size_t nbits, const unsigned char* bits) {
+#if CPPYY_BITS_ARE_BYTES
+    memcpy(ptr, bits, (nbits+7)/8);
+// std::bitset requires the unused bits of its last word to be zero
+    if (nbits & 7) ((unsigned char*)ptr)[nbits >> 3] &= (unsigned char)((1u << (nbits & 7)) - 1);
+#else
+    for (size_t i = 0; i < nbits; ++i)
+        bitset_assign(ptr, i, (bits[i >> 3] >> (i & 7)) & 1);
+#endif
+}
+
+void cppyy_bitset_tobytes(cppyy_object_t ptr, size_t nbits, unsigned char* bytes) {
+#if CPPYY_BITS_ARE_BYTES
+    unpack_bits((const unsigned char*)ptr, nbits, bytes);
+#else
+    for (size_t i = 0; i < nbits; ++i)
+        bytes[i] = (unsigned char)bitset_test(ptr, i);
+#endif
+}
+
+void cppyy_bitset_frombytes(cppyy_object_t ptr, size_t nbits, const unsigned char* bytes) {
+#if CPPYY_BITS_ARE_BYTES
+// pack_bits() zeroes the tail of the last byte; later bytes of the last word are
+// beyond nbits and hence already zero
+    pack_bits(bytes, nbits, (unsigned char*)ptr);
+#else
+    for (size_t i = 0; i < nbits; ++i)
+        bitset_assign(ptr, i, bytes[i] != 0);
+#endif
+}
+
+size_t cppyy_vectorstring_nbytes(cppyy_object_t ptr) {
+    size_t nbytes = 0;
+    for (const auto& str : *(std::vector<std::string>*)ptr)
+        nbytes += str.size();
+    return nbytes;
+}
+
+void cppyy_vectorstring_tobuffer(cppyy_object_t ptr, char* data, size_t* offsets) {
+// data must hold cppyy_vectorstring_nbytes() chars, offsets size()+1 entries
+    size_t pos = 0;
+    *offsets++ = 0;
+    for (const auto& str : *(std::vector<std::string>*)ptr) {
+        memcpy(data + pos, str.data(), str.size());
+        pos += str.size();
+        *offsets++ = pos;
+    }
+}
+
+void cppyy_vectorstring_frombuffer(cppyy_object_t ptr, const char* data, const size_t* offsets, size_t n) {
+    std::vector<std::string>& v = *(std::vector<std::string>*)ptr;
+    v.clear();
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        v.emplace_back(data + offsets[i], offsets[i+1] - offsets[i]);
+}
+
 } // end C-linkage wrappers
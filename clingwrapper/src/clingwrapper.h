@@ -10,6 +10,9 @@ extern "C" {
     /* misc helpers */
     RPY_EXPORTED
     void* cppyy_load_dictionary(const char* lib_name);
+    /* blank-separated list of libraries, loaded in dependency order */
+    RPY_EXPORTED
+    void* cppyy_load_dictionaries(const char* lib_names);
 
 #ifdef __cplusplus
 }
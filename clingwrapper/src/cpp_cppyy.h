@@ -40,6 +40,26 @@ namespace Cppyy {
     typedef size_t      TCppIndex_t;
     typedef void*       TCppFuncAddr_t;
 
+// default argument value, folded to a constant where possible; a kind of
+// kRuntimeDefault means that the text from GetMethodArgDefault() is needed
+    enum EDefaultKind {
+        kNoDefault      = 0,
+        kRuntimeDefault = 1,
+        kIntDefault     = 2,    // fInt
+        kUIntDefault    = 3,    // fUInt
+        kFloatDefault   = 4,    // fFloat
+        kNullPtrDefault = 5,
+        kStringDefault  = 6     // fString, which may hold embedded NULs
+    };
+
+    struct TCppDefaultValue_t {
+        EDefaultKind       fKind  = kNoDefault;
+        long long          fInt   = 0;
+        unsigned long long fUInt  = 0;
+        double             fFloat = 0.;
+        std::string        fString;
+    };
+
 // direct interpreter access -------------------------------------------------
     RPY_EXPORTED
     bool Compile(const std::string& code, bool silent = false);
@@ -203,6 +223,8 @@ namespace Cppyy {
     RPY_EXPORTED
     std::string GetMethodArgDefault(TCppMethod_t, TCppIndex_t iarg);
     RPY_EXPORTED
+    TCppDefaultValue_t GetMethodArgDefaultValue(TCppMethod_t, TCppIndex_t iarg);
+    RPY_EXPORTED
     std::string GetMethodSignature(TCppMethod_t, bool show_formalargs, TCppIndex_t maxargs = (TCppIndex_t)-1);
     RPY_EXPORTED
     std::string GetMethodPrototype(TCppScope_t scope, TCppMethod_t, bool show_formalargs);
@@ -267,6 +289,14 @@ namespace Cppyy {
     RPY_EXPORTED
     int  GetDimensionSize(TCppScope_t scope, TCppIndex_t idata, int dimension);
 
+// bulk data member access ---------------------------------------------------
+    RPY_EXPORTED
+    bool GatherDatamember(TCppScope_t scope, TCppIndex_t idata,
+        TCppObject_t* objs, size_t nobjs, void* out, size_t out_stride = 0);
+    RPY_EXPORTED
+    bool ScatterDatamember(TCppScope_t scope, TCppIndex_t idata,
+        TCppObject_t* objs, size_t nobjs, const void* in, size_t in_stride = 0);
+
 // enum properties -----------------------------------------------------------
     RPY_EXPORTED
     TCppEnum_t  GetEnum(TCppScope_t scope, const std::string& enum_name);
@@ -276,6 +306,13 @@ namespace Cppyy {
     std::string GetEnumDataName(TCppEnum_t, TCppIndex_t idata);
     RPY_EXPORTED
     long long   GetEnumDataValue(TCppEnum_t, TCppIndex_t idata);
+    // fill names and values (each of GetNumEnumData() entries) in one call; the
+    // names are owned by the enum and remain valid for as long as it is loaded
+    RPY_EXPORTED
+    TCppIndex_t GetEnumData(TCppEnum_t, const char** names, long long* values);
+    // name of the first declared constant with the given value, "" if none
+    RPY_EXPORTED
+    std::string GetEnumDataNameFromValue(TCppEnum_t, long long value);
 
 } // namespace Cppyy
 